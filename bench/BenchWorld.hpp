@@ -0,0 +1,181 @@
+#ifndef BENCH_WORLD_HPP
+#define BENCH_WORLD_HPP
+
+#include <btBulletDynamicsCommon.h>
+#include <memory>
+#include <random>
+#include <vector>
+#include "lib.hpp"
+#include "CollisionLayers.hpp"
+
+/**
+ * @class BenchWorld
+ * @brief Fills a physics world with the same bodies as a game level
+ *
+ * Ground planes, boundary walls and trees follow the layout of PlaneZ and
+ * Object, zombies use the capsule of Zombies::createZombies, all with the
+ * game's collision layers. Everything is physics-only, so benchmarks do not
+ * need a render window. The generator is seeded so every run sees the same
+ * distribution.
+ */
+class BenchWorld {
+public:
+    explicit BenchWorld(btDiscreteDynamicsWorld* world, unsigned seed = 42)
+        : world(world), random(seed) {}
+
+    ~BenchWorld() {
+        for (btRigidBody* body : bodies) {
+            world->removeRigidBody(body);
+            delete body->getMotionState();
+            delete body;
+        }
+    }
+
+    BenchWorld(const BenchWorld&) = delete;
+    BenchWorld& operator=(const BenchWorld&) = delete;
+
+    /**
+     * @brief Adds the ground planes, walls and trees of a level
+     */
+    void addStaticScenery() {
+        // Ground planes (PlaneZ)
+        for (int x = 0; x < PLANE_X; ++x) {
+            for (int z = 0; z < PLANE_Z; ++z) {
+                float posX = (x - PLANE_X / 2) * PLANE_SIZE;
+                float posZ = (z - PLANE_Z / 2) * PLANE_SIZE;
+                addBody(0.0f, planeShape(), btVector3(posX, 0, posZ), CollisionLayer::Ground);
+            }
+        }
+
+        // Boundary walls (Object::createBoundaryWalls)
+        const float halfWidth = (PLANE_WIDTH / 2.0f) - 200.0f;
+        const float halfHeight = (PLANE_HEIGHT / 2.0f) - 200.0f;
+        const float wallHeight = 200.0f;
+        addBody(0.0f, boxShape(btVector3(halfWidth, wallHeight, 5.0f)), btVector3(0, wallHeight, halfHeight), CollisionLayer::Static);
+        addBody(0.0f, boxShape(btVector3(halfWidth, wallHeight, 5.0f)), btVector3(0, wallHeight, -halfHeight), CollisionLayer::Static);
+        addBody(0.0f, boxShape(btVector3(5.0f, wallHeight, halfHeight)), btVector3(halfWidth, wallHeight, 0), CollisionLayer::Static);
+        addBody(0.0f, boxShape(btVector3(5.0f, wallHeight, halfHeight)), btVector3(-halfWidth, wallHeight, 0), CollisionLayer::Static);
+
+        // Boundary and random trees (Object::createBoundaryTrees, createRandomTrees)
+        const float treeSpacing = 80.0f;
+        for (float x = -halfWidth + treeSpacing; x < halfWidth; x += treeSpacing) {
+            addTree(x, halfHeight);
+            addTree(x, -halfHeight);
+        }
+        for (float z = -halfHeight + treeSpacing; z < halfHeight; z += treeSpacing) {
+            addTree(halfWidth, z);
+            addTree(-halfWidth, z);
+        }
+        std::uniform_real_distribution<float> spreadX(-PLANE_WIDTH / 2, PLANE_WIDTH / 2);
+        std::uniform_real_distribution<float> spreadZ(-PLANE_HEIGHT / 2, PLANE_HEIGHT / 2);
+        for (int i = 0; i < TREE_NUMBER; ++i) {
+            addTree(spreadX(random), spreadZ(random));
+        }
+    }
+
+    /**
+     * @brief Adds zombies spread around the origin, like Zombies::createZombies
+     * @param count Number of zombies
+     * @param radius Spawn radius
+     */
+    void addZombies(int count, float radius) {
+        std::uniform_real_distribution<float> spread(-radius, radius);
+        for (int i = 0; i < count; ++i) {
+            btRigidBody* body = addBody(50.0f, capsuleShape(), btVector3(spread(random), 1.0f, spread(random)),
+                                       CollisionLayer::Zombie);
+            body->setAngularFactor(btVector3(0, 1, 0));
+            zombies.push_back(body);
+        }
+    }
+
+    /**
+     * @brief Steers every zombie toward a target, as Zombies::updateZombies does
+     * @param target Point the zombies walk to
+     */
+    void steerZombies(const btVector3& target) {
+        for (btRigidBody* body : zombies) {
+            btVector3 direction = target - body->getWorldTransform().getOrigin();
+            direction.setY(0);
+            if (direction.length2() > 1.0f) {
+                btVector3 velocity = direction.normalized() * ZOMBIE_SPEED;
+                body->setLinearVelocity(btVector3(velocity.x(), 0, velocity.z()));
+                body->activate();
+            }
+        }
+    }
+
+    /**
+     * @brief Moves every zombie toward a target without solving contacts
+     *
+     * Used to drive the broadphase alone: only the transforms change.
+     * @param target Point the zombies walk to
+     * @param deltaTime Elapsed time, in seconds
+     */
+    void moveZombies(const btVector3& target, float deltaTime) {
+        for (btRigidBody* body : zombies) {
+            btTransform transform = body->getWorldTransform();
+            btVector3 direction = target - transform.getOrigin();
+            direction.setY(0);
+            if (direction.length2() > 1.0f) {
+                transform.setOrigin(transform.getOrigin() + direction.normalized() * ZOMBIE_SPEED * deltaTime);
+                body->setWorldTransform(transform);
+            }
+        }
+    }
+
+    const std::vector<btRigidBody*>& getZombies() const { return zombies; }
+
+private:
+    btDiscreteDynamicsWorld* world;
+    std::mt19937 random;
+    std::vector<btRigidBody*> bodies;
+    std::vector<btRigidBody*> zombies;
+    std::vector<std::unique_ptr<btCollisionShape>> shapes;
+    btCollisionShape* treeShape = nullptr;
+    btCollisionShape* zombieShape = nullptr;
+
+    btCollisionShape* planeShape() {
+        shapes.emplace_back(new btStaticPlaneShape(btVector3(0, 1, 0), 0));
+        return shapes.back().get();
+    }
+
+    btCollisionShape* boxShape(const btVector3& halfExtents) {
+        shapes.emplace_back(new btBoxShape(halfExtents));
+        return shapes.back().get();
+    }
+
+    btCollisionShape* capsuleShape() {
+        if (!zombieShape) {
+            shapes.emplace_back(new btCapsuleShape(10.0f, 70.0f));
+            zombieShape = shapes.back().get();
+        }
+        return zombieShape;
+    }
+
+    void addTree(float x, float z) {
+        if (!treeShape) {
+            shapes.emplace_back(new btBoxShape(btVector3(20.0f, 70.0f, 20.0f)));
+            treeShape = shapes.back().get();
+        }
+        addBody(0.0f, treeShape, btVector3(x, 0, z), CollisionLayer::Static);
+    }
+
+    btRigidBody* addBody(btScalar mass, btCollisionShape* shape, const btVector3& origin, CollisionLayer layer) {
+        btTransform transform;
+        transform.setIdentity();
+        transform.setOrigin(origin);
+
+        btVector3 localInertia(0, 0, 0);
+        if (mass > 0.0f) {
+            shape->calculateLocalInertia(mass, localInertia);
+        }
+        btDefaultMotionState* motionState = new btDefaultMotionState(transform);
+        btRigidBody::btRigidBodyConstructionInfo rbInfo(mass, motionState, shape, localInertia);
+        btRigidBody* body = new btRigidBody(rbInfo);
+        CollisionLayers::addRigidBody(world, body, layer);
+        bodies.push_back(body);
+        return body;
+    }
+};
+
+#endif // BENCH_WORLD_HPP
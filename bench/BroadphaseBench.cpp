@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+#include "PhysicsManager.hpp"
+#include "BenchWorld.hpp"
+
+namespace {
+    const float ZOMBIE_SPAWN_RADIUS = 2000.0f;
+
+    const char* broadphaseName(BroadphaseType type) {
+        switch (type) {
+        case BroadphaseType::AxisSweep: return "sap";
+        case BroadphaseType::Grid: return "grid";
+        case BroadphaseType::DynamicAabbTree:
+        default: return "dbvt";
+        }
+    }
+
+    /**
+     * @brief Broadphase update alone: AABB refresh and pair search
+     *
+     * Zombies walk toward the player between iterations while the level's
+     * trees, walls and ground planes stay put.
+     * Arguments: broadphase type, zombie count.
+     */
+    void BM_Broadphase(benchmark::State& state) {
+        PhysicsSettings settings;
+        settings.broadphase = static_cast<BroadphaseType>(state.range(0));
+
+        PhysicsManager physics;
+        physics.initialize(settings);
+        btDiscreteDynamicsWorld* world = physics.getDynamicsWorld();
+
+        BenchWorld level(world);
+        level.addStaticScenery();
+        level.addZombies(static_cast<int>(state.range(1)), ZOMBIE_SPAWN_RADIUS);
+        world->updateAabbs();
+        world->computeOverlappingPairs();
+
+        for (auto _ : state) {
+            level.moveZombies(btVector3(0, 0, 0), PHYSICS_FIXED_TIMESTEP);
+            world->updateAabbs();
+            world->computeOverlappingPairs();
+        }
+
+        state.SetLabel(broadphaseName(settings.broadphase));
+        state.counters["pairs"] = world->getBroadphase()->getOverlappingPairCache()->getNumOverlappingPairs();
+        state.SetItemsProcessed(state.iterations() * state.range(1));
+    }
+
+    /**
+     * @brief Full fixed tick with each broadphase, to see its share of the step
+     * Arguments: broadphase type, zombie count.
+     */
+    void BM_BroadphaseStep(benchmark::State& state) {
+        PhysicsSettings settings;
+        settings.broadphase = static_cast<BroadphaseType>(state.range(0));
+
+        PhysicsManager physics;
+        physics.initialize(settings);
+        btDiscreteDynamicsWorld* world = physics.getDynamicsWorld();
+
+        BenchWorld level(world);
+        level.addStaticScenery();
+        level.addZombies(static_cast<int>(state.range(1)), ZOMBIE_SPAWN_RADIUS);
+
+        for (auto _ : state) {
+            level.steerZombies(btVector3(0, 0, 0));
+            world->stepSimulation(PHYSICS_FIXED_TIMESTEP, 0);
+        }
+
+        state.SetLabel(broadphaseName(settings.broadphase));
+        state.SetItemsProcessed(state.iterations() * state.range(1));
+    }
+
+    const std::vector<int64_t> BROADPHASES = {
+        static_cast<int64_t>(BroadphaseType::DynamicAabbTree),
+        static_cast<int64_t>(BroadphaseType::AxisSweep),
+        static_cast<int64_t>(BroadphaseType::Grid)
+    };
+}
+
+BENCHMARK(BM_Broadphase)
+    ->ArgNames({"broadphase", "zombies"})
+    ->ArgsProduct({BROADPHASES, {100, 1000, 5000}})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_BroadphaseStep)
+    ->ArgNames({"broadphase", "zombies"})
+    ->ArgsProduct({BROADPHASES, {100, 1000, 5000}})
+    ->Unit(benchmark::kMillisecond);
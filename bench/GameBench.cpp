@@ -0,0 +1,329 @@
+#include <benchmark/benchmark.h>
+#include "HeadlessOgre.hpp"
+#include "PhysicsManager.hpp"
+#include "GameRandom.hpp"
+#include "Object.hpp"
+#include "Zombies.hpp"
+#include "Player.hpp"
+#include "Minimap.hpp"
+#include "FrameArena.hpp"
+#include "JobSystem.hpp"
+#include "EntityStore.hpp"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace {
+    const float ZOMBIE_SPAWN_RADIUS = 2000.0f;
+
+    /**
+     * @brief Ogre instance shared by every benchmark (Root is a singleton)
+     * @return Null if Ogre could not start without a display
+     */
+    HeadlessOgre* benchOgre() {
+        static HeadlessOgre* ogre = [] {
+            HeadlessOgre* instance = new HeadlessOgre();
+            if (!instance->initialize("ForestZ_bench.log")) {
+                delete instance;
+                return static_cast<HeadlessOgre*>(nullptr);
+            }
+            return instance;
+        }();
+        return ogre;
+    }
+
+    /**
+     * @brief Reports throughput and time per entity, tracked between releases
+     */
+    void setEntityCounters(benchmark::State& state, int64_t entities) {
+        state.SetItemsProcessed(state.iterations() * entities);
+        state.counters["entities"] = static_cast<double>(entities);
+        state.counters["time_per_entity"] = benchmark::Counter(
+            static_cast<double>(entities),
+            benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    }
+
+    /**
+     * @brief Object::updateObjectLODs with the camera walking across the forest
+     *
+     * Argument: tree count.
+     */
+    void BM_ObjectLODs(benchmark::State& state) {
+        HeadlessOgre* ogre = benchOgre();
+        if (!ogre) {
+            state.SkipWithError("Ogre could not start headless");
+            return;
+        }
+        SceneManager* scnMgr = ogre->getSceneManager();
+        GameRandom::seed(1);
+
+        PhysicsManager physics;
+        physics.initialize();
+        {
+            Object object;
+            object.createRandomTrees(scnMgr, physics.getDynamicsWorld(), static_cast<int>(state.range(0)));
+            SceneNode* camNode = scnMgr->getRootSceneNode()->createChildSceneNode();
+
+            // Walking speed: trees cross the LOD threshold as in the game
+            float x = -PLANE_WIDTH / 2;
+            for (auto _ : state) {
+                x += PLAYER_SPEED * PHYSICS_FIXED_TIMESTEP;
+                if (x > PLANE_WIDTH / 2) x = -PLANE_WIDTH / 2;
+                camNode->setPosition(x, 50, 0);
+                object.updateObjectLODs(camNode, scnMgr);
+                FrameArena::get().reset();
+            }
+
+            physics.removeAllCollisionObjects();
+        }
+        ogre->clearScene();
+
+        setEntityCounters(state, state.range(0));
+    }
+
+    /**
+     * @brief Zombies::updateZombies: steering and animation of every zombie
+     *
+     * Argument: zombie count.
+     */
+    void BM_ZombiesUpdate(benchmark::State& state) {
+        HeadlessOgre* ogre = benchOgre();
+        if (!ogre) {
+            state.SkipWithError("Ogre could not start headless");
+            return;
+        }
+        SceneManager* scnMgr = ogre->getSceneManager();
+        GameRandom::seed(1);
+
+        PhysicsManager physics;
+        physics.initialize();
+        {
+            Zombies zombies;
+            zombies.createZombies(scnMgr, static_cast<int>(state.range(0)), ZOMBIE_SPAWN_RADIUS,
+                                  physics.getDynamicsWorld());
+            SceneNode* playerNode = scnMgr->getRootSceneNode()->createChildSceneNode();
+
+            for (auto _ : state) {
+                zombies.updateZombies(playerNode, PHYSICS_FIXED_TIMESTEP);
+            }
+
+            physics.removeAllCollisionObjects();
+        }
+        ogre->clearScene();
+
+        setEntityCounters(state, state.range(0));
+    }
+
+    /**
+     * @brief Minimap::update: static layer scrolling and broadphase query of the zombies in view
+     *
+     * Arguments: zombie count, tree count (rasterized once, should not matter).
+     */
+    void BM_MinimapUpdate(benchmark::State& state) {
+        HeadlessOgre* ogre = benchOgre();
+        if (!ogre) {
+            state.SkipWithError("Ogre could not start headless");
+            return;
+        }
+        SceneManager* scnMgr = ogre->getSceneManager();
+        GameRandom::seed(1);
+
+        PhysicsManager physics;
+        physics.initialize();
+        {
+            EntityStore store;
+            Object object(&store);
+            object.createRandomTrees(scnMgr, physics.getDynamicsWorld(), static_cast<int>(state.range(1)));
+            Zombies zombies(&store);
+            zombies.createZombies(scnMgr, static_cast<int>(state.range(0)), ZOMBIE_SPAWN_RADIUS,
+                                  physics.getDynamicsWorld());
+
+            Minimap minimap;
+            minimap.initialize(scnMgr);
+            minimap.buildStaticLayer(store);
+
+            Vector3 playerPos = Vector3::ZERO;
+            for (auto _ : state) {
+                playerPos.x += PLAYER_SPEED * PHYSICS_FIXED_TIMESTEP;
+                if (playerPos.x > ZOMBIE_SPAWN_RADIUS) playerPos.x = -ZOMBIE_SPAWN_RADIUS;
+                minimap.update(playerPos, physics.getDynamicsWorld());
+            }
+
+            physics.removeAllCollisionObjects();
+        }
+        ogre->clearScene();
+
+        setEntityCounters(state, state.range(0) + state.range(1));
+    }
+
+    /**
+     * @brief Player::updateBulletPositions under sustained fire
+     *
+     * Each iteration is one tick: shots are fired so that N bullets stay in
+     * flight, the world is stepped, then out-of-range bullets are removed.
+     * Argument: bullets in flight.
+     */
+    void BM_BulletUpdate(benchmark::State& state) {
+        HeadlessOgre* ogre = benchOgre();
+        if (!ogre) {
+            state.SkipWithError("Ogre could not start headless");
+            return;
+        }
+        SceneManager* scnMgr = ogre->getSceneManager();
+
+        PhysicsManager physics;
+        physics.initialize();
+        btDiscreteDynamicsWorld* world = physics.getDynamicsWorld();
+        {
+            Player player;
+            player.createPlayer(scnMgr, Vector3::ZERO, world);
+            if (!player.playerNode) {
+                state.SkipWithError("Player could not be created");
+                physics.removeAllCollisionObjects();
+                return;
+            }
+
+            // A bullet lives BULLET_MAX_DISTANCE / BULLET_SPEED seconds
+            const float ticksInFlight = BULLET_MAX_DISTANCE / BULLET_SPEED / PHYSICS_FIXED_TIMESTEP;
+            const float shotsPerTick = static_cast<float>(state.range(0)) / ticksInFlight;
+            float shotBudget = 0.0f;
+            float angle = 0.0f;
+
+            for (auto _ : state) {
+                for (shotBudget += shotsPerTick; shotBudget >= 1.0f; shotBudget -= 1.0f) {
+                    angle += 0.1f;
+                    player.shoot(scnMgr, world, Vector3(std::cos(angle), 0, std::sin(angle)));
+                }
+                world->stepSimulation(PHYSICS_FIXED_TIMESTEP, 0);
+                player.updateBulletPositions(world);
+            }
+
+            state.counters["in_flight"] = static_cast<double>(player.getBullets().size());
+            while (!player.getBullets().empty()) {
+                player.removeBullet(0, world);
+            }
+            physics.removeAllCollisionObjects();
+        }
+        ogre->clearScene();
+
+        setEntityCounters(state, state.range(0));
+    }
+
+    /**
+     * @brief Zombies::steerZombies shared out by the job system
+     *
+     * Arguments: zombie count, threads (the calling thread included).
+     */
+    void BM_ZombiesSteerJobs(benchmark::State& state) {
+        HeadlessOgre* ogre = benchOgre();
+        if (!ogre) {
+            state.SkipWithError("Ogre could not start headless");
+            return;
+        }
+        SceneManager* scnMgr = ogre->getSceneManager();
+        GameRandom::seed(1);
+
+        JobSystem jobs(static_cast<unsigned int>(state.range(1)));
+        PhysicsManager physics;
+        physics.initialize();
+        {
+            Zombies zombies;
+            zombies.createZombies(scnMgr, static_cast<int>(state.range(0)), ZOMBIE_SPAWN_RADIUS,
+                                  physics.getDynamicsWorld());
+
+            float angle = 0.0f;
+            for (auto _ : state) {
+                angle += 0.01f;
+                zombies.steerZombies(Vector3(std::cos(angle) * 500.0f, 0, std::sin(angle) * 500.0f), &jobs);
+            }
+
+            physics.removeAllCollisionObjects();
+        }
+        ogre->clearScene();
+
+        setEntityCounters(state, state.range(0));
+        state.counters["threads"] = static_cast<double>(jobs.getThreadCount());
+    }
+
+    /**
+     * @brief Object::updateObjectLODs with the distance tests shared out by the job system
+     *
+     * Arguments: tree count, threads (the calling thread included).
+     */
+    void BM_ObjectLODJobs(benchmark::State& state) {
+        HeadlessOgre* ogre = benchOgre();
+        if (!ogre) {
+            state.SkipWithError("Ogre could not start headless");
+            return;
+        }
+        SceneManager* scnMgr = ogre->getSceneManager();
+        GameRandom::seed(1);
+
+        JobSystem jobs(static_cast<unsigned int>(state.range(1)));
+        PhysicsManager physics;
+        physics.initialize();
+        {
+            Object object;
+            object.createRandomTrees(scnMgr, physics.getDynamicsWorld(), static_cast<int>(state.range(0)));
+            SceneNode* camNode = scnMgr->getRootSceneNode()->createChildSceneNode();
+
+            float x = -PLANE_WIDTH / 2;
+            for (auto _ : state) {
+                x += PLAYER_SPEED * PHYSICS_FIXED_TIMESTEP;
+                if (x > PLANE_WIDTH / 2) x = -PLANE_WIDTH / 2;
+                camNode->setPosition(x, 50, 0);
+                object.updateObjectLODs(camNode, scnMgr, &jobs);
+                FrameArena::get().reset();
+            }
+
+            physics.removeAllCollisionObjects();
+        }
+        ogre->clearScene();
+
+        setEntityCounters(state, state.range(0));
+        state.counters["threads"] = static_cast<double>(jobs.getThreadCount());
+    }
+
+    /**
+     * @brief Thread counts 1, 2, 4... up to the machine's cores
+     */
+    void threadScaling(benchmark::internal::Benchmark* benchmark, int64_t entities) {
+        const int64_t cores = std::max(1u, std::thread::hardware_concurrency());
+        for (int64_t threads = 1; threads < cores; threads *= 2) {
+            benchmark->Args({entities, threads});
+        }
+        benchmark->Args({entities, cores});
+    }
+}
+
+BENCHMARK(BM_ObjectLODs)
+    ->ArgName("trees")
+    ->RangeMultiplier(4)->Range(100, 6400)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_ZombiesUpdate)
+    ->ArgName("zombies")
+    ->RangeMultiplier(10)->Range(10, 10000)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_MinimapUpdate)
+    ->ArgNames({"zombies", "trees"})
+    ->ArgsProduct({{10, 100, 1000}, {TREE_NUMBER, 16 * TREE_NUMBER}})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_BulletUpdate)
+    ->ArgName("bullets")
+    ->RangeMultiplier(10)->Range(10, 1000)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_ZombiesSteerJobs)
+    ->ArgNames({"zombies", "threads"})
+    ->Apply([](benchmark::internal::Benchmark* b) { threadScaling(b, 10000); })
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_ObjectLODJobs)
+    ->ArgNames({"trees", "threads"})
+    ->Apply([](benchmark::internal::Benchmark* b) { threadScaling(b, 6400); })
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,46 @@
+#include <benchmark/benchmark.h>
+#include "PhysicsManager.hpp"
+#include "BenchWorld.hpp"
+
+namespace {
+    // Zombies spawn in the same radius as in a level
+    const float ZOMBIE_SPAWN_RADIUS = 2000.0f;
+
+    /**
+     * @brief One fixed physics tick with a full level and N zombies chasing the player
+     *
+     * Arguments: zombie count, physics threads (0 = one per hardware thread).
+     */
+    void BM_PhysicsStep(benchmark::State& state) {
+        PhysicsSettings settings;
+        settings.threadCount = static_cast<int>(state.range(1));
+
+        PhysicsManager physics;
+        physics.initialize(settings);
+        btDiscreteDynamicsWorld* world = physics.getDynamicsWorld();
+
+        BenchWorld level(world);
+        level.addStaticScenery();
+        level.addZombies(static_cast<int>(state.range(0)), ZOMBIE_SPAWN_RADIUS);
+
+        // Let the zombies settle on the ground before measuring
+        for (int i = 0; i < 30; ++i) {
+            level.steerZombies(btVector3(0, 0, 0));
+            world->stepSimulation(PHYSICS_FIXED_TIMESTEP, 0);
+        }
+
+        for (auto _ : state) {
+            level.steerZombies(btVector3(0, 0, 0));
+            world->stepSimulation(PHYSICS_FIXED_TIMESTEP, 0);
+        }
+
+        state.counters["threads"] = physics.getThreadCount();
+        state.counters["zombies"] = static_cast<double>(state.range(0));
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK(BM_PhysicsStep)
+    ->ArgNames({"zombies", "threads"})
+    ->ArgsProduct({{100, 1000, 5000}, {1, 0}})
+    ->Unit(benchmark::kMillisecond);
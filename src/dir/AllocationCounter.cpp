@@ -0,0 +1,124 @@
+#include "../include/AllocationCounter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <LinearMath/btAlignedAllocator.h>
+
+namespace {
+    // Keeps the block returned to the caller aligned like malloc's
+    struct alignas(16) BlockHeader {
+        uint64_t size;
+        MemoryTag tag;
+    };
+    static_assert(sizeof(BlockHeader) == 16, "BlockHeader must preserve malloc alignment");
+
+    struct TagCounters {
+        std::atomic<int64_t> liveBytes{0};
+        std::atomic<int64_t> liveCount{0};
+        std::atomic<uint64_t> totalCount{0};
+    };
+
+    std::atomic<uint64_t> totalCount{0};
+    std::atomic<uint64_t> totalBytes{0};
+    TagCounters tagCounters[static_cast<int>(MemoryTag::Count)];
+
+    void* allocateBullet(size_t size) {
+        return AllocationCounter::allocate(size, MemoryTag::Physics);
+    }
+
+    void freeBullet(void* pointer) {
+        AllocationCounter::deallocate(pointer);
+    }
+}
+
+AllocationTotals AllocationCounter::getTotals()
+{
+    return {totalCount.load(std::memory_order_relaxed), totalBytes.load(std::memory_order_relaxed)};
+}
+
+MemoryTagStats AllocationCounter::getStats(MemoryTag tag)
+{
+    const TagCounters& counters = tagCounters[static_cast<int>(tag)];
+    MemoryTagStats stats;
+    stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+    stats.liveCount = counters.liveCount.load(std::memory_order_relaxed);
+    stats.totalCount = counters.totalCount.load(std::memory_order_relaxed);
+    return stats;
+}
+
+const char* AllocationCounter::getTagName(MemoryTag tag)
+{
+    switch (tag) {
+        case MemoryTag::Other: return "Other";
+        case MemoryTag::Physics: return "Physics";
+        case MemoryTag::Player: return "Player";
+        case MemoryTag::Zombies: return "Zombies";
+        case MemoryTag::Objects: return "Objects";
+        case MemoryTag::Interface: return "Interface";
+        case MemoryTag::Profiler: return "Profiler";
+        default: return "?";
+    }
+}
+
+void* AllocationCounter::allocate(size_t size, MemoryTag tag)
+{
+    BlockHeader* header = static_cast<BlockHeader*>(std::malloc(sizeof(BlockHeader) + size));
+    if (!header) return nullptr;
+    header->size = size;
+    header->tag = tag;
+
+    totalCount.fetch_add(1, std::memory_order_relaxed);
+    totalBytes.fetch_add(size, std::memory_order_relaxed);
+    TagCounters& counters = tagCounters[static_cast<int>(tag)];
+    counters.liveBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+    counters.liveCount.fetch_add(1, std::memory_order_relaxed);
+    counters.totalCount.fetch_add(1, std::memory_order_relaxed);
+    return header + 1;
+}
+
+void AllocationCounter::deallocate(void* pointer)
+{
+    if (!pointer) return;
+    BlockHeader* header = static_cast<BlockHeader*>(pointer) - 1;
+
+    TagCounters& counters = tagCounters[static_cast<int>(header->tag)];
+    counters.liveBytes.fetch_sub(static_cast<int64_t>(header->size), std::memory_order_relaxed);
+    counters.liveCount.fetch_sub(1, std::memory_order_relaxed);
+    std::free(header);
+}
+
+void AllocationCounter::installBulletHooks()
+{
+#ifdef FORESTZ_ALLOC_TRACKING
+    btAlignedAllocSetCustom(allocateBullet, freeBullet);
+#endif
+}
+
+#ifdef FORESTZ_ALLOC_TRACKING
+
+// Les versions tableau et nothrow de la bibliothèque standard passent par celle-ci
+void* operator new(std::size_t size)
+{
+    if (size == 0) size = 1;
+
+    while (true) {
+        if (void* pointer = AllocationCounter::allocate(size, AllocationCounter::getCurrentTag())) {
+            return pointer;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void* pointer) noexcept
+{
+    AllocationCounter::deallocate(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    AllocationCounter::deallocate(pointer);
+}
+
+#endif
@@ -1,69 +1,392 @@
 #include "../include/BulletDebugDrawer.hpp"
+#include "../include/ContactEvents.hpp"
+#include "../include/Profiler.hpp"
+#include "../include/AllocationCounter.hpp"
 #include <OgreStringConverter.h>
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
+namespace {
+    const btVector3 STATIC_COLOUR(0.2f, 0.7f, 0.2f);
+    const btVector3 PLAYER_COLOUR(0.2f, 0.4f, 1.0f);
+    const btVector3 ZOMBIE_COLOUR(1.0f, 0.2f, 0.2f);
+    const btVector3 BULLET_COLOUR(1.0f, 1.0f, 0.2f);
+    const btVector3 OTHER_COLOUR(1.0f, 1.0f, 1.0f);
+    const btVector3 CONTACT_COLOUR(1.0f, 0.5f, 0.0f);
+
+    const float DEFAULT_MAX_DISTANCE = 1500.0f;
+
+    const btVector3& colourOf(DebugCategory category) {
+        switch (category) {
+            case DebugCategory::Static: return STATIC_COLOUR;
+            case DebugCategory::Player: return PLAYER_COLOUR;
+            case DebugCategory::Zombies: return ZOMBIE_COLOUR;
+            case DebugCategory::Bullets: return BULLET_COLOUR;
+            case DebugCategory::Contacts: return CONTACT_COLOUR;
+            default: return OTHER_COLOUR;
+        }
+    }
+}
+
+/**
+ * @brief Line list drawn from a range of a persistent vertex buffer
+ */
+class BulletDebugDrawer::LineRenderable : public Ogre::SimpleRenderable {
+public:
+    LineRenderable(const Ogre::String& name, size_t capacity)
+        : Ogre::SimpleRenderable(name)
+    {
+        mRenderOp.operationType = Ogre::RenderOperation::OT_LINE_LIST;
+        mRenderOp.useIndexes = false;
+        mRenderOp.vertexData = new Ogre::VertexData();
+        mRenderOp.vertexData->vertexStart = 0;
+        mRenderOp.vertexData->vertexCount = 0;
+
+        Ogre::VertexDeclaration* declaration = mRenderOp.vertexData->vertexDeclaration;
+        size_t offset = declaration->addElement(0, 0, Ogre::VET_FLOAT3, Ogre::VES_POSITION).getSize();
+        declaration->addElement(0, offset, Ogre::VET_UBYTE4_NORM, Ogre::VES_DIFFUSE);
+
+        buffer = Ogre::HardwareBufferManager::getSingleton().createVertexBuffer(
+            declaration->getVertexSize(0), capacity, Ogre::HBU_CPU_TO_GPU);
+        mRenderOp.vertexData->vertexBufferBinding->setBinding(0, buffer);
+
+        setMaterial(Ogre::MaterialManager::getSingleton().getByName(LINE_MATERIAL));
+        // Les sommets sont déjà dans le monde et changent à chaque image : jamais éliminé
+        setBoundingBox(Ogre::AxisAlignedBox::BOX_INFINITE);
+        setCastShadows(false);
+    }
+
+    ~LineRenderable() {
+        delete mRenderOp.vertexData;
+    }
+
+    Ogre::Real getSquaredViewDepth(const Ogre::Camera*) const override { return 0; }
+    Ogre::Real getBoundingRadius() const override { return 0; }
+
+    void setRange(size_t start, size_t count) {
+        mRenderOp.vertexData->vertexStart = start;
+        mRenderOp.vertexData->vertexCount = count;
+    }
+
+    Ogre::HardwareVertexBufferSharedPtr buffer;
+};
+
 BulletDebugDrawer::BulletDebugDrawer(Ogre::SceneManager* sceneMgr)
-    : mSceneMgr(sceneMgr), mLines(nullptr), mDebugMode(btIDebugDraw::DBG_DrawWireframe), mDrawing(false)
+    : mSceneMgr(sceneMgr)
+    , mNode(nullptr)
+    , mLines(nullptr)
+    , mTarget(nullptr)
+    , mRingCapacity(RING_VERTICES)
+    , mRingOffset(0)
+    , mCategories(~0u)
+    , mMaxDistance(DEFAULT_MAX_DISTANCE)
+    , mDebugMode(btIDebugDraw::DBG_DrawWireframe)
+    , mDrawing(false)
+    , mStaticBuilt(false)
+    , mVisible(false)
 {
-    Ogre::String name = "BulletDebugLines_" + Ogre::StringConverter::toString(rand());
-    mLines = mSceneMgr->createManualObject(name);
-    mLines->setDynamic(true);
-    mSceneMgr->getRootSceneNode()->createChildSceneNode()->attachObject(mLines);
+    // L'anneau (environ 24 Mo, GPU et CPU) attend le premier affichage : caché par défaut
+    mNode = mSceneMgr->getRootSceneNode()->createChildSceneNode();
 }
 
 BulletDebugDrawer::~BulletDebugDrawer()
 {
+    destroyStaticTiles();
     if (mLines) {
-        mSceneMgr->destroyManualObject(mLines);
+        mNode->detachObject(mLines);
+        delete mLines;
+    }
+    if (mNode) {
+        mSceneMgr->destroySceneNode(mNode);
+    }
+}
+
+void BulletDebugDrawer::createRingBuffer()
+{
+    MemoryScope memoryScope(MemoryTag::Physics);
+    try {
+        Ogre::String name = "BulletDebugLines_" + Ogre::StringConverter::toString(rand());
+        mLines = new LineRenderable(name, mRingCapacity);
+        mLines->setVisible(mVisible);
+        mNode->attachObject(mLines);
+        mVertices.reserve(mRingCapacity / 2);
+    } catch (const Ogre::Exception& e) {
+        std::cerr << "Failed to create debug line buffer: " << e.what() << std::endl;
+        delete mLines;
+        mLines = nullptr;
     }
 }
 
 void BulletDebugDrawer::begin()
 {
     if (!mLines) return;
-    mLines->clear();
-    mLines->begin("BaseWhiteNoLighting", Ogre::RenderOperation::OT_LINE_LIST); // Replace with your debug material
+    mVertices.clear();
+    mTarget = &mVertices;
     mDrawing = true;
 }
 
 void BulletDebugDrawer::end()
 {
     if (!mLines || !mDrawing) return;
-    mLines->end();
+    upload();
+    mTarget = nullptr;
     mDrawing = false;
 }
 
 void BulletDebugDrawer::clear()
 {
-    if (mLines) mLines->clear();
+    mVertices.clear();
+    if (mLines) mLines->setRange(0, 0);
 }
 
-void BulletDebugDrawer::drawLine(const btVector3& from, const btVector3& to, const btVector3& color)
+void BulletDebugDrawer::upload()
 {
-    if (!mLines || !mDrawing) return;
+    // Au plus une demi-capacité par image : la moitié précédente peut encore être lue par le GPU
+    size_t count = std::min(mVertices.size(), mRingCapacity / 2);
+    count -= count % 2;
+    if (count == 0) {
+        mLines->setRange(0, 0);
+        return;
+    }
 
-    // Validate the positions to avoid extreme values
-    const float MAX_VALID_COORD = 1e6f; // Define a maximum valid coordinate range
-    if ((from.x() > MAX_VALID_COORD || from.x() < -MAX_VALID_COORD ||
-         from.y() > MAX_VALID_COORD || from.y() < -MAX_VALID_COORD ||
-         from.z() > MAX_VALID_COORD || from.z() < -MAX_VALID_COORD ||
-         to.x() > MAX_VALID_COORD || to.x() < -MAX_VALID_COORD ||
-         to.y() > MAX_VALID_COORD || to.y() < -MAX_VALID_COORD ||
-         to.z() > MAX_VALID_COORD || to.z() < -MAX_VALID_COORD)) 
-    {
-        
+    // À la suite de l'image précédente sans attendre le GPU ; on ne jette le tampon qu'au bouclage
+    Ogre::HardwareBuffer::LockOptions options = Ogre::HardwareBuffer::HBL_NO_OVERWRITE;
+    if (mRingOffset + count > mRingCapacity) {
+        mRingOffset = 0;
+        options = Ogre::HardwareBuffer::HBL_DISCARD;
+    }
+
+    const size_t vertexSize = sizeof(LineVertex);
+    try {
+        void* destination = mLines->buffer->lock(mRingOffset * vertexSize, count * vertexSize, options);
+        std::memcpy(destination, mVertices.data(), count * vertexSize);
+        mLines->buffer->unlock();
+    } catch (const Ogre::Exception& e) {
+        std::cerr << "Failed to upload debug lines: " << e.what() << std::endl;
+        mLines->setRange(0, 0);
         return;
     }
 
+    mLines->setRange(mRingOffset, count);
+    mRingOffset += count;
+}
+
+void BulletDebugDrawer::drawLine(const btVector3& from, const btVector3& to, const btVector3& color)
+{
+    if (!mTarget) return;
+
     Ogre::ColourValue ogreColor(color.x(), color.y(), color.z());
+    const Ogre::uint32 packed = ogreColor.getAsBYTE();
+    mTarget->push_back({from.x(), from.y(), from.z(), packed});
+    mTarget->push_back({to.x(), to.y(), to.z(), packed});
+}
 
-    mLines->position(Ogre::Vector3(from.x(), from.y(), from.z()));
-    mLines->colour(ogreColor);
-    mLines->position(Ogre::Vector3(to.x(), to.y(), to.z()));
-    mLines->colour(ogreColor);
+void BulletDebugDrawer::drawContactPoint(const btVector3& pointOnB, const btVector3& normalOnB, btScalar distance,
+                                         int, const btVector3& color)
+{
+    drawLine(pointOnB, pointOnB + normalOnB * std::max(distance, btScalar(0.5f)) * 10, color);
 }
 
 void BulletDebugDrawer::reportErrorWarning(const char* warningString)
 {
     std::cerr << "[Bullet Debug] " << warningString << std::endl;
 }
+
+DebugCategory BulletDebugDrawer::categoryOf(const btCollisionObject* object) const
+{
+    if (object->isStaticObject()) return DebugCategory::Static;
+
+    const BodyHandle* handle = static_cast<const BodyHandle*>(object->getUserPointer());
+    if (!handle) return DebugCategory::Other;
+    switch (handle->kind) {
+        case BodyHandle::Kind::Player: return DebugCategory::Player;
+        case BodyHandle::Kind::Zombie: return DebugCategory::Zombies;
+        case BodyHandle::Kind::Bullet: return DebugCategory::Bullets;
+    }
+    return DebugCategory::Other;
+}
+
+void BulletDebugDrawer::buildStaticTiles(btCollisionWorld* world)
+{
+    MemoryScope memoryScope(MemoryTag::Physics);
+    destroyStaticTiles();
+    mStaticBuilt = true;
+
+    // Les plans ont une AABB infinie : on range chaque corps d'après son origine
+    const btCollisionObjectArray& objects = world->getCollisionObjectArray();
+    btVector3 boundsMin(BT_LARGE_FLOAT, 0, BT_LARGE_FLOAT);
+    btVector3 boundsMax(-BT_LARGE_FLOAT, 0, -BT_LARGE_FLOAT);
+    for (int i = 0; i < objects.size(); ++i) {
+        if (!objects[i]->isStaticObject()) continue;
+        boundsMin.setMin(objects[i]->getWorldTransform().getOrigin());
+        boundsMax.setMax(objects[i]->getWorldTransform().getOrigin());
+    }
+    if (boundsMin.x() > boundsMax.x()) return;
+
+    const btScalar cellX = std::max((boundsMax.x() - boundsMin.x()) / STATIC_TILE_GRID, btScalar(1));
+    const btScalar cellZ = std::max((boundsMax.z() - boundsMin.z()) / STATIC_TILE_GRID, btScalar(1));
+    std::vector<std::vector<LineVertex>> tiles(STATIC_TILE_GRID * STATIC_TILE_GRID);
+
+    // Émis une seule fois par Bullet, directement dans la tuile du corps
+    for (int i = 0; i < objects.size(); ++i) {
+        const btCollisionObject* object = objects[i];
+        if (!object->isStaticObject()) continue;
+
+        const btVector3& origin = object->getWorldTransform().getOrigin();
+        const int tileX = std::min(static_cast<int>((origin.x() - boundsMin.x()) / cellX), STATIC_TILE_GRID - 1);
+        const int tileZ = std::min(static_cast<int>((origin.z() - boundsMin.z()) / cellZ), STATIC_TILE_GRID - 1);
+        mTarget = &tiles[tileZ * STATIC_TILE_GRID + tileX];
+        world->debugDrawObject(object->getWorldTransform(), object->getCollisionShape(), STATIC_COLOUR);
+    }
+    mTarget = nullptr;
+
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        const std::vector<LineVertex>& lines = tiles[i];
+        if (lines.empty()) continue;
+
+        // Ogre mesure la distance de rendu depuis le nœud : un nœud par tuile, placé en son centre
+        Ogre::AxisAlignedBox bounds;
+        for (const LineVertex& vertex : lines) {
+            bounds.merge(Ogre::Vector3(vertex.x, vertex.y, vertex.z));
+        }
+        const Ogre::Vector3 centre = bounds.getCenter();
+        try {
+            Ogre::ManualObject* tile = mSceneMgr->createManualObject(
+                "BulletDebugStatic_" + Ogre::StringConverter::toString(reinterpret_cast<size_t>(this)) +
+                "_" + Ogre::StringConverter::toString(i));
+            tile->setCastShadows(false);
+            tile->estimateVertexCount(lines.size());
+            tile->begin(LINE_MATERIAL, Ogre::RenderOperation::OT_LINE_LIST);
+            Ogre::ColourValue colour;
+            for (const LineVertex& vertex : lines) {
+                colour.setAsBYTE(vertex.colour);
+                tile->position(vertex.x - centre.x, vertex.y - centre.y, vertex.z - centre.z);
+                tile->colour(colour);
+            }
+            tile->end();
+            // Ogre élimine chaque tuile selon le frustum et la distance, sans réémettre
+            tile->setRenderingDistance(mMaxDistance);
+            mNode->createChildSceneNode(centre)->attachObject(tile);
+            mStaticTiles.push_back(tile);
+        } catch (const Ogre::Exception& e) {
+            std::cerr << "Failed to build static debug tile: " << e.what() << std::endl;
+        }
+    }
+    updateStaticVisibility();
+}
+
+void BulletDebugDrawer::destroyStaticTiles()
+{
+    for (Ogre::ManualObject* tile : mStaticTiles) {
+        Ogre::SceneNode* tileNode = tile->getParentSceneNode();
+        mSceneMgr->destroyManualObject(tile);
+        if (tileNode) {
+            mSceneMgr->destroySceneNode(tileNode);
+        }
+    }
+    mStaticTiles.clear();
+}
+
+void BulletDebugDrawer::invalidateStatic()
+{
+    destroyStaticTiles();
+    mStaticBuilt = false;
+}
+
+void BulletDebugDrawer::updateStaticVisibility()
+{
+    const bool visible = mVisible && isCategoryEnabled(DebugCategory::Static);
+    for (Ogre::ManualObject* tile : mStaticTiles) {
+        tile->setVisible(visible);
+    }
+}
+
+void BulletDebugDrawer::drawWorld(btCollisionWorld* world, const Ogre::Camera* camera)
+{
+    PROFILE_SCOPE("DebugDraw");
+    if (!world || !mLines || !mVisible) return;
+
+    // debugDrawObject() passe par le drawer du monde
+    if (world->getDebugDrawer() != this) {
+        world->setDebugDrawer(this);
+    }
+    if (!mStaticBuilt) {
+        buildStaticTiles(world);
+    }
+
+    begin();
+
+    const Ogre::Vector3 eye = camera ? camera->getDerivedPosition() : Ogre::Vector3::ZERO;
+    const Ogre::Real maxDistanceSq = mMaxDistance * mMaxDistance;
+
+    // Corps mobiles : éliminés sur leur AABB avant que Bullet n'émette la moindre ligne
+    const btCollisionObjectArray& objects = world->getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); ++i) {
+        const btCollisionObject* object = objects[i];
+        const DebugCategory category = categoryOf(object);
+        if (category == DebugCategory::Static || !isCategoryEnabled(category)) continue;
+
+        btVector3 aabbMin, aabbMax;
+        object->getCollisionShape()->getAabb(object->getWorldTransform(), aabbMin, aabbMax);
+        const Ogre::AxisAlignedBox box(aabbMin.x(), aabbMin.y(), aabbMin.z(), aabbMax.x(), aabbMax.y(), aabbMax.z());
+        if (camera) {
+            if (box.squaredDistance(eye) > maxDistanceSq) continue;
+            if (!camera->isVisible(box)) continue;
+        }
+
+        world->debugDrawObject(object->getWorldTransform(), object->getCollisionShape(), colourOf(category));
+    }
+
+    if (isCategoryEnabled(DebugCategory::Contacts)) {
+        btDispatcher* dispatcher = world->getDispatcher();
+        const int manifoldCount = dispatcher->getNumManifolds();
+        for (int i = 0; i < manifoldCount; ++i) {
+            const btPersistentManifold* manifold = dispatcher->getManifoldByIndexInternal(i);
+            for (int j = 0; j < manifold->getNumContacts(); ++j) {
+                const btManifoldPoint& point = manifold->getContactPoint(j);
+                const btVector3& position = point.getPositionWorldOnB();
+                if (camera && eye.squaredDistance(Ogre::Vector3(position.x(), position.y(), position.z())) > maxDistanceSq) {
+                    continue;
+                }
+                drawContactPoint(position, point.m_normalWorldOnB, point.getDistance(), point.getLifeTime(),
+                                 CONTACT_COLOUR);
+            }
+        }
+    }
+
+    end();
+}
+
+void BulletDebugDrawer::setCategoryEnabled(DebugCategory category, bool enabled)
+{
+    const unsigned int bit = static_cast<unsigned int>(category);
+    mCategories = enabled ? (mCategories | bit) : (mCategories & ~bit);
+    if (category == DebugCategory::Static) updateStaticVisibility();
+}
+
+bool BulletDebugDrawer::isCategoryEnabled(DebugCategory category) const
+{
+    return (mCategories & static_cast<unsigned int>(category)) != 0;
+}
+
+void BulletDebugDrawer::toggleCategory(DebugCategory category)
+{
+    setCategoryEnabled(category, !isCategoryEnabled(category));
+}
+
+void BulletDebugDrawer::setMaxDistance(float distance)
+{
+    mMaxDistance = distance;
+    for (Ogre::ManualObject* tile : mStaticTiles) {
+        tile->setRenderingDistance(distance);
+    }
+}
+
+void BulletDebugDrawer::setVisible(bool visible)
+{
+    mVisible = visible;
+    if (visible && !mLines) createRingBuffer();
+    if (mLines) mLines->setVisible(visible);
+    updateStaticVisibility();
+}
@@ -0,0 +1,125 @@
+#include "../include/CollisionLayers.hpp"
+#include <algorithm>
+#include <iomanip>
+
+namespace {
+    enum : int {
+        GROUP_STATIC = 1 << 0,
+        GROUP_GROUND = 1 << 1,
+        GROUP_PLAYER = 1 << 2,
+        GROUP_ZOMBIE = 1 << 3,
+        GROUP_BULLET = 1 << 4
+    };
+
+    struct LayerSpec {
+        const char* name;
+        int group;
+        int mask;
+    };
+
+    // Must stay symmetric: A collides with B only if each mask contains the other group
+    const LayerSpec layerTable[] = {
+        // Static: trees and walls never test against each other or the ground
+        {"Static", GROUP_STATIC, GROUP_PLAYER | GROUP_ZOMBIE | GROUP_BULLET},
+        // Ground
+        {"Ground", GROUP_GROUND, GROUP_PLAYER | GROUP_ZOMBIE | GROUP_BULLET},
+        // Player: its own bullets go through it
+        {"Player", GROUP_PLAYER, GROUP_STATIC | GROUP_GROUND | GROUP_ZOMBIE},
+        // Zombie
+        {"Zombie", GROUP_ZOMBIE, GROUP_STATIC | GROUP_GROUND | GROUP_PLAYER | GROUP_ZOMBIE | GROUP_BULLET},
+        // Bullet: bullets never collide with each other
+        {"Bullet", GROUP_BULLET, GROUP_STATIC | GROUP_GROUND | GROUP_ZOMBIE}
+    };
+
+    static_assert(sizeof(layerTable) / sizeof(layerTable[0]) == static_cast<size_t>(CollisionLayer::Count),
+                  "Every collision layer needs an entry in layerTable");
+
+    int layerIndex(int group) {
+        return static_cast<int>(CollisionLayers::fromGroup(group));
+    }
+}
+
+int CollisionLayers::group(CollisionLayer layer) {
+    return layerTable[static_cast<int>(layer)].group;
+}
+
+int CollisionLayers::mask(CollisionLayer layer) {
+    return layerTable[static_cast<int>(layer)].mask;
+}
+
+const char* CollisionLayers::name(CollisionLayer layer) {
+    if (layer == CollisionLayer::Count) return "Untagged";
+    return layerTable[static_cast<int>(layer)].name;
+}
+
+CollisionLayer CollisionLayers::fromGroup(int group) {
+    for (int i = 0; i < static_cast<int>(CollisionLayer::Count); ++i) {
+        if (layerTable[i].group == group) {
+            return static_cast<CollisionLayer>(i);
+        }
+    }
+    return CollisionLayer::Count;
+}
+
+void CollisionLayers::addRigidBody(btDiscreteDynamicsWorld* dynamicsWorld, btRigidBody* body, CollisionLayer layer) {
+    dynamicsWorld->addRigidBody(body, group(layer), mask(layer));
+}
+
+void CollisionLayerStats::count(int (&matrix)[LAYER_COUNT + 1][LAYER_COUNT + 1], int groupA, int groupB) {
+    int a = layerIndex(groupA);
+    int b = layerIndex(groupB);
+    ++matrix[std::min(a, b)][std::max(a, b)];
+}
+
+void CollisionLayerStats::collect(btDiscreteDynamicsWorld* dynamicsWorld) {
+    std::fill(&pairs[0][0], &pairs[0][0] + (LAYER_COUNT + 1) * (LAYER_COUNT + 1), 0);
+    std::fill(&manifolds[0][0], &manifolds[0][0] + (LAYER_COUNT + 1) * (LAYER_COUNT + 1), 0);
+    totalPairs = 0;
+    totalManifolds = 0;
+    if (!dynamicsWorld) return;
+
+    // Pairs that passed the broadphase filter
+    btOverlappingPairCache* pairCache = dynamicsWorld->getBroadphase()->getOverlappingPairCache();
+    const btBroadphasePairArray& pairArray = pairCache->getOverlappingPairArray();
+    for (int i = 0; i < pairArray.size(); ++i) {
+        const btBroadphasePair& pair = pairArray[i];
+        count(pairs, pair.m_pProxy0->m_collisionFilterGroup, pair.m_pProxy1->m_collisionFilterGroup);
+    }
+    totalPairs = pairArray.size();
+
+    // Manifolds created by the narrowphase
+    btDispatcher* dispatcher = dynamicsWorld->getDispatcher();
+    totalManifolds = dispatcher->getNumManifolds();
+    for (int i = 0; i < totalManifolds; ++i) {
+        btPersistentManifold* manifold = dispatcher->getManifoldByIndexInternal(i);
+        count(manifolds,
+              manifold->getBody0()->getBroadphaseHandle()->m_collisionFilterGroup,
+              manifold->getBody1()->getBroadphaseHandle()->m_collisionFilterGroup);
+    }
+}
+
+int CollisionLayerStats::getPairCount(CollisionLayer a, CollisionLayer b) const {
+    int i = static_cast<int>(a);
+    int j = static_cast<int>(b);
+    return pairs[std::min(i, j)][std::max(i, j)];
+}
+
+int CollisionLayerStats::getManifoldCount(CollisionLayer a, CollisionLayer b) const {
+    int i = static_cast<int>(a);
+    int j = static_cast<int>(b);
+    return manifolds[std::min(i, j)][std::max(i, j)];
+}
+
+void CollisionLayerStats::print(std::ostream& out) const {
+    out << "=== Collision layers: " << totalPairs << " broadphase pairs, "
+        << totalManifolds << " manifolds ===" << std::endl;
+    for (int i = 0; i <= LAYER_COUNT; ++i) {
+        for (int j = i; j <= LAYER_COUNT; ++j) {
+            if (pairs[i][j] == 0 && manifolds[i][j] == 0) continue;
+            out << std::setw(8) << CollisionLayers::name(static_cast<CollisionLayer>(i)) << " / "
+                << std::setw(8) << std::left << CollisionLayers::name(static_cast<CollisionLayer>(j)) << std::right
+                << " pairs: " << std::setw(6) << pairs[i][j]
+                << " manifolds: " << std::setw(6) << manifolds[i][j] << std::endl;
+        }
+    }
+}
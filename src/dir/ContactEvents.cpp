@@ -0,0 +1,105 @@
+#include "../include/ContactEvents.hpp"
+#include "../include/Player.hpp"
+#include "../include/Zombies.hpp"
+#include "../include/Profiler.hpp"
+#include <algorithm>
+
+/**
+ * @brief Reads the typed handle attached to a collision object
+ * @param object Collision object from a manifold
+ * @return The handle, or nullptr for static world geometry
+ */
+BodyHandle* ContactEvents::getHandle(const btCollisionObject* object) {
+    return object ? static_cast<BodyHandle*>(object->getUserPointer()) : nullptr;
+}
+
+/**
+ * @brief Checks whether a manifold holds at least one penetrating contact
+ * @param manifold Persistent manifold from the dispatcher
+ * @return True if the two bodies actually touch
+ */
+bool ContactEvents::isTouching(const btPersistentManifold* manifold) {
+    for (int i = 0; i < manifold->getNumContacts(); ++i) {
+        if (manifold->getContactPoint(i).getDistance() <= 0.0f) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Collects the contacts of the last step and delivers the events
+ * @param dynamicsWorld Pointer to the physics world
+ * @param player Player receiving damage and owning the bullets
+ * @param zombies Zombies receiving bullet hits
+ */
+void ContactEvents::dispatch(btDiscreteDynamicsWorld* dynamicsWorld, Player* player, Zombies* zombies) {
+    // Collect first: delivering a hit may remove bodies, which destroys manifolds
+    collect(dynamicsWorld);
+    deliver(dynamicsWorld, player, zombies);
+}
+
+/**
+ * @brief Collects the contacts of the last step without touching the game
+ * @param dynamicsWorld Pointer to the physics world
+ */
+void ContactEvents::collect(btDiscreteDynamicsWorld* dynamicsWorld) {
+    PROFILE_SCOPE("Contacts");
+    if (!dynamicsWorld) return;
+
+    btDispatcher* dispatcher = dynamicsWorld->getDispatcher();
+    const int numManifolds = dispatcher->getNumManifolds();
+    for (int i = 0; i < numManifolds; ++i) {
+        btPersistentManifold* manifold = dispatcher->getManifoldByIndexInternal(i);
+        BodyHandle* a = getHandle(manifold->getBody0());
+        BodyHandle* b = getHandle(manifold->getBody1());
+
+        // Static geometry and bodies of the same kind produce no events
+        if (!a || !b || a->kind == b->kind) continue;
+        if (!isTouching(manifold)) continue;
+
+        if (a->kind == BodyHandle::Kind::Zombie) std::swap(a, b);
+
+        if (b->kind != BodyHandle::Kind::Zombie) continue;
+
+        if (a->kind == BodyHandle::Kind::Bullet) {
+            bulletHits.push_back({a, b->index});
+        } else if (a->kind == BodyHandle::Kind::Player) {
+            playerHits.push_back(b->index);
+        }
+    }
+}
+
+/**
+ * @brief Delivers the collected events and clears them
+ * @param dynamicsWorld Pointer to the physics world
+ * @param player Player receiving damage and owning the bullets
+ * @param zombies Zombies receiving bullet hits
+ */
+void ContactEvents::deliver(btDiscreteDynamicsWorld* dynamicsWorld, Player* player, Zombies* zombies) {
+    PROFILE_SCOPE("Contacts");
+    if (dynamicsWorld && zombies && player) {
+        // A bullet can touch several zombies in the same step: only the first one counts
+        std::sort(bulletHits.begin(), bulletHits.end(),
+                  [](const BulletHit& lhs, const BulletHit& rhs) { return lhs.bullet < rhs.bullet; });
+        bulletHits.erase(std::unique(bulletHits.begin(), bulletHits.end(),
+                                     [](const BulletHit& lhs, const BulletHit& rhs) { return lhs.bullet == rhs.bullet; }),
+                         bulletHits.end());
+
+        for (const BulletHit& hit : bulletHits) {
+            zombies->onBulletHit(hit.zombieIndex, BULLET_DAMAGE, dynamicsWorld);
+            // The handle index is read at removal time since removing a bullet moves another one
+            player->removeBullet(hit.bullet->index, dynamicsWorld);
+        }
+    }
+
+    if (player) {
+        for (size_t zombieIndex : playerHits) {
+            if (zombies && !zombies->isZombieAlive(zombieIndex)) continue;
+            player->takeDamage(ZOMBIE_DAMAGE);
+        }
+    }
+
+    bulletHits.clear();
+    playerHits.clear();
+}
@@ -1,80 +1,62 @@
 #include "Crosshair.hpp"
-#include <OgreOverlayManager.h>
-#include <OgreRoot.h>
+#include "AllocationCounter.hpp"
+#include <algorithm>
 
-Crosshair::Crosshair() 
-    : mOverlay(nullptr)
-    , mContainer(nullptr)
-    , mCrosshairVertical(nullptr)
-    , mCrosshairHorizontal(nullptr)
-    , mCenterX(0.5f)
-    , mCenterY(0.5f)
+namespace {
+    // Proportions de l'écran, celles de l'ancien overlay en coordonnées relatives
+    const float VERTICAL_LEFT = 0.4795f;   // Centré horizontalement
+    const float VERTICAL_TOP = 0.53f;
+    const float HORIZONTAL_LEFT = 0.46f;
+    const float HORIZONTAL_TOP = 0.5495f;  // Centré verticalement
+    const float LINE_LENGTH = 0.04f;       // Ligne fine et courte
+    const float LINE_THICKNESS = 0.001f;
+    const Ogre::ColourValue CROSSHAIR_COLOUR(1.0f, 1.0f, 1.0f, 1.0f); // Blanc, comme BaseWhite
+}
+
+Crosshair::Crosshair()
+    : mWidgets(nullptr)
+    , mCrosshairVertical(0)
+    , mCrosshairHorizontal(0)
+    , mCenterX(0.0f)
+    , mCenterY(0.0f)
 {
 }
 
 Crosshair::~Crosshair() {
-    if (mOverlay) {
-        Ogre::OverlayManager::getSingleton().destroy(mOverlay);
-    }
-    if (mContainer) {
-        Ogre::OverlayManager::getSingleton().destroyOverlayElement(mContainer);
-    }
-    if (mCrosshairVertical) {
-        Ogre::OverlayManager::getSingleton().destroyOverlayElement(mCrosshairVertical);
-    }
-    if (mCrosshairHorizontal) {
-        Ogre::OverlayManager::getSingleton().destroyOverlayElement(mCrosshairHorizontal);
-    }
 }
 
-void Crosshair::initialize(Ogre::SceneManager* scnMgr) {
-    Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
-    
-    // Créer l'overlay
-    mOverlay = overlayManager.create("CrosshairOverlay");
-    
-    // Créer le conteneur
-    mContainer = static_cast<Ogre::OverlayContainer*>(
-        overlayManager.createOverlayElement("Panel", "CrosshairContainer"));
-    mContainer->setMetricsMode(Ogre::GMM_RELATIVE);
-    mContainer->setPosition(0, 0);
-    mContainer->setDimensions(1, 1);
-    
+void Crosshair::initialize(ScreenQuadBatch& widgets) {
+    MemoryScope memoryScope(MemoryTag::Interface);
+    mWidgets = &widgets;
+
     // Créer les éléments du viseur
     createCrosshairElements();
-    
-    // Assembler l'overlay
-    mContainer->addChild(mCrosshairVertical);
-    mContainer->addChild(mCrosshairHorizontal);
-    mOverlay->add2D(mContainer);
-    
-    // Afficher l'overlay
-    mOverlay->setZOrder(500);
-    mOverlay->show();
 }
 
 void Crosshair::createCrosshairElements() {
-    Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
-    
-    // Créer la ligne verticale
-    mCrosshairVertical = static_cast<Ogre::PanelOverlayElement*>(
-        overlayManager.createOverlayElement("Panel", "CrosshairVertical"));
-    mCrosshairVertical->setMetricsMode(Ogre::GMM_RELATIVE);
-    mCrosshairVertical->setPosition(0.4795f, 0.53f); // Centré horizontalement
-    mCrosshairVertical->setDimensions(0.001f, 0.04f); // Ligne fine et courte
-    mCrosshairVertical->setMaterialName("BaseWhite"); // Couleur blanche par défaut
-    
-    // Créer la ligne horizontale
-    mCrosshairHorizontal = static_cast<Ogre::PanelOverlayElement*>(
-        overlayManager.createOverlayElement("Panel", "CrosshairHorizontal"));
-    mCrosshairHorizontal->setMetricsMode(Ogre::GMM_RELATIVE);
-    mCrosshairHorizontal->setPosition(0.46f, 0.5495f); // Centré verticalement
-    mCrosshairHorizontal->setDimensions(0.04f, 0.001f); // Ligne fine et courte
-    mCrosshairHorizontal->setMaterialName("BaseWhite"); // Couleur blanche par défaut
+    // Rectangles vides jusqu'au premier update, qui connaît la taille de l'écran
+    mCrosshairVertical = mWidgets->addQuad(0, 0, 0, 0, CROSSHAIR_COLOUR);
+    mCrosshairHorizontal = mWidgets->addQuad(0, 0, 0, 0, CROSSHAIR_COLOUR);
 }
 
 void Crosshair::update(int screenWidth, int screenHeight) {
+    if (!mWidgets) return;
+
     // Mettre à jour la position du centre en coordonnées d'écran
-    mCenterX = screenWidth * 0.5f;
-    mCenterY = screenHeight * 0.5f;
-} 
\ No newline at end of file
+    const float centerX = screenWidth * 0.5f;
+    const float centerY = screenHeight * 0.5f;
+    if (centerX == mCenterX && centerY == mCenterY) return;
+    mCenterX = centerX;
+    mCenterY = centerY;
+
+    // Au moins un pixel d'épaisseur, quelle que soit la résolution
+    const float thicknessX = std::max(1.0f, screenWidth * LINE_THICKNESS);
+    const float thicknessY = std::max(1.0f, screenHeight * LINE_THICKNESS);
+    const float lengthX = screenWidth * LINE_LENGTH;
+    const float lengthY = screenHeight * LINE_LENGTH;
+
+    mWidgets->setRect(mCrosshairVertical, screenWidth * VERTICAL_LEFT, screenHeight * VERTICAL_TOP,
+                      thicknessX, lengthY);
+    mWidgets->setRect(mCrosshairHorizontal, screenWidth * HORIZONTAL_LEFT, screenHeight * HORIZONTAL_TOP,
+                      lengthX, thicknessY);
+}
@@ -0,0 +1,105 @@
+#include "../include/EntityStore.hpp"
+#include <cstdlib>
+#include <iostream>
+
+void EntityStore::destroy(EntityId entity)
+{
+    if (!isAlive(entity)) return;
+
+    EntityRecord& record = records[entity.index];
+    removeRow(*archetypes[record.archetype], record.row);
+
+    record.alive = false;
+    ++record.generation; // Handles still pointing here become stale
+    freeIndices.push_back(entity.index);
+    --liveCount;
+}
+
+bool EntityStore::isAlive(EntityId entity) const
+{
+    return entity.index < records.size() && records[entity.index].alive &&
+           records[entity.index].generation == entity.generation;
+}
+
+uint32_t EntityStore::findArchetype(ComponentMask mask) const
+{
+    // A handful of archetypes in this game: a linear scan beats a map
+    for (uint32_t i = 0; i < archetypes.size(); ++i) {
+        if (archetypes[i]->mask == mask) return i;
+    }
+    return static_cast<uint32_t>(archetypes.size());
+}
+
+uint32_t EntityStore::createArchetypeFrom(const Archetype* source, ComponentMask keep)
+{
+    std::unique_ptr<Archetype> archetype = std::make_unique<Archetype>();
+    if (source) {
+        for (unsigned int id = 0; id < MAX_COMPONENT_TYPES; ++id) {
+            if (!(keep & (ComponentMask(1) << id)) || source->columnOf[id] < 0) continue;
+            archetype->columnOf[id] = static_cast<int>(archetype->columns.size());
+            archetype->columns.push_back(source->columns[source->columnOf[id]]->createEmpty());
+            archetype->mask |= ComponentMask(1) << id;
+        }
+    }
+    archetypes.push_back(std::move(archetype));
+    return static_cast<uint32_t>(archetypes.size() - 1);
+}
+
+EntityId EntityStore::allocateEntity(uint32_t archetype, uint32_t row)
+{
+    uint32_t index;
+    if (!freeIndices.empty()) {
+        index = freeIndices.back();
+        freeIndices.pop_back();
+    } else {
+        index = static_cast<uint32_t>(records.size());
+        records.emplace_back();
+    }
+
+    EntityRecord& record = records[index];
+    record.archetype = archetype;
+    record.row = row;
+    record.alive = true;
+    ++liveCount;
+    return {index, record.generation};
+}
+
+void EntityStore::removeRow(Archetype& archetype, uint32_t row)
+{
+    // Swap with the last row: the arrays stay dense, only the moved entity's record changes
+    const uint32_t last = static_cast<uint32_t>(archetype.entities.size() - 1);
+    for (std::unique_ptr<ColumnBase>& column : archetype.columns) {
+        column->swapRemove(row);
+    }
+    if (row != last) {
+        archetype.entities[row] = archetype.entities[last];
+        records[archetype.entities[row].index].row = row;
+    }
+    archetype.entities.pop_back();
+}
+
+void EntityStore::moveEntity(EntityId entity, uint32_t target)
+{
+    EntityRecord& record = records[entity.index];
+    Archetype& source = *archetypes[record.archetype];
+    Archetype& destination = *archetypes[target];
+
+    // Components the destination does not have are dropped with the source row
+    for (unsigned int id = 0; id < MAX_COMPONENT_TYPES; ++id) {
+        if (destination.columnOf[id] < 0 || source.columnOf[id] < 0) continue;
+        destination.columns[destination.columnOf[id]]->appendFrom(*source.columns[source.columnOf[id]], record.row);
+    }
+    const uint32_t sourceRow = record.row;
+    const uint32_t destinationRow = static_cast<uint32_t>(destination.entities.size());
+    destination.entities.push_back(entity);
+    removeRow(source, sourceRow);
+
+    record.archetype = target;
+    record.row = destinationRow;
+}
+
+void EntityStore::reportTooManyComponents()
+{
+    std::cerr << "Error: more than " << MAX_COMPONENT_TYPES << " component types in EntityStore" << std::endl;
+    std::abort();
+}
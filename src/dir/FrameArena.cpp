@@ -0,0 +1,93 @@
+#include "../include/FrameArena.hpp"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+FrameArena::FrameArena(size_t capacity)
+    : buffer(static_cast<char*>(std::malloc(capacity)))
+    , capacity(buffer ? capacity : 0)
+    , offset(0)
+    , peak(0)
+    , overflowBytes(0)
+    , overflowCount(0)
+{
+}
+
+FrameArena::~FrameArena()
+{
+    reset();
+    std::free(buffer);
+}
+
+FrameArena& FrameArena::get()
+{
+    static FrameArena arena;
+    return arena;
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment)
+{
+    const uintptr_t base = reinterpret_cast<uintptr_t>(buffer);
+    const size_t aligned = ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+    if (buffer && aligned + size <= capacity) {
+        offset = aligned + size;
+        return buffer + aligned;
+    }
+
+    // Plus de place : on dépanne avec le tas, le bloc grandira au prochain reset()
+    const size_t blockSize = std::max<size_t>(size, 1) + alignment;
+    void* block = std::malloc(blockSize);
+    if (!block) throw std::bad_alloc();
+    overflowBlocks.push_back(block);
+    overflowBytes += blockSize;
+    ++overflowCount;
+
+    const uintptr_t address = reinterpret_cast<uintptr_t>(block);
+    return reinterpret_cast<void*>((address + alignment - 1) & ~(uintptr_t(alignment) - 1));
+}
+
+void FrameArena::reset()
+{
+    const size_t used = offset + overflowBytes;
+    peak = std::max(peak, used);
+
+    if (!overflowBlocks.empty()) {
+        for (void* block : overflowBlocks) {
+            std::free(block);
+        }
+        overflowBlocks.clear();
+
+        // Half again the demand of the frame that overflowed
+        const size_t newCapacity = used + used / 2;
+        if (char* newBuffer = static_cast<char*>(std::malloc(newCapacity))) {
+            std::free(buffer);
+            buffer = newBuffer;
+            capacity = newCapacity;
+        }
+    }
+
+    offset = 0;
+    overflowBytes = 0;
+}
+
+const char* FrameArena::format(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    va_list measure;
+    va_copy(measure, args);
+    const int length = std::vsnprintf(nullptr, 0, fmt, measure);
+    va_end(measure);
+
+    if (length < 0) {
+        va_end(args);
+        return "";
+    }
+
+    char* text = static_cast<char*>(allocate(static_cast<size_t>(length) + 1, 1));
+    std::vsnprintf(text, static_cast<size_t>(length) + 1, fmt, args);
+    va_end(args);
+    return text;
+}
@@ -0,0 +1,160 @@
+#include "../include/GameSettings.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    std::string trim(const std::string& text) {
+        const size_t begin = text.find_first_not_of(" \t\r");
+        if (begin == std::string::npos) return std::string();
+        const size_t end = text.find_last_not_of(" \t\r");
+        return text.substr(begin, end - begin + 1);
+    }
+
+    bool parseBool(const std::string& value) {
+        return value == "yes" || value == "true" || value == "1" || value == "on";
+    }
+
+    /**
+     * @brief Sets one key of a preset
+     * @return False if the key is unknown
+     */
+    bool setKey(QualityPreset& preset, const std::string& key, const std::string& value) {
+        if (key == "TreeCount") {
+            preset.treeCount = std::max(0, std::atoi(value.c_str()));
+        } else if (key == "TreeDrawDistance") {
+            preset.treeDrawDistance = std::max(0.0f, static_cast<float>(std::atof(value.c_str())));
+        } else if (key == "Shadows") {
+            if (!ShadowSystem::parseQuality(value, preset.shadows)) {
+                std::cerr << "Unknown shadow quality '" << value << "' in settings" << std::endl;
+            }
+        } else if (key == "ZombieCap") {
+            preset.zombieCap = std::max(0, std::atoi(value.c_str()));
+        } else if (key == "PhysicsRate") {
+            preset.physicsRate = static_cast<float>(std::atof(value.c_str()));
+        } else if (key == "VSync") {
+            preset.vsync = parseBool(value);
+        } else {
+            return false;
+        }
+        return true;
+    }
+}
+
+GameSettings::GameSettings(const OgreBites::FileSystemLayer& fsLayer)
+    : selected(1)
+{
+    // Préréglages intégrés : "medium" reprend les valeurs de lib.hpp
+    QualityPreset low;
+    low.treeCount = TREE_NUMBER / 2;
+    low.treeDrawDistance = 3000.0f;
+    low.shadows = ShadowQuality::Off;
+    low.zombieCap = 40;
+    low.physicsRate = 30.0f;
+
+    QualityPreset medium;
+
+    QualityPreset high;
+    high.treeCount = TREE_NUMBER * 2;
+    high.shadows = ShadowQuality::High;
+    high.zombieCap = 400;
+
+    presets = {{"low", low}, {"medium", medium}, {"high", high}};
+
+    // FORESTZ_SETTINGS remplace le fichier de l'utilisateur (profil livré pour une machine donnée)
+    const char* settingsPath = std::getenv("FORESTZ_SETTINGS");
+    userPath = settingsPath ? settingsPath : fsLayer.getWritablePath("settings.cfg");
+    defaultPath = fsLayer.getConfigFilePath("settings.cfg");
+}
+
+bool GameSettings::load() {
+    if (read(userPath)) return true;
+    return defaultPath != userPath && read(defaultPath);
+}
+
+bool GameSettings::read(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) return false;
+
+    std::string selection;
+    std::string section;
+    std::string line;
+    while (std::getline(file, line)) {
+        line = trim(line);
+        if (line.empty() || line[0] == '#' || line[0] == ';') continue;
+
+        if (line.front() == '[' && line.back() == ']') {
+            section = trim(line.substr(1, line.size() - 2));
+            continue;
+        }
+
+        const size_t equals = line.find('=');
+        if (equals == std::string::npos) continue;
+        const std::string key = trim(line.substr(0, equals));
+        const std::string value = trim(line.substr(equals + 1));
+
+        if (section == "General") {
+            if (key == "Preset") selection = value;
+            continue;
+        }
+        if (section.empty()) continue;
+
+        auto preset = std::find_if(presets.begin(), presets.end(),
+                                   [&section](const auto& entry) { return entry.first == section; });
+        if (preset == presets.end()) {
+            // Nouveau préréglage : part des valeurs de "medium"
+            presets.emplace_back(section, QualityPreset());
+            preset = presets.end() - 1;
+        }
+        if (!setKey(preset->second, key, value)) {
+            std::cerr << path << ": unknown setting " << key << " in [" << section << "]" << std::endl;
+        }
+    }
+
+    if (!selection.empty() && !selectPreset(selection)) {
+        std::cerr << path << ": unknown preset '" << selection << "', using " << getPresetName() << std::endl;
+    }
+    return true;
+}
+
+bool GameSettings::save() const {
+    std::ofstream file(userPath);
+    if (!file) {
+        std::cerr << "Cannot write settings to " << userPath << std::endl;
+        return false;
+    }
+
+    file << "# ForestZ settings: Preset selects one of the sections below\n";
+    file << "[General]\nPreset=" << getPresetName() << "\n";
+    for (const auto& entry : presets) {
+        const QualityPreset& preset = entry.second;
+        file << "\n[" << entry.first << "]\n"
+             << "TreeCount=" << preset.treeCount << "\n"
+             << "TreeDrawDistance=" << preset.treeDrawDistance << "\n"
+             << "Shadows=" << ShadowSystem::getQualityName(preset.shadows) << "\n"
+             << "ZombieCap=" << preset.zombieCap << "\n"
+             << "PhysicsRate=" << preset.physicsRate << "\n"
+             << "VSync=" << (preset.vsync ? "yes" : "no") << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+bool GameSettings::selectPreset(const std::string& name) {
+    for (size_t i = 0; i < presets.size(); ++i) {
+        if (presets[i].first == name) {
+            selected = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::string> GameSettings::getPresetNames() const {
+    std::vector<std::string> names;
+    names.reserve(presets.size());
+    for (const auto& entry : presets) {
+        names.push_back(entry.first);
+    }
+    return names;
+}
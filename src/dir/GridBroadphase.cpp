@@ -0,0 +1,284 @@
+#include "../include/GridBroadphase.hpp"
+#include <BulletCollision/BroadphaseCollision/btOverlappingPairCache.h>
+#include <LinearMath/btAabbUtil2.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    template <typename T>
+    void swapRemove(std::vector<T*>& list, T* item) {
+        auto it = std::find(list.begin(), list.end(), item);
+        if (it != list.end()) {
+            *it = list.back();
+            list.pop_back();
+        }
+    }
+}
+
+GridBroadphase::GridBroadphase(const btVector3& worldMin, const btVector3& worldMax, btScalar cellSize,
+                               btOverlappingPairCache* pairCache)
+    : worldMin(worldMin)
+    , worldMax(worldMax)
+    , cellSize(cellSize)
+    , inverseCellSize(btScalar(1.0) / cellSize)
+    , pairCache(pairCache)
+    , ownsPairCache(pairCache == nullptr)
+    , nextUniqueId(2) // Same convention as Bullet's broadphases: 0 and 1 are reserved
+    , queryStamp(0)
+{
+    cellsX = std::max(1, static_cast<int>(std::ceil((worldMax.x() - worldMin.x()) * inverseCellSize)));
+    cellsZ = std::max(1, static_cast<int>(std::ceil((worldMax.z() - worldMin.z()) * inverseCellSize)));
+    cells.resize(static_cast<size_t>(cellsX) * cellsZ);
+
+    if (ownsPairCache) {
+        this->pairCache = new btHashedOverlappingPairCache();
+    }
+}
+
+GridBroadphase::~GridBroadphase()
+{
+    for (GridProxy* proxy : proxies) {
+        delete proxy;
+    }
+    if (ownsPairCache) {
+        delete pairCache;
+    }
+}
+
+void GridBroadphase::computeCellRange(const btVector3& aabbMin, const btVector3& aabbMax,
+                                      int& minX, int& minZ, int& maxX, int& maxZ) const
+{
+    // Anything outside the world (infinite planes) is clamped to the border cells
+    auto toCell = [this](btScalar value, btScalar origin, int count) {
+        btScalar cell = std::floor((value - origin) * inverseCellSize);
+        return static_cast<int>(btClamped(cell, btScalar(0), btScalar(count - 1)));
+    };
+    minX = toCell(aabbMin.x(), worldMin.x(), cellsX);
+    maxX = toCell(aabbMax.x(), worldMin.x(), cellsX);
+    minZ = toCell(aabbMin.z(), worldMin.z(), cellsZ);
+    maxZ = toCell(aabbMax.z(), worldMin.z(), cellsZ);
+}
+
+void GridBroadphase::insertInCells(GridProxy* proxy)
+{
+    computeCellRange(proxy->m_aabbMin, proxy->m_aabbMax,
+                     proxy->cellMinX, proxy->cellMinZ, proxy->cellMaxX, proxy->cellMaxZ);
+
+    int cellCount = (proxy->cellMaxX - proxy->cellMinX + 1) * (proxy->cellMaxZ - proxy->cellMinZ + 1);
+    proxy->oversized = cellCount > MAX_CELLS_PER_PROXY;
+    if (proxy->oversized) {
+        oversizedProxies.push_back(proxy);
+        return;
+    }
+
+    for (int z = proxy->cellMinZ; z <= proxy->cellMaxZ; ++z) {
+        for (int x = proxy->cellMinX; x <= proxy->cellMaxX; ++x) {
+            cells[static_cast<size_t>(z) * cellsX + x].push_back(proxy);
+        }
+    }
+}
+
+void GridBroadphase::removeFromCells(GridProxy* proxy)
+{
+    if (proxy->oversized) {
+        swapRemove(oversizedProxies, proxy);
+        return;
+    }
+
+    for (int z = proxy->cellMinZ; z <= proxy->cellMaxZ; ++z) {
+        for (int x = proxy->cellMinX; x <= proxy->cellMaxX; ++x) {
+            swapRemove(cells[static_cast<size_t>(z) * cellsX + x], proxy);
+        }
+    }
+}
+
+void GridBroadphase::markMoved(GridProxy* proxy)
+{
+    if (!proxy->moved) {
+        proxy->moved = true;
+        movedProxies.push_back(proxy);
+    }
+}
+
+btBroadphaseProxy* GridBroadphase::createProxy(const btVector3& aabbMin, const btVector3& aabbMax, int shapeType,
+                                               void* userPtr, int collisionFilterGroup, int collisionFilterMask,
+                                               btDispatcher* dispatcher)
+{
+    (void)shapeType;
+    (void)dispatcher;
+
+    GridProxy* proxy = new GridProxy(aabbMin, aabbMax, userPtr, collisionFilterGroup, collisionFilterMask);
+    proxy->m_uniqueId = nextUniqueId++;
+    proxy->slot = static_cast<int>(proxies.size());
+    proxies.push_back(proxy);
+
+    insertInCells(proxy);
+    markMoved(proxy);
+    return proxy;
+}
+
+void GridBroadphase::destroyProxy(btBroadphaseProxy* proxyOrg, btDispatcher* dispatcher)
+{
+    GridProxy* proxy = static_cast<GridProxy*>(proxyOrg);
+
+    removeFromCells(proxy);
+    pairCache->removeOverlappingPairsContainingProxy(proxy, dispatcher);
+    if (proxy->moved) {
+        swapRemove(movedProxies, proxy);
+    }
+
+    // Keep the proxy array dense
+    GridProxy* last = proxies.back();
+    proxies[proxy->slot] = last;
+    last->slot = proxy->slot;
+    proxies.pop_back();
+
+    delete proxy;
+}
+
+void GridBroadphase::setAabb(btBroadphaseProxy* proxyOrg, const btVector3& aabbMin, const btVector3& aabbMax,
+                             btDispatcher* dispatcher)
+{
+    (void)dispatcher;
+    GridProxy* proxy = static_cast<GridProxy*>(proxyOrg);
+
+    // The world refreshes every AABB each step: static bodies stop here
+    if (proxy->m_aabbMin == aabbMin && proxy->m_aabbMax == aabbMax) return;
+
+    int minX, minZ, maxX, maxZ;
+    computeCellRange(aabbMin, aabbMax, minX, minZ, maxX, maxZ);
+    bool sameCells = minX == proxy->cellMinX && minZ == proxy->cellMinZ &&
+                     maxX == proxy->cellMaxX && maxZ == proxy->cellMaxZ;
+
+    if (!sameCells) {
+        removeFromCells(proxy);
+    }
+    proxy->m_aabbMin = aabbMin;
+    proxy->m_aabbMax = aabbMax;
+    if (!sameCells) {
+        insertInCells(proxy);
+    }
+
+    markMoved(proxy);
+}
+
+void GridBroadphase::getAabb(btBroadphaseProxy* proxy, btVector3& aabbMin, btVector3& aabbMax) const
+{
+    aabbMin = proxy->m_aabbMin;
+    aabbMax = proxy->m_aabbMax;
+}
+
+template <typename Visitor>
+void GridBroadphase::visitCandidates(const btVector3& aabbMin, const btVector3& aabbMax, Visitor&& visit)
+{
+    // Each proxy is visited once per query even if it spans several cells
+    ++queryStamp;
+
+    int minX, minZ, maxX, maxZ;
+    computeCellRange(aabbMin, aabbMax, minX, minZ, maxX, maxZ);
+
+    if ((maxX - minX + 1) * (maxZ - minZ + 1) > MAX_CELLS_PER_PROXY) {
+        for (GridProxy* other : proxies) {
+            visit(other);
+        }
+        return;
+    }
+
+    for (int z = minZ; z <= maxZ; ++z) {
+        for (int x = minX; x <= maxX; ++x) {
+            for (GridProxy* other : cells[static_cast<size_t>(z) * cellsX + x]) {
+                if (other->queryStamp == queryStamp) continue;
+                other->queryStamp = queryStamp;
+                visit(other);
+            }
+        }
+    }
+    for (GridProxy* other : oversizedProxies) {
+        visit(other);
+    }
+}
+
+bool GridBroadphase::testPair(GridProxy* proxy, GridProxy* other)
+{
+    if (!TestAabbAgainstAabb2(proxy->m_aabbMin, proxy->m_aabbMax, other->m_aabbMin, other->m_aabbMax)) {
+        return false;
+    }
+    // The pair cache applies the collision group/mask filter and ignores known pairs
+    return pairCache->addOverlappingPair(proxy, other) != nullptr;
+}
+
+void GridBroadphase::findPairs(GridProxy* proxy)
+{
+    visitCandidates(proxy->m_aabbMin, proxy->m_aabbMax, [this, proxy](GridProxy* other) {
+        if (other != proxy) {
+            testPair(proxy, other);
+        }
+    });
+}
+
+void GridBroadphase::calculateOverlappingPairs(btDispatcher* dispatcher)
+{
+    if (movedProxies.empty()) return;
+
+    for (GridProxy* proxy : movedProxies) {
+        findPairs(proxy);
+    }
+
+    // Drop the pairs of moved proxies that separated
+    struct RemoveSeparatedPairs : public btOverlapCallback {
+        bool processOverlap(btBroadphasePair& pair) override {
+            GridProxy* a = static_cast<GridProxy*>(pair.m_pProxy0);
+            GridProxy* b = static_cast<GridProxy*>(pair.m_pProxy1);
+            if (!a->moved && !b->moved) return false;
+            return !TestAabbAgainstAabb2(a->m_aabbMin, a->m_aabbMax, b->m_aabbMin, b->m_aabbMax);
+        }
+    } removeSeparated;
+    pairCache->processAllOverlappingPairs(&removeSeparated, dispatcher);
+
+    for (GridProxy* proxy : movedProxies) {
+        proxy->moved = false;
+    }
+    movedProxies.clear();
+}
+
+void GridBroadphase::rayTest(const btVector3& rayFrom, const btVector3& rayTo, btBroadphaseRayCallback& rayCallback,
+                             const btVector3& aabbMin, const btVector3& aabbMax)
+{
+    (void)rayTo;
+    for (GridProxy* proxy : proxies) {
+        btVector3 bounds[2] = {proxy->m_aabbMin - aabbMax, proxy->m_aabbMax - aabbMin};
+        btScalar lambda = 0;
+        if (btRayAabb2(rayFrom, rayCallback.m_rayDirectionInverse, rayCallback.m_signs, bounds,
+                       lambda, 0, rayCallback.m_lambda_max)) {
+            rayCallback.process(proxy);
+        }
+    }
+}
+
+void GridBroadphase::aabbTest(const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseAabbCallback& callback)
+{
+    visitCandidates(aabbMin, aabbMax, [&](GridProxy* other) {
+        if (TestAabbAgainstAabb2(aabbMin, aabbMax, other->m_aabbMin, other->m_aabbMax)) {
+            callback.process(other);
+        }
+    });
+}
+
+void GridBroadphase::getBroadphaseAabb(btVector3& aabbMin, btVector3& aabbMax) const
+{
+    aabbMin = worldMin;
+    aabbMax = worldMax;
+}
+
+void GridBroadphase::printStats()
+{
+    size_t largestCell = 0;
+    for (const auto& cell : cells) {
+        largestCell = std::max(largestCell, cell.size());
+    }
+    std::cout << "GridBroadphase: " << cellsX << "x" << cellsZ << " cells of " << cellSize
+              << ", " << proxies.size() << " proxies (" << oversizedProxies.size() << " oversized)"
+              << ", largest cell " << largestCell
+              << ", " << pairCache->getNumOverlappingPairs() << " pairs" << std::endl;
+}
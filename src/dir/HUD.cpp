@@ -1,101 +1,77 @@
 #include "../include/HUD.hpp"
-#include <sstream>
+#include "../include/Profiler.hpp"
+#include "../include/AllocationCounter.hpp"
+#include <algorithm>
+
+namespace {
+    const float BAR_LEFT = 10.0f;
+    const float BAR_WIDTH = 500.0f;
+    const float BAR_HEIGHT = 50.0f;
+    const float HEALTH_BAR_TOP = 980.0f;
+    const float ENERGY_BAR_TOP = 1040.0f;
+
+    const Ogre::ColourValue BAR_BACKGROUND(0.2f, 0.2f, 0.2f, 0.8f);  // Core/StatsBlockCenter
+    const Ogre::ColourValue HEALTH_COLOUR(1.0f, 0.0f, 0.0f, 0.7f);    // Core/HealthBar
+    const Ogre::ColourValue ENERGY_COLOUR(1.0f, 1.0f, 1.0f, 0.7f);    // Core/EnergyBar
+
+    // Ancien overlay en Z 100 : sous le minimap (200) et les textes (300)
+    const Ogre::ushort HUD_RENDER_PRIORITY = 10001;
+}
 
 HUD::HUD()
-    : hudOverlay(nullptr)
-    , bar1(nullptr)
-    , bar2(nullptr)
-    , energyFill(nullptr)
-    , healthFill(nullptr)
+    : healthFill(0)
+    , energyFill(0)
 {
 }
 
 HUD::~HUD() {
-    Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
-    if (healthFill) overlayManager.destroyOverlayElement(healthFill);
-    if (energyFill) overlayManager.destroyOverlayElement(energyFill);
-    if (bar1) overlayManager.destroyOverlayElement(bar1);
-    if (bar2) overlayManager.destroyOverlayElement(bar2);
-    if (hudOverlay) overlayManager.destroy(hudOverlay);
 }
 
-void HUD::initialize() {
-    Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
-    
-    // Créer l'overlay principal
-    hudOverlay = overlayManager.create("PlayerHUD");
-    
+void HUD::initialize(Ogre::SceneManager* scnMgr) {
+    MemoryScope memoryScope(MemoryTag::Interface);
+
+    // Un seul tampon pour les barres et le viseur : un appel de rendu pour tout le HUD
+    if (!widgets.initialize(scnMgr, "PlayerHUD", HUD_RENDER_PRIORITY)) return;
+
     createBars();
-    
-    // Z-order plus bas pour que les barres soient sous les textes
-    hudOverlay->setZOrder(100);
     show();
 }
 
 void HUD::createBars() {
-    Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
-    
-    // Créer la première barre (fond de vie)
-    bar1 = static_cast<Ogre::OverlayContainer*>(
-        overlayManager.createOverlayElement("Panel", "Bar1"));
-    bar1->setMetricsMode(Ogre::GMM_PIXELS);
-    bar1->setPosition(10, 980);
-    bar1->setDimensions(500, 50);
-    bar1->setMaterialName("Core/StatsBlockCenter");
-    bar1->setColour(Ogre::ColourValue(0.0f, 0.0f, 0.0f, 0.7f)); // Fond noir semi-transparent
-    
-    // Créer la barre de remplissage de vie
-    healthFill = static_cast<Ogre::OverlayContainer*>(
-        overlayManager.createOverlayElement("Panel", "HealthFill"));
-    healthFill->setMetricsMode(Ogre::GMM_PIXELS);
-    healthFill->setPosition(0, 0); // Position relative au parent (bar1)
-    healthFill->setDimensions(500, 50);
-    healthFill->setMaterialName("Core/HealthBar");
-    
-    // Créer la deuxième barre (fond d'énergie)
-    bar2 = static_cast<Ogre::OverlayContainer*>(
-        overlayManager.createOverlayElement("Panel", "Bar2"));
-    bar2->setMetricsMode(Ogre::GMM_PIXELS);
-    bar2->setPosition(10, 1040);
-    bar2->setDimensions(500, 50);
-    bar2->setMaterialName("Core/StatsBlockCenter");
-    bar2->setColour(Ogre::ColourValue(0.0f, 0.0f, 0.0f, 0.7f)); // Fond noir semi-transparent
-    
-    // Créer la barre de remplissage d'énergie
-    energyFill = static_cast<Ogre::OverlayContainer*>(
-        overlayManager.createOverlayElement("Panel", "EnergyFill"));
-    energyFill->setMetricsMode(Ogre::GMM_PIXELS);
-    energyFill->setPosition(0, 0); // Position relative au parent (bar2)
-    energyFill->setDimensions(500, 50);
-    energyFill->setMaterialName("Core/EnergyBar");
-    
-    // Ajouter les barres à l'overlay
-    hudOverlay->add2D(bar1);
-    hudOverlay->add2D(bar2);
-    bar1->addChild(healthFill);
-    bar2->addChild(energyFill);
+    // Fonds d'abord, les remplissages sont dessinés par-dessus
+    widgets.addQuad(BAR_LEFT, HEALTH_BAR_TOP, BAR_WIDTH, BAR_HEIGHT, BAR_BACKGROUND);
+    healthFill = widgets.addQuad(BAR_LEFT, HEALTH_BAR_TOP, BAR_WIDTH, BAR_HEIGHT, HEALTH_COLOUR);
+
+    widgets.addQuad(BAR_LEFT, ENERGY_BAR_TOP, BAR_WIDTH, BAR_HEIGHT, BAR_BACKGROUND);
+    energyFill = widgets.addQuad(BAR_LEFT, ENERGY_BAR_TOP, BAR_WIDTH, BAR_HEIGHT, ENERGY_COLOUR);
 }
 
-void HUD::updateHealthBar(float currentHealth, float maxHealth) {
-    if (!healthFill) return;
-    
-    float percentage = currentHealth / maxHealth;
+void HUD::setFill(size_t fill, float top, float current, float maximum) {
+    if (widgets.size() <= fill) return;
+
+    float percentage = maximum > 0.0f ? current / maximum : 0.0f;
     percentage = std::max(0.0f, std::min(1.0f, percentage)); // Limiter entre 0 et 1
-    healthFill->setWidth(500 * percentage); // 500 est la largeur totale de la barre
+    // Largeur arrondie au pixel par le batch : inchangée, elle ne coûte rien
+    widgets.setRect(fill, BAR_LEFT, top, BAR_WIDTH * percentage, BAR_HEIGHT);
+}
+
+void HUD::updateHealthBar(float currentHealth, float maxHealth) {
+    setFill(healthFill, HEALTH_BAR_TOP, currentHealth, maxHealth);
 }
 
 void HUD::updateEnergyBar(float currentEnergy, float maxEnergy) {
-    if (!energyFill) return;
-    
-    float percentage = currentEnergy / maxEnergy;
-    percentage = std::max(0.0f, std::min(1.0f, percentage)); // Limiter entre 0 et 1
-    energyFill->setWidth(500 * percentage); // 500 est la largeur totale de la barre
+    setFill(energyFill, ENERGY_BAR_TOP, currentEnergy, maxEnergy);
+}
+
+void HUD::update() {
+    PROFILE_SCOPE("Overlay");
+    widgets.flush();
 }
 
 void HUD::show() {
-    if (hudOverlay) hudOverlay->show();
+    widgets.setVisible(true);
 }
 
 void HUD::hide() {
-    if (hudOverlay) hudOverlay->hide();
-} 
\ No newline at end of file
+    widgets.setVisible(false);
+}
@@ -0,0 +1,70 @@
+#include "../include/HeadlessOgre.hpp"
+#include <OgreConfigFile.h>
+#include <OgreFileSystemLayer.h>
+#include <OgreOverlaySystem.h>
+#include <iostream>
+
+HeadlessOgre::HeadlessOgre()
+    : root(nullptr)
+    , overlaySystem(nullptr)
+    , scnMgr(nullptr)
+{
+}
+
+HeadlessOgre::~HeadlessOgre()
+{
+    delete overlaySystem;
+    delete root;
+}
+
+bool HeadlessOgre::initialize(const std::string& logName)
+{
+    try {
+        // Same configuration files as the game, found the same way as ApplicationContext does
+        Ogre::FileSystemLayer fsLayer("Zforest");
+        root = new Ogre::Root(fsLayer.getConfigFilePath("plugins.cfg"), "", fsLayer.getWritablePath(logName));
+        Ogre::LogManager::getSingleton().getDefaultLog()->setDebugOutputEnabled(false);
+
+        // Tiny renders in memory: no display needed, and nothing is ever rendered anyway
+        Ogre::RenderSystem* renderSystem = root->getRenderSystemByName("Tiny Rendering Subsystem");
+        if (!renderSystem) {
+            std::cerr << "Error: the Tiny render system plugin is required for headless runs" << std::endl;
+            return false;
+        }
+        root->setRenderSystem(renderSystem);
+        root->initialise(false);
+        root->createRenderWindow("ForestZ headless", 1, 1, false);
+
+        // The minimap creates overlays
+        overlaySystem = new Ogre::OverlaySystem();
+        scnMgr = root->createSceneManager();
+        scnMgr->addRenderQueueListener(overlaySystem);
+
+        locateResources(fsLayer.getConfigFilePath("resources.cfg"));
+        Ogre::ResourceGroupManager::getSingleton().initialiseAllResourceGroups();
+    } catch (const Ogre::Exception& e) {
+        std::cerr << "Error starting Ogre headless: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void HeadlessOgre::clearScene()
+{
+    if (scnMgr) {
+        scnMgr->clearScene();
+    }
+}
+
+void HeadlessOgre::locateResources(const Ogre::String& resourcesPath)
+{
+    Ogre::ConfigFile configFile;
+    configFile.load(resourcesPath);
+
+    Ogre::ResourceGroupManager& resourceManager = Ogre::ResourceGroupManager::getSingleton();
+    for (const auto& section : configFile.getSettingsBySection()) {
+        for (const auto& location : section.second) {
+            resourceManager.addResourceLocation(location.second, location.first, section.first);
+        }
+    }
+}
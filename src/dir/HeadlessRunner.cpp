@@ -0,0 +1,565 @@
+#include "../include/HeadlessRunner.hpp"
+#include "../include/SimulationClock.hpp"
+#include "../include/GameRandom.hpp"
+#include "../include/Profiler.hpp"
+#include "../include/MemoryReport.hpp"
+#include "../include/FrameArena.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace {
+    const float AUTO_FIRE_INTERVAL = 0.25f; // Cadence de tir du pilote automatique
+    const unsigned CHECKSUM_INTERVAL = 60;  // Ticks entre deux sommes de contrôle enregistrées
+
+    // FNV-1a 64 bits
+    void hashBytes(uint64_t& hash, const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    }
+}
+
+HeadlessRunner::HeadlessRunner()
+    : scnMgr(nullptr)
+    , physicsManager(nullptr)
+    , contactEvents(nullptr)
+    , planeZ(nullptr)
+    , object(nullptr)
+    , player(nullptr)
+    , zombies(nullptr)
+    , jobSystem(nullptr)
+    , entityStore(nullptr)
+    , nextInput(0)
+    , moveDirection(Ogre::Vector3::ZERO)
+    , autoFire(true)
+    , fireCooldown(0.0f)
+    , currentLevel(0)
+    , simulatedTime(0.0f)
+    , tickCount(0)
+    , recording(false)
+    , recordedMove(Ogre::Vector3::ZERO)
+    , replaying(false)
+    , replayInputIndex(0)
+    , replayChecksumIndex(0)
+    , levelStartCount(0)
+    , replayEndTick(0)
+    , divergentTick(-1)
+{
+}
+
+HeadlessRunner::~HeadlessRunner()
+{
+    // Game objects delete their bodies but leave them in the world
+    if (physicsManager) {
+        physicsManager->removeAllCollisionObjects();
+    }
+    delete zombies;
+    delete player;
+    delete object;
+    delete entityStore;
+    delete planeZ;
+    delete contactEvents;
+    delete physicsManager;
+    delete jobSystem;
+
+    SimulationClock::setManual(false);
+}
+
+bool HeadlessRunner::initialize(const HeadlessSettings& headlessSettings)
+{
+    settings = headlessSettings;
+
+    if (!settings.replayPath.empty()) {
+        if (!loadReplay(settings.replayPath)) return false;
+    } else if (!settings.scriptPath.empty()) {
+        if (!loadScript(settings.scriptPath, script)) return false;
+        autoFire = false;
+    }
+
+    if (!settings.checksumPath.empty()) {
+        checksumFile.open(settings.checksumPath);
+        if (!checksumFile) {
+            std::cerr << "Error: cannot write checksums to " << settings.checksumPath << std::endl;
+            return false;
+        }
+    }
+
+    if (!ogre.initialize("ForestZ_headless.log")) return false;
+    scnMgr = ogre.getSceneManager();
+    jobSystem = new JobSystem(settings.jobThreads);
+    if (replaying && jobSystem->getThreadCount() != settings.jobThreads) {
+        std::cerr << "Error: the replay needs " << settings.jobThreads << " job threads, got "
+                  << jobSystem->getThreadCount() << std::endl;
+        return false;
+    }
+
+    // Cooldowns follow the simulated time, not the wall clock
+    SimulationClock::setManual(true);
+
+    // The forest and the spawns only depend on the seed
+    GameRandom::seed(settings.seed);
+    if (!settings.recordPath.empty()) {
+        InputLogHeader header;
+        header.seed = GameRandom::getSeed();
+        header.tickInterval = PHYSICS_FIXED_TIMESTEP;
+        header.levels = settings.levels;
+        header.zombiesPerLevel = settings.zombiesPerLevel;
+        header.spawnRadius = settings.spawnRadius;
+        header.broadphase = static_cast<uint8_t>(settings.physics.broadphase);
+        header.physicsThreads = settings.physics.threadCount;
+        header.jobThreads = static_cast<int32_t>(jobSystem->getThreadCount());
+        if (!recorder.openForWrite(settings.recordPath, header)) return false;
+        recording = true;
+    }
+
+    physicsManager = new PhysicsManager();
+    physicsManager->initialize(settings.physics);
+
+    contactEvents = new ContactEvents();
+    physicsManager->setTickCallback([this](float) {
+        contactEvents->dispatch(physicsManager->getDynamicsWorld(), player, zombies);
+    });
+
+    btDiscreteDynamicsWorld* dynamicsWorld = physicsManager->getDynamicsWorld();
+
+    planeZ = new PlaneZ();
+    planeZ->createPlane(scnMgr, dynamicsWorld);
+
+    entityStore = new EntityStore();
+    object = new Object(entityStore);
+    object->createObject(scnMgr, dynamicsWorld);
+
+    player = new Player();
+    player->createPlayer(scnMgr, Ogre::Vector3::ZERO, dynamicsWorld);
+    if (!player->playerBody || !player->playerNode) {
+        std::cerr << "Error: failed to create the player" << std::endl;
+        return false;
+    }
+
+    zombies = new Zombies(entityStore);
+    startLevel(1);
+    return true;
+}
+
+bool HeadlessRunner::loadReplay(const std::string& path)
+{
+    InputLog log;
+    if (!log.load(path)) return false;
+
+    const InputLogHeader& header = log.getHeader();
+    if (header.tickInterval != PHYSICS_FIXED_TIMESTEP) {
+        std::cerr << "Error: " << path << " was recorded at a tick of " << header.tickInterval
+                  << "s, this build ticks at " << PHYSICS_FIXED_TIMESTEP << "s" << std::endl;
+        return false;
+    }
+
+    // The session is entirely described by the log
+    settings.seed = header.seed;
+    settings.levels = header.levels;
+    settings.zombiesPerLevel = header.zombiesPerLevel;
+    settings.spawnRadius = header.spawnRadius;
+    settings.physics.broadphase = static_cast<BroadphaseType>(header.broadphase);
+    settings.physics.threadCount = header.physicsThreads;
+    if (header.physicsThreads != 1) {
+        std::cerr << "Warning: multithreaded physics is not deterministic, checksums may differ" << std::endl;
+    }
+    if (header.jobThreads < 1) {
+        std::cerr << "Error: " << path << " records " << header.jobThreads << " job threads" << std::endl;
+        return false;
+    }
+    if (settings.jobThreads != static_cast<unsigned int>(header.jobThreads)) {
+        std::cerr << "Replay: using the " << header.jobThreads << " job threads of the recording instead of "
+                  << settings.jobThreads << std::endl;
+    }
+    settings.jobThreads = static_cast<unsigned int>(header.jobThreads);
+
+    bool ended = false;
+    for (const InputEvent& event : log.getEvents()) {
+        switch (event.type) {
+            case InputEvent::Type::Move:
+            case InputEvent::Type::Shoot:
+                replayInputs.push_back(event);
+                break;
+            case InputEvent::Type::LevelStart:
+                replayLevelStarts.push_back(event);
+                break;
+            case InputEvent::Type::Checksum:
+                replayChecksums.push_back(event);
+                break;
+            case InputEvent::Type::End:
+                replayEndTick = event.tick;
+                ended = true;
+                break;
+        }
+    }
+    if (!ended) {
+        std::cerr << "Error: " << path << " has no end marker (interrupted recording?)" << std::endl;
+        return false;
+    }
+
+    autoFire = false;
+    replaying = true;
+    return true;
+}
+
+bool HeadlessRunner::loadScript(const std::string& path, std::vector<ScriptedInput>& inputs)
+{
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Error: cannot open script " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream stream(line);
+        ScriptedInput input;
+        std::string command;
+        input.value = Ogre::Vector3::ZERO;
+        if (!(stream >> input.time >> command)) {
+            std::cerr << "Error: " << path << ":" << lineNumber << ": expected '<time> <command>'" << std::endl;
+            return false;
+        }
+
+        if (command == "move") {
+            input.command = ScriptedInput::Command::Move;
+            stream >> input.value.x >> input.value.y >> input.value.z;
+        } else if (command == "shoot") {
+            input.command = ScriptedInput::Command::Shoot;
+            stream >> input.value.x >> input.value.y >> input.value.z;
+        } else if (command == "autofire") {
+            input.command = ScriptedInput::Command::AutoFire;
+            stream >> input.value.x;
+        } else {
+            std::cerr << "Error: " << path << ":" << lineNumber << ": unknown command '" << command << "'" << std::endl;
+            return false;
+        }
+        inputs.push_back(input);
+    }
+
+    std::stable_sort(inputs.begin(), inputs.end(),
+                     [](const ScriptedInput& lhs, const ScriptedInput& rhs) { return lhs.time < rhs.time; });
+    return true;
+}
+
+void HeadlessRunner::startLevel(int level)
+{
+    currentLevel = level;
+
+    // Les niveaux découlent de la simulation : au rejeu ils ne servent que de vérification
+    if (recording) {
+        InputEvent event;
+        event.tick = static_cast<uint32_t>(tickCount);
+        event.type = InputEvent::Type::LevelStart;
+        event.value = static_cast<uint64_t>(level);
+        recorder.write(event);
+    }
+    if (replaying) {
+        bool expected = levelStartCount < replayLevelStarts.size() &&
+                        replayLevelStarts[levelStartCount].tick == tickCount &&
+                        replayLevelStarts[levelStartCount].value == static_cast<uint64_t>(level);
+        if (!expected && divergentTick < 0) {
+            std::cerr << "Replay diverged: level " << level << " started at tick " << tickCount
+                      << ", not as recorded" << std::endl;
+            divergentTick = static_cast<long>(tickCount);
+        }
+        ++levelStartCount;
+    }
+    zombies->setHealthMultiplier(1.0f + 0.2f * (level - 1));
+    zombies->setSpeedMultiplier(1.0f + 0.1f * (level - 1));
+    zombies->createZombies(scnMgr, settings.zombiesPerLevel * level, settings.spawnRadius,
+                           physicsManager->getDynamicsWorld());
+
+    std::cout << "[" << simulatedTime << "s] Level " << level << ": "
+              << countAliveZombies() << " zombies" << std::endl;
+}
+
+void HeadlessRunner::applyScript()
+{
+    while (nextInput < script.size() && script[nextInput].time <= simulatedTime) {
+        const ScriptedInput& input = script[nextInput++];
+        switch (input.command) {
+            case ScriptedInput::Command::Move:
+                moveDirection = input.value;
+                moveDirection.y = 0;
+                if (moveDirection != Ogre::Vector3::ZERO) moveDirection.normalise();
+                break;
+            case ScriptedInput::Command::Shoot:
+                if (input.value != Ogre::Vector3::ZERO) {
+                    pendingShots.push_back(input.value);
+                }
+                break;
+            case ScriptedInput::Command::AutoFire:
+                autoFire = input.value.x != 0.0f;
+                break;
+        }
+    }
+}
+
+void HeadlessRunner::applyReplay()
+{
+    while (replayInputIndex < replayInputs.size() && replayInputs[replayInputIndex].tick <= tickCount) {
+        const InputEvent& event = replayInputs[replayInputIndex++];
+        if (event.type == InputEvent::Type::Move) {
+            moveDirection = Ogre::Vector3(event.x, 0, event.z);
+        } else {
+            pendingShots.push_back(Ogre::Vector3(event.x, event.y, event.z));
+        }
+    }
+}
+
+void HeadlessRunner::recordInputs()
+{
+    InputEvent event;
+    event.tick = static_cast<uint32_t>(tickCount);
+
+    // Le déplacement n'est enregistré que lorsqu'il change
+    if (moveDirection != recordedMove) {
+        event.type = InputEvent::Type::Move;
+        event.x = moveDirection.x;
+        event.z = moveDirection.z;
+        recorder.write(event);
+        recordedMove = moveDirection;
+    }
+
+    // Shots are logged after aiming so a replay never depends on the autopilot
+    for (const Ogre::Vector3& shot : pendingShots) {
+        event.type = InputEvent::Type::Shoot;
+        event.x = shot.x;
+        event.y = shot.y;
+        event.z = shot.z;
+        recorder.write(event);
+    }
+}
+
+void HeadlessRunner::tick(float deltaTime)
+{
+    PROFILE_SCOPE("SimTick");
+    FrameArena::get().reset();
+    btDiscreteDynamicsWorld* dynamicsWorld = physicsManager->getDynamicsWorld();
+
+    if (replaying) {
+        applyReplay();
+    } else {
+        applyScript();
+
+        fireCooldown -= deltaTime;
+        Ogre::Vector3 aim;
+        if (autoFire && fireCooldown <= 0.0f && findNearestZombie(aim)) {
+            pendingShots.push_back(aim);
+            fireCooldown = AUTO_FIRE_INTERVAL;
+        }
+    }
+    if (recording) {
+        recordInputs();
+    }
+
+    // Même déplacement que le clavier : vitesse horizontale imposée, gravité conservée
+    btVector3 velocity = player->playerBody->getLinearVelocity();
+    velocity.setX(moveDirection.x * PLAYER_SPEED);
+    velocity.setZ(moveDirection.z * PLAYER_SPEED);
+    player->playerBody->setLinearVelocity(velocity);
+    if (moveDirection != Ogre::Vector3::ZERO) player->playerBody->activate(true);
+
+    for (const Ogre::Vector3& shot : pendingShots) {
+        player->shoot(scnMgr, dynamicsWorld, shot);
+    }
+    pendingShots.clear();
+
+    zombies->steerZombies(getPlayerPosition(), jobSystem);
+    physicsManager->stepSimulation(deltaTime);
+    player->updateBulletPositions(dynamicsWorld);
+    player->updateHealth(deltaTime);
+
+    SimulationClock::advance(deltaTime);
+    simulatedTime += deltaTime;
+    ++tickCount;
+
+    checkTick();
+}
+
+void HeadlessRunner::checkTick()
+{
+    bool recordChecksum = recording && tickCount % CHECKSUM_INTERVAL == 0;
+    bool verifyChecksum = replaying && replayChecksumIndex < replayChecksums.size() &&
+                          replayChecksums[replayChecksumIndex].tick == tickCount;
+    if (!recordChecksum && !verifyChecksum && !checksumFile.is_open()) return;
+
+    uint64_t checksum = computeChecksum();
+
+    if (checksumFile.is_open()) {
+        checksumFile << tickCount << " " << std::hex << checksum << std::dec << "\n";
+    }
+
+    if (recordChecksum) {
+        InputEvent event;
+        event.tick = static_cast<uint32_t>(tickCount);
+        event.type = InputEvent::Type::Checksum;
+        event.value = checksum;
+        recorder.write(event);
+    }
+
+    if (verifyChecksum) {
+        uint64_t expected = replayChecksums[replayChecksumIndex++].value;
+        if (checksum != expected && divergentTick < 0) {
+            std::cerr << "Replay diverged at tick " << tickCount << ": checksum " << std::hex << checksum
+                      << ", recorded " << expected << std::dec << std::endl;
+            divergentTick = static_cast<long>(tickCount);
+        }
+    }
+}
+
+uint64_t HeadlessRunner::computeChecksum() const
+{
+    uint64_t hash = 14695981039346656037ull;
+    hashBytes(hash, &tickCount, sizeof(tickCount));
+
+    // Every body, in world order: position, rotation and velocity, bit for bit
+    const btCollisionObjectArray& objects = physicsManager->getDynamicsWorld()->getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); ++i) {
+        const btTransform& transform = objects[i]->getWorldTransform();
+        btQuaternion rotation = transform.getRotation();
+        // Only x, y, z: the fourth component of a btVector3 is padding
+        hashBytes(hash, transform.getOrigin().m_floats, 3 * sizeof(btScalar));
+        hashBytes(hash, &rotation, sizeof(btQuaternion));
+
+        const btRigidBody* body = btRigidBody::upcast(objects[i]);
+        if (body) {
+            hashBytes(hash, body->getLinearVelocity().m_floats, 3 * sizeof(btScalar));
+        }
+    }
+
+    float health = player->getHealth();
+    hashBytes(hash, &health, sizeof(health));
+    return hash;
+}
+
+int HeadlessRunner::run()
+{
+    if (!player || !zombies) return 1;
+
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    const float deltaTime = PHYSICS_FIXED_TIMESTEP;
+    double maxTickMs = 0.0;
+    uint64_t tickAllocations = 0;      // Heap allocations made inside tick()
+    unsigned long allocationFreeTicks = 0;
+
+    if (!settings.tracePath.empty()) {
+        Profiler::startCapture();
+    }
+
+    bool cleared = false;
+    while ((replaying ? tickCount < replayEndTick : simulatedTime < settings.duration) && player->isAlive()) {
+        const auto tickStart = Clock::now();
+        const uint64_t allocationsBefore = AllocationCounter::getTotals().count;
+        tick(deltaTime);
+        const uint64_t allocations = AllocationCounter::getTotals().count - allocationsBefore;
+        tickAllocations += allocations;
+        if (allocations == 0) ++allocationFreeTicks;
+
+        if (countAliveZombies() == 0) {
+            std::cout << "[" << simulatedTime << "s] Level " << currentLevel << " cleared" << std::endl;
+            if (currentLevel >= settings.levels) {
+                cleared = true;
+            } else {
+                startLevel(currentLevel + 1);
+            }
+        }
+        maxTickMs = std::max(maxTickMs, std::chrono::duration<double, std::milli>(Clock::now() - tickStart).count());
+        if (Profiler::isEnabled()) {
+            Profiler::collect();
+        }
+        if (cleared) break;
+    }
+
+    if (Profiler::isCapturing()) {
+        Profiler::stopCapture(settings.tracePath);
+        for (const ProfileScopeStats& stats : Profiler::getStats()) {
+            std::cout << "  " << stats.name << ": " << stats.averageMs << "ms avg, " << stats.p99Ms << "ms p99, "
+                      << stats.maxMs << "ms max" << std::endl;
+        }
+    }
+
+    if (recording) {
+        InputEvent event;
+        event.tick = static_cast<uint32_t>(tickCount);
+        event.type = InputEvent::Type::End;
+        recorder.write(event);
+        recorder.close();
+        std::cout << "Recorded " << tickCount << " ticks (seed " << GameRandom::getSeed() << ") to "
+                  << settings.recordPath << std::endl;
+    }
+
+    const double wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout << "Headless run: " << tickCount << " ticks, " << simulatedTime << "s simulated in "
+              << wallSeconds << "s (x" << (wallSeconds > 0.0 ? simulatedTime / wallSeconds : 0.0) << ")"
+              << ", tick " << (tickCount ? wallSeconds * 1000.0 / tickCount : 0.0) << "ms avg / "
+              << maxTickMs << "ms max"
+              << ", level " << currentLevel << (cleared ? " cleared" : "")
+              << ", player health " << player->getHealth()
+              << ", zombies alive " << countAliveZombies() << std::endl;
+
+#ifdef FORESTZ_ALLOC_TRACKING
+    std::cout << "Heap allocations: " << (tickCount ? static_cast<double>(tickAllocations) / tickCount : 0.0)
+              << " per tick, " << allocationFreeTicks << "/" << tickCount << " ticks allocation-free"
+              << ", frame arena peak " << FrameArena::get().getPeak() / 1024 << " KB" << std::endl;
+#endif
+    MemoryReport memoryReport;
+    memoryReport.collect(scnMgr);
+    memoryReport.print(std::cout);
+
+    if (replaying) {
+        bool complete = tickCount == replayEndTick;
+        if (divergentTick < 0 && !complete) {
+            std::cerr << "Replay diverged: stopped at tick " << tickCount << ", recorded " << replayEndTick << std::endl;
+            divergentTick = static_cast<long>(tickCount);
+        }
+        if (divergentTick >= 0) return 3;
+        std::cout << "Replay matched " << replayChecksums.size() << " recorded checksums" << std::endl;
+    }
+
+    // Dead player: non-zero exit code for soak tests and CI
+    return player->isAlive() ? 0 : 2;
+}
+
+size_t HeadlessRunner::countAliveZombies() const
+{
+    // Les zombies morts n'ont plus d'entité
+    return entityStore->count<Zombie>();
+}
+
+bool HeadlessRunner::findNearestZombie(Ogre::Vector3& direction) const
+{
+    const Ogre::Vector3 shooter = getPlayerPosition() + Ogre::Vector3(0, 50, 0); // Hauteur de tir de Player::shoot
+
+    // Position des corps après le pas de physique (Transform date du pilotage, avant le pas)
+    float nearestDistance = std::numeric_limits<float>::max();
+    bool found = false;
+    entityStore->each<Zombie, RigidBodyRef>([&](EntityId, Zombie&, RigidBodyRef& bodyRef) {
+        if (!bodyRef.body) return;
+        const btVector3& origin = bodyRef.body->getWorldTransform().getOrigin();
+        Ogre::Vector3 toZombie = Ogre::Vector3(origin.x(), origin.y(), origin.z()) - shooter;
+        float distance = toZombie.squaredLength();
+        if (distance < nearestDistance) {
+            nearestDistance = distance;
+            direction = toZombie;
+            found = true;
+        }
+    });
+    return found;
+}
+
+Ogre::Vector3 HeadlessRunner::getPlayerPosition() const
+{
+    return player->playerNode->getPosition();
+}
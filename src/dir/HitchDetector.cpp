@@ -0,0 +1,100 @@
+#include "../include/HitchDetector.hpp"
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+HitchDetector::HitchDetector(const HitchSettings& settings)
+    : settings(settings)
+    , frames(static_cast<size_t>(std::max(1.0f, std::ceil(settings.historySeconds * MAX_SAMPLED_FPS))))
+    , firstFrame(0)
+    , frameCount(0)
+    , lastTotals(AllocationCounter::getTotals())
+    , lastCaptureTime(0)
+    , hasCaptured(false)
+    , captureCount(0)
+{
+    Profiler::acquire();
+    Profiler::setHistoryDuration(settings.historySeconds);
+}
+
+HitchDetector::~HitchDetector()
+{
+    Profiler::setHistoryDuration(0.0f);
+    Profiler::release();
+}
+
+bool HitchDetector::update(float frameSeconds)
+{
+    const uint64_t now = Profiler::now();
+    const AllocationTotals totals = AllocationCounter::getTotals();
+
+    FrameSample sample;
+    sample.end = now;
+    sample.milliseconds = frameSeconds * 1000.0f;
+    sample.allocations = totals.count - lastTotals.count;
+    sample.allocatedBytes = totals.bytes - lastTotals.bytes;
+    lastTotals = totals;
+
+    // Full: overwrite the oldest sample
+    frames[(firstFrame + frameCount) % frames.size()] = sample;
+    if (frameCount < frames.size()) {
+        ++frameCount;
+    } else {
+        firstFrame = (firstFrame + 1) % frames.size();
+    }
+    const uint64_t historyDuration = static_cast<uint64_t>(settings.historySeconds * 1.0e9);
+    while (frameCount > 0 && frames[firstFrame].end + historyDuration < now) {
+        firstFrame = (firstFrame + 1) % frames.size();
+        --frameCount;
+    }
+
+    if (sample.milliseconds < settings.thresholdMs) return false;
+
+    const uint64_t cooldown = static_cast<uint64_t>(settings.cooldownSeconds * 1.0e9);
+    if (hasCaptured && now - lastCaptureTime < cooldown) return false;
+
+    hasCaptured = true;
+    lastCaptureTime = now;
+    return writeCapture(sample);
+}
+
+bool HitchDetector::writeCapture(const FrameSample& hitch)
+{
+    MemoryScope memoryScope(MemoryTag::Profiler);
+    // A counter sample holds its value until the next one: emit each frame at its start
+    std::vector<ProfileCounterSample> counters;
+    counters.reserve(frameCount * 3);
+    for (size_t i = 0; i < frameCount; ++i) {
+        const FrameSample& frame = frames[(firstFrame + i) % frames.size()];
+        const uint64_t duration = static_cast<uint64_t>(frame.milliseconds * 1.0e6);
+        const uint64_t start = frame.end > duration ? frame.end - duration : 0;
+        counters.push_back({"Frame ms", start, frame.milliseconds});
+        counters.push_back({"Allocations", start, static_cast<double>(frame.allocations)});
+        counters.push_back({"Allocated KB", start, frame.allocatedBytes / 1024.0});
+    }
+
+    const std::string path = makeCapturePath(hitch.milliseconds);
+    const std::vector<ProfileEvent> events = Profiler::getHistory();
+    if (!Profiler::writeTrace(path, events, counters)) {
+        return false;
+    }
+
+    ++captureCount;
+    std::cout << "Hitch: " << hitch.milliseconds << "ms frame, " << hitch.allocations << " allocations, "
+              << events.size() << " events written to " << path << std::endl;
+    return true;
+}
+
+std::string HitchDetector::makeCapturePath(float milliseconds) const
+{
+    std::time_t now = std::time(nullptr);
+    std::tm local = *std::localtime(&now);
+
+    std::ostringstream path;
+    path << settings.directory << "/hitch_" << std::put_time(&local, "%Y%m%d_%H%M%S")
+         << "_" << static_cast<int>(milliseconds) << "ms.json";
+    return path.str();
+}
@@ -0,0 +1,204 @@
+#include "../include/InputLog.hpp"
+#include <cstring>
+#include <iostream>
+
+namespace {
+    const char MAGIC[4] = {'F', 'Z', 'I', 'L'};
+
+    uint32_t floatBits(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    bool readFixed(std::istream& input, uint64_t& value, int bytes) {
+        value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            int byte = input.get();
+            if (byte == EOF) return false;
+            value |= static_cast<uint64_t>(byte) << (8 * i);
+        }
+        return true;
+    }
+}
+
+bool InputLog::openForWrite(const std::string& path, const InputLogHeader& logHeader)
+{
+    output.open(path, std::ios::binary | std::ios::trunc);
+    if (!output) {
+        std::cerr << "Error: cannot write input log " << path << std::endl;
+        return false;
+    }
+
+    header = logHeader;
+    lastTick = 0;
+
+    writeBytes(MAGIC, sizeof(MAGIC));
+    writeBytes(&VERSION, 1);
+    writeVarint(header.seed);
+    writeFloat(header.tickInterval);
+    writeVarint(static_cast<uint32_t>(header.levels));
+    writeVarint(static_cast<uint32_t>(header.zombiesPerLevel));
+    writeFloat(header.spawnRadius);
+    writeBytes(&header.broadphase, 1);
+    writeVarint(static_cast<uint32_t>(header.physicsThreads));
+    writeVarint(static_cast<uint32_t>(header.jobThreads));
+    return true;
+}
+
+void InputLog::write(const InputEvent& event)
+{
+    if (!output.is_open()) return;
+
+    writeVarint(event.tick - lastTick);
+    lastTick = event.tick;
+    writeBytes(&event.type, 1);
+
+    switch (event.type) {
+        case InputEvent::Type::Move:
+            writeFloat(event.x);
+            writeFloat(event.z);
+            break;
+        case InputEvent::Type::Shoot:
+            writeFloat(event.x);
+            writeFloat(event.y);
+            writeFloat(event.z);
+            break;
+        case InputEvent::Type::LevelStart:
+            writeVarint(event.value);
+            break;
+        case InputEvent::Type::Checksum:
+            for (int i = 0; i < 8; ++i) {
+                uint8_t byte = static_cast<uint8_t>(event.value >> (8 * i));
+                writeBytes(&byte, 1);
+            }
+            break;
+        case InputEvent::Type::End:
+            break;
+    }
+}
+
+void InputLog::close()
+{
+    if (output.is_open()) {
+        output.close();
+    }
+}
+
+bool InputLog::load(const std::string& path)
+{
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        std::cerr << "Error: cannot open input log " << path << std::endl;
+        return false;
+    }
+
+    char magic[4];
+    int version = 0;
+    if (!input.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        (version = input.get()) != VERSION) {
+        std::cerr << "Error: " << path << " is not a ForestZ input log (version " << int(VERSION) << ")" << std::endl;
+        return false;
+    }
+
+    uint64_t seed, levels, zombiesPerLevel, threads, jobThreads;
+    int broadphase;
+    if (!readVarint(input, seed) || !readFloat(input, header.tickInterval) ||
+        !readVarint(input, levels) || !readVarint(input, zombiesPerLevel) ||
+        !readFloat(input, header.spawnRadius) || (broadphase = input.get()) == EOF ||
+        !readVarint(input, threads) || !readVarint(input, jobThreads)) {
+        std::cerr << "Error: truncated header in " << path << std::endl;
+        return false;
+    }
+    header.seed = static_cast<uint32_t>(seed);
+    header.levels = static_cast<int32_t>(levels);
+    header.zombiesPerLevel = static_cast<int32_t>(zombiesPerLevel);
+    header.broadphase = static_cast<uint8_t>(broadphase);
+    header.physicsThreads = static_cast<int32_t>(threads);
+    header.jobThreads = static_cast<int32_t>(jobThreads);
+
+    events.clear();
+    uint32_t tick = 0;
+    uint64_t delta;
+    while (readVarint(input, delta)) {
+        InputEvent event;
+        int type = input.get();
+        bool complete = type != EOF;
+        tick += static_cast<uint32_t>(delta);
+        event.tick = tick;
+        event.type = static_cast<InputEvent::Type>(type);
+
+        switch (event.type) {
+            case InputEvent::Type::Move:
+                complete = complete && readFloat(input, event.x) && readFloat(input, event.z);
+                break;
+            case InputEvent::Type::Shoot:
+                complete = complete && readFloat(input, event.x) && readFloat(input, event.y) && readFloat(input, event.z);
+                break;
+            case InputEvent::Type::LevelStart:
+                complete = complete && readVarint(input, event.value);
+                break;
+            case InputEvent::Type::Checksum:
+                complete = complete && readFixed(input, event.value, 8);
+                break;
+            case InputEvent::Type::End:
+                break;
+            default:
+                std::cerr << "Error: unknown event type " << type << " in " << path << std::endl;
+                return false;
+        }
+
+        if (!complete) {
+            std::cerr << "Error: truncated event at tick " << tick << " in " << path << std::endl;
+            return false;
+        }
+        events.push_back(event);
+    }
+    return true;
+}
+
+void InputLog::writeBytes(const void* data, size_t size)
+{
+    output.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+}
+
+void InputLog::writeVarint(uint64_t value)
+{
+    // LEB128 : 7 bits par octet, bit de poids fort = suite
+    do {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        if (value) byte |= 0x80;
+        writeBytes(&byte, 1);
+    } while (value);
+}
+
+void InputLog::writeFloat(float value)
+{
+    uint32_t bits = floatBits(value);
+    for (int i = 0; i < 4; ++i) {
+        uint8_t byte = static_cast<uint8_t>(bits >> (8 * i));
+        writeBytes(&byte, 1);
+    }
+}
+
+bool InputLog::readVarint(std::istream& input, uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int byte = input.get();
+        if (byte == EOF) return false;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+bool InputLog::readFloat(std::istream& input, float& value)
+{
+    uint64_t bits;
+    if (!readFixed(input, bits, 4)) return false;
+    uint32_t bits32 = static_cast<uint32_t>(bits);
+    std::memcpy(&value, &bits32, sizeof(value));
+    return true;
+}
@@ -0,0 +1,230 @@
+#include "../include/JobSystem.hpp"
+#include <algorithm>
+
+namespace {
+    // Identifies the worker running on this thread, if any
+    thread_local const JobSystem* currentSystem = nullptr;
+    thread_local int currentWorker = -1;
+
+    void runFunction(void* data, size_t, size_t) {
+        std::function<void()>* function = static_cast<std::function<void()>*>(data);
+        (*function)();
+        delete function;
+    }
+}
+
+void JobSystem::JobQueue::pushBack(const Job& job)
+{
+    if (size == ring.size()) {
+        // Unroll the ring into a buffer twice as large
+        std::vector<Job> larger(ring.size() * 2);
+        for (size_t i = 0; i < size; ++i) {
+            larger[i] = ring[(head + i) % ring.size()];
+        }
+        ring.swap(larger);
+        head = 0;
+    }
+    ring[(head + size) % ring.size()] = job;
+    ++size;
+}
+
+bool JobSystem::JobQueue::popBack(Job& job)
+{
+    if (size == 0) return false;
+    --size;
+    job = ring[(head + size) % ring.size()];
+    return true;
+}
+
+bool JobSystem::JobQueue::popFront(Job& job)
+{
+    if (size == 0) return false;
+    job = ring[head];
+    head = (head + 1) % ring.size();
+    --size;
+    return true;
+}
+
+JobSystem::JobSystem(unsigned int threadCount)
+{
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const unsigned int workerCount = threadCount - 1;
+
+    for (unsigned int i = 0; i <= workerCount; ++i) {
+        queues.push_back(std::make_unique<JobQueue>());
+    }
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+int JobSystem::currentQueueIndex() const
+{
+    return currentSystem == this ? currentWorker : static_cast<int>(queues.size()) - 1;
+}
+
+void JobSystem::enqueue(const Job& job)
+{
+    if (job.counter) {
+        job.counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    JobQueue& queue = *queues[currentQueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.pushBack(job);
+    }
+    // Sequentially consistent with the sleeping worker's side: either it sees the job or we see it asleep
+    queuedJobs.fetch_add(1);
+    if (sleepingWorkers.load() > 0) {
+        // Taking the lock orders the wake-up after the worker's last check of queuedJobs
+        { std::lock_guard<std::mutex> lock(sleepMutex); }
+        wakeCondition.notify_one();
+    }
+}
+
+void JobSystem::submit(std::function<void()> job, JobCounter* counter)
+{
+    Job entry;
+    entry.function = runFunction;
+    entry.data = new std::function<void()>(std::move(job));
+    entry.counter = counter;
+    enqueue(entry);
+}
+
+void JobSystem::submitRange(void (*function)(void*, size_t, size_t), void* data, size_t begin, size_t end,
+                            JobCounter* counter)
+{
+    Job entry;
+    entry.function = function;
+    entry.data = data;
+    entry.begin = begin;
+    entry.end = end;
+    entry.counter = counter;
+    enqueue(entry);
+}
+
+bool JobSystem::findJob(Job& job)
+{
+    if (queuedJobs.load(std::memory_order_acquire) <= 0) return false;
+
+    // Own deque first, newest job; then steal the oldest job of the others
+    const int own = currentQueueIndex();
+    {
+        JobQueue& queue = *queues[own];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.popBack(job)) {
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    const size_t count = queues.size();
+    for (size_t offset = 1; offset < count; ++offset) {
+        JobQueue& queue = *queues[(own + offset) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.popFront(job)) {
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::execute(const Job& job)
+{
+    job.function(job.data, job.begin, job.end);
+    if (job.counter) {
+        job.counter->pending.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+    Job job;
+    while (!counter.isDone()) {
+        if (findJob(job)) {
+            execute(job);
+        } else {
+            // The remaining jobs are running elsewhere
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::workerLoop(unsigned int index)
+{
+    currentSystem = this;
+    currentWorker = static_cast<int>(index);
+
+    Job job;
+    while (true) {
+        if (findJob(job)) {
+            execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepingWorkers.fetch_add(1);
+        wakeCondition.wait(lock, [this] { return stopping || queuedJobs.load() > 0; });
+        sleepingWorkers.fetch_sub(1);
+        if (stopping) break;
+    }
+}
+
+JobGraph::TaskId JobGraph::add(std::function<void()> task)
+{
+    tasks.push_back(std::make_unique<Task>());
+    tasks.back()->function = std::move(task);
+    return tasks.size() - 1;
+}
+
+void JobGraph::dependsOn(TaskId task, TaskId dependency)
+{
+    tasks[dependency]->successors.push_back(task);
+    ++tasks[task]->dependencyCount;
+}
+
+void JobGraph::runTask(void* data, size_t taskId, size_t)
+{
+    RunContext* context = static_cast<RunContext*>(data);
+    Task& task = *context->graph->tasks[taskId];
+    task.function();
+
+    // Successors are queued before this job counts as finished: the counter cannot reach zero early
+    for (TaskId successor : task.successors) {
+        if (context->graph->tasks[successor]->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            context->jobs->submitRange(runTask, context, successor, successor + 1, context->counter);
+        }
+    }
+}
+
+void JobGraph::run(JobSystem& jobs)
+{
+    JobCounter counter;
+    context = {this, &jobs, &counter};
+
+    for (const std::unique_ptr<Task>& task : tasks) {
+        task->remaining.store(task->dependencyCount, std::memory_order_relaxed);
+    }
+    for (TaskId id = 0; id < tasks.size(); ++id) {
+        if (tasks[id]->dependencyCount == 0) {
+            jobs.submitRange(runTask, &context, id, id + 1, &counter);
+        }
+    }
+    jobs.wait(counter);
+}
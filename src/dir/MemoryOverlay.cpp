@@ -0,0 +1,90 @@
+#include "../include/MemoryOverlay.hpp"
+#include <iomanip>
+#include <sstream>
+
+MemoryOverlay::MemoryOverlay()
+    : overlay(nullptr)
+    , panel(nullptr)
+    , text(nullptr)
+    , visible(false)
+    , refreshTimer(0.0f)
+{
+}
+
+MemoryOverlay::~MemoryOverlay() {
+    Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
+    if (text) overlayManager.destroyOverlayElement(text);
+    if (panel) overlayManager.destroyOverlayElement(panel);
+    if (overlay) overlayManager.destroy(overlay);
+}
+
+void MemoryOverlay::initialize() {
+    MemoryScope memoryScope(MemoryTag::Interface);
+    try {
+        Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
+        overlay = overlayManager.create("MemoryOverlay");
+
+        panel = static_cast<Ogre::OverlayContainer*>(
+            overlayManager.createOverlayElement("Panel", "MemoryPanel"));
+        panel->setMetricsMode(Ogre::GMM_PIXELS);
+        panel->setPosition(440, 10);
+        panel->setDimensions(420, 220);
+        panel->setMaterialName("Core/StatsBlockCenter");
+
+        text = static_cast<Ogre::TextAreaOverlayElement*>(
+            overlayManager.createOverlayElement("TextArea", "MemoryText"));
+        text->setMetricsMode(Ogre::GMM_PIXELS);
+        text->setPosition(8, 8);
+        text->setCharHeight(16);
+        text->setFontName("SdkTrays/Value");
+        text->setColour(Ogre::ColourValue(0.9f, 0.9f, 1.0f, 1.0f));
+
+        panel->addChild(text);
+        overlay->add2D(panel);
+        overlay->setZOrder(400);
+        overlay->hide();
+    } catch (const Ogre::Exception& e) {
+        std::cerr << "Failed to initialize memory overlay: " << e.what() << std::endl;
+    }
+}
+
+void MemoryOverlay::toggle() {
+    visible = !visible;
+    if (!overlay) return;
+
+    if (visible) {
+        refreshTimer = 0.0f;
+        overlay->show();
+    } else {
+        overlay->hide();
+    }
+}
+
+void MemoryOverlay::update(float deltaTime, Ogre::SceneManager* scnMgr) {
+    if (!visible || !text) return;
+    refreshTimer -= deltaTime;
+    if (refreshTimer > 0.0f) return;
+    refreshTimer = REFRESH_INTERVAL;
+
+    report.collect(scnMgr);
+
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(1);
+#ifdef FORESTZ_ALLOC_TRACKING
+    stream << std::left << std::setw(11) << "Subsystem" << std::right
+           << std::setw(10) << "KB" << std::setw(9) << "blocks" << "\n";
+    for (int i = 0; i < MemoryReport::TAG_COUNT; ++i) {
+        const MemoryTag tag = static_cast<MemoryTag>(i);
+        const MemoryTagStats& stats = report.getTagStats(tag);
+        stream << std::left << std::setw(11) << AllocationCounter::getTagName(tag) << std::right
+               << std::setw(10) << stats.liveBytes / 1024.0 << std::setw(9) << stats.liveCount << "\n";
+    }
+#else
+    // Sans FORESTZ_ALLOC_TRACKING les compteurs par sous-système restent à 0
+    stream << "Heap per subsystem: tracking off\n";
+#endif
+    stream << "\nEntities " << report.getEntityCount() << "   nodes " << report.getSceneNodeCount()
+           << "\nMaterials " << report.getMaterialCount() << "   meshes " << report.getMeshCount()
+           << "   textures " << report.getTextureCount();
+    text->setCaption(stream.str());
+}
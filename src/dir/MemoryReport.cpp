@@ -0,0 +1,63 @@
+#include "../include/MemoryReport.hpp"
+#include <Ogre.h>
+#include <iomanip>
+
+namespace {
+    size_t countResources(Ogre::ResourceManager& manager) {
+        size_t count = 0;
+        Ogre::ResourceManager::ResourceMapIterator it = manager.getResourceIterator();
+        while (it.hasMoreElements()) {
+            it.moveNext();
+            ++count;
+        }
+        return count;
+    }
+}
+
+void MemoryReport::collect(Ogre::SceneManager* scnMgr) {
+    for (int i = 0; i < TAG_COUNT; ++i) {
+        tags[i] = AllocationCounter::getStats(static_cast<MemoryTag>(i));
+    }
+
+    entities = 0;
+    sceneNodes = 0;
+    if (scnMgr) {
+        entities = scnMgr->getMovableObjects("Entity").size();
+        sceneNodes = scnMgr->getSceneNodes().size();
+    }
+
+    materials = 0;
+    meshes = 0;
+    textures = 0;
+    if (Ogre::Root::getSingletonPtr()) {
+        materials = countResources(Ogre::MaterialManager::getSingleton());
+        meshes = countResources(Ogre::MeshManager::getSingleton());
+        textures = countResources(Ogre::TextureManager::getSingleton());
+    }
+}
+
+int64_t MemoryReport::getTotalLiveBytes() const {
+    int64_t total = 0;
+    for (int i = 0; i < TAG_COUNT; ++i) {
+        total += tags[i].liveBytes;
+    }
+    return total;
+}
+
+void MemoryReport::print(std::ostream& out) const {
+#ifdef FORESTZ_ALLOC_TRACKING
+    out << "=== Memory: " << std::fixed << std::setprecision(1) << getTotalLiveBytes() / (1024.0 * 1024.0)
+        << " MB live ===" << std::endl;
+    for (int i = 0; i < TAG_COUNT; ++i) {
+        out << std::setw(10) << std::left << AllocationCounter::getTagName(static_cast<MemoryTag>(i)) << std::right
+            << std::setw(10) << tags[i].liveBytes / 1024.0 << " KB"
+            << " blocks: " << std::setw(8) << tags[i].liveCount
+            << " allocations: " << std::setw(10) << tags[i].totalCount << std::endl;
+    }
+#else
+    out << "=== Memory: heap tracking off (FORESTZ_ALLOC_TRACKING) ===" << std::endl;
+#endif
+    out << "Entities: " << entities << "  scene nodes: " << sceneNodes << "  materials: " << materials
+        << "  meshes: " << meshes << "  textures: " << textures << std::endl;
+    out << std::defaultfloat;
+}
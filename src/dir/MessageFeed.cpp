@@ -0,0 +1,165 @@
+#include "../include/MessageFeed.hpp"
+#include "../include/Profiler.hpp"
+#include "../include/AllocationCounter.hpp"
+#include <cstdio>
+#include <iostream>
+
+MessageFeed::MessageFeed()
+    : overlay(nullptr)
+    , container(nullptr)
+    , nextSequence(0)
+{
+}
+
+MessageFeed::~MessageFeed() {
+    Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
+    for (Slot& slot : feed) {
+        if (slot.element) overlayManager.destroyOverlayElement(slot.element);
+    }
+    if (banner.element) overlayManager.destroyOverlayElement(banner.element);
+    if (container) overlayManager.destroyOverlayElement(container);
+    if (overlay) overlayManager.destroy(overlay);
+}
+
+Ogre::TextAreaOverlayElement* MessageFeed::createText(const char* name) {
+    Ogre::TextAreaOverlayElement* text = static_cast<Ogre::TextAreaOverlayElement*>(
+        Ogre::OverlayManager::getSingleton().createOverlayElement("TextArea", name));
+    text->setMetricsMode(Ogre::GMM_RELATIVE);
+    text->setFontName("SdkTrays/Value");
+    text->setColour(Ogre::ColourValue(1.0, 1.0, 1.0, 1.0));
+    // Légende de longueur maximale une fois : la chaîne et le tampon de glyphes ne grandiront plus
+    text->setCaption(Ogre::String(MAX_MESSAGE_LENGTH - 1, ' '));
+    text->hide();
+    container->addChild(text);
+    return text;
+}
+
+void MessageFeed::initialize() {
+    MemoryScope memoryScope(MemoryTag::Interface);
+    try {
+        Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
+        overlay = overlayManager.create("MessageFeedOverlay");
+
+        container = static_cast<Ogre::OverlayContainer*>(
+            overlayManager.createOverlayElement("Panel", "MessageFeedContainer"));
+        container->setMetricsMode(Ogre::GMM_RELATIVE);
+        container->setPosition(0, 0);
+        container->setDimensions(1.0, 1.0);
+
+        char name[32];
+        for (size_t i = 0; i < FEED_LINES; ++i) {
+            std::snprintf(name, sizeof(name), "MessageFeedLine%zu", i);
+            Slot& slot = feed[i];
+            slot.element = createText(name);
+            slot.element->setCharHeight(FEED_CHAR_HEIGHT);
+            slot.element->setDimensions(0.25, FEED_LINE_SPACING);
+            slot.caption.reserve(MAX_MESSAGE_LENGTH);
+        }
+
+        banner.element = createText("MessageFeedBanner");
+        banner.element->setPosition(0.0, 0.3);  // Position verticale à 30% du haut
+        banner.element->setDimensions(1.0, 0.4);  // Hauteur de 40% de l'écran
+        banner.element->setAlignment(Ogre::TextAreaOverlayElement::Center);
+        banner.element->setHorizontalAlignment(Ogre::GHA_CENTER);
+        banner.element->setVerticalAlignment(Ogre::GVA_CENTER);
+        banner.caption.reserve(MAX_MESSAGE_LENGTH);
+
+        overlay->add2D(container);
+        overlay->setZOrder(300);
+        overlay->show();
+    } catch (const Ogre::Exception& e) {
+        std::cerr << "Failed to initialize message feed: " << e.what() << std::endl;
+    }
+}
+
+void MessageFeed::write(Slot& slot, float displayTime, const char* format, va_list args) {
+    std::vsnprintf(slot.text, MAX_MESSAGE_LENGTH, format, args);
+    slot.remaining = displayTime;
+    slot.sequence = ++nextSequence;
+}
+
+void MessageFeed::postFeed(float displayTime, const char* format, ...) {
+    // Une ligne libre, sinon la plus ancienne
+    Slot* target = &feed[0];
+    for (Slot& slot : feed) {
+        if (slot.remaining <= 0.0f) {
+            target = &slot;
+            break;
+        }
+        if (slot.sequence < target->sequence) target = &slot;
+    }
+
+    va_list args;
+    va_start(args, format);
+    write(*target, displayTime, format, args);
+    va_end(args);
+}
+
+void MessageFeed::showBanner(float displayTime, int fontSize, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    write(banner, displayTime, format, args);
+    va_end(args);
+
+    if (banner.element) {
+        banner.element->setCharHeight(static_cast<float>(fontSize) / 500.0f);
+    }
+}
+
+void MessageFeed::upload(Slot& slot) {
+    if (!slot.element) return;
+
+    if (slot.caption.compare(slot.text) != 0) {
+        slot.caption.assign(slot.text);
+        slot.element->setCaption(slot.caption);
+    }
+    if (!slot.shown) {
+        slot.element->show();
+        slot.shown = true;
+    }
+}
+
+void MessageFeed::expire(Slot& slot, float deltaTime) {
+    if (slot.remaining <= 0.0f) return;
+
+    slot.remaining -= deltaTime;
+    if (slot.remaining <= 0.0f) {
+        slot.remaining = 0.0f;
+        if (slot.element && slot.shown) slot.element->hide();
+        slot.shown = false;
+        slot.line = -1;
+    }
+}
+
+void MessageFeed::update(float deltaTime) {
+    PROFILE_SCOPE("Overlay");
+    if (!overlay) return;
+
+    expire(banner, deltaTime);
+    if (banner.remaining > 0.0f) upload(banner);
+
+    // Lignes actives de la plus récente à la plus ancienne ; on ne déplace que celles qui changent de rang
+    for (Slot& slot : feed) {
+        expire(slot, deltaTime);
+    }
+    for (Slot& slot : feed) {
+        if (slot.remaining <= 0.0f) continue;
+
+        int line = 0;
+        for (const Slot& other : feed) {
+            if (other.remaining > 0.0f && other.sequence > slot.sequence) ++line;
+        }
+        if (slot.line != line && slot.element) {
+            slot.element->setPosition(FEED_LEFT, FEED_TOP + line * FEED_LINE_SPACING);
+            slot.line = line;
+        }
+        upload(slot);
+    }
+}
+
+void MessageFeed::clear() {
+    for (Slot& slot : feed) {
+        expire(slot, slot.remaining);
+    }
+    expire(banner, banner.remaining);
+}
@@ -1,34 +1,71 @@
 #include "../include/Minimap.hpp"
+#include "../include/Profiler.hpp"
+#include "../include/AllocationCounter.hpp"
+#include "../include/GameComponents.hpp"
+#include "../include/ContactEvents.hpp"
+#include "../include/lib.hpp"
+#include <algorithm>
+#include <iostream>
 
-Minimap::Minimap() 
-    : minimapOverlay(nullptr)
-    , minimapBackground(nullptr)
-    , playerIcon(nullptr)
-{
-}
+namespace {
+    const Ogre::ColourValue PLAYER_COLOUR(1, 1, 1);
+    const Ogre::ColourValue ZOMBIE_COLOUR(1, 0, 0);        // Rouge pour les zombies
+    const Ogre::ColourValue TREE_COLOUR(0.5, 0.35, 0.05);  // Marron pour les arbres
+    const Ogre::ColourValue WALL_COLOUR(0.6, 0.6, 0.6);
 
-Minimap::~Minimap() {
-    Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
+    /**
+     * @brief Collects the zombies whose broadphase proxy overlaps the area shown
+     */
+    struct ZombieQuery : public btBroadphaseAabbCallback {
+        std::vector<btCollisionObject*>& found;
+
+        explicit ZombieQuery(std::vector<btCollisionObject*>& found) : found(found) {}
 
-    // Nettoyer les icônes des zombies
-    for (auto* icon : zombieIcons) {
-        if (icon) {
-            overlayManager.destroyOverlayElement(icon);
+        bool process(const btBroadphaseProxy* proxy) override {
+            btCollisionObject* object = static_cast<btCollisionObject*>(proxy->m_clientObject);
+            const BodyHandle* handle = static_cast<const BodyHandle*>(object->getUserPointer());
+            if (handle && handle->kind == BodyHandle::Kind::Zombie) {
+                found.push_back(object);
+            }
+            return true;
         }
-    }
-    zombieIcons.clear();
+    };
 
-    // Nettoyer les icônes des arbres
-    for (auto* icon : treeIcons) {
-        if (icon) {
-            overlayManager.destroyOverlayElement(icon);
+    /**
+     * @brief Fills a rectangle of an RGBA image, clipped to the image
+     */
+    void fillRect(std::vector<Ogre::uint8>& pixels, int size, int x0, int y0, int x1, int y1,
+                  const Ogre::ColourValue& colour) {
+        x0 = std::max(x0, 0);
+        y0 = std::max(y0, 0);
+        x1 = std::min(x1, size - 1);
+        y1 = std::min(y1, size - 1);
+        for (int y = y0; y <= y1; ++y) {
+            Ogre::uint8* texel = &pixels[(static_cast<size_t>(y) * size + x0) * 4];
+            for (int x = x0; x <= x1; ++x, texel += 4) {
+                texel[0] = static_cast<Ogre::uint8>(colour.r * 255);
+                texel[1] = static_cast<Ogre::uint8>(colour.g * 255);
+                texel[2] = static_cast<Ogre::uint8>(colour.b * 255);
+                texel[3] = 255;
+            }
         }
     }
-    treeIcons.clear();
+}
 
-    // Nettoyer les autres éléments
-    if (playerIcon) {
-        overlayManager.destroyOverlayElement(playerIcon);
+Minimap::Minimap()
+    : sceneManager(nullptr)
+    , minimapOverlay(nullptr)
+    , minimapBackground(nullptr)
+    , staticLayerPanel(nullptr)
+{
+    visibleZombies.reserve(VISIBLE_ZOMBIES_RESERVE);
+}
+
+Minimap::~Minimap() {
+    Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
+
+    if (staticLayerPanel) {
+        overlayManager.destroyOverlayElement(staticLayerPanel);
     }
     if (minimapBackground) {
         overlayManager.destroyOverlayElement(minimapBackground);
@@ -36,6 +73,22 @@ Minimap::~Minimap() {
     if (minimapOverlay) {
         overlayManager.destroy(minimapOverlay);
     }
+    if (staticLayerMaterial) {
+        Ogre::MaterialManager::getSingleton().remove(staticLayerMaterial);
+    }
+    if (staticLayerTexture) {
+        Ogre::TextureManager::getSingleton().remove(staticLayerTexture);
+    }
+}
+
+void Minimap::show() {
+    if (minimapOverlay) minimapOverlay->show();
+    icons.setVisible(true);
+}
+
+void Minimap::hide() {
+    if (minimapOverlay) minimapOverlay->hide();
+    icons.setVisible(false);
 }
 
 void Minimap::adjustPosition(unsigned int screenWidth) {
@@ -45,7 +98,9 @@ void Minimap::adjustPosition(unsigned int screenWidth) {
 }
 
 void Minimap::initialize(Ogre::SceneManager* scnMgr) {
+    MemoryScope memoryScope(MemoryTag::Interface);
     Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
+    sceneManager = scnMgr;
 
     // Créer l'overlay principal
     minimapOverlay = overlayManager.create("MinimapOverlay");
@@ -54,107 +109,153 @@ void Minimap::initialize(Ogre::SceneManager* scnMgr) {
     minimapBackground = static_cast<Ogre::OverlayContainer*>(
         overlayManager.createOverlayElement("Panel", "MinimapBackground"));
     minimapBackground->setMetricsMode(Ogre::GMM_PIXELS);
-    
+
     // Position initiale (sera ajustée plus tard)
     minimapBackground->setPosition(800 - MINIMAP_SIZE - MINIMAP_MARGIN, MINIMAP_MARGIN);
     minimapBackground->setDimensions(MINIMAP_SIZE, MINIMAP_SIZE);
     minimapBackground->setMaterialName("Core/StatsBlockCenter");
 
-    // Créer l'icône du joueur
-    playerIcon = static_cast<Ogre::OverlayContainer*>(
-        overlayManager.createOverlayElement("Panel", "PlayerIcon"));
-    playerIcon->setMetricsMode(Ogre::GMM_PIXELS);
-    playerIcon->setDimensions(6, 6);  // Taille de l'icône du joueur
-    playerIcon->setMaterialName("Core/PlayerIcon");
+    createStaticLayer();
 
     // Ajouter les éléments à l'overlay
-    minimapBackground->addChild(playerIcon);
     minimapOverlay->add2D(minimapBackground);
     minimapOverlay->setZOrder(200);  // Au-dessus du jeu mais en-dessous des messages
     minimapOverlay->show();
+
+    // Toutes les icônes dans un seul tampon de sommets, en coordonnées écran
+    icons.initialize(scnMgr, "MinimapIcons", ICON_RENDER_PRIORITY);
 }
 
-void Minimap::createMinimapIcon(const std::string& name, const Ogre::ColourValue& color) {
-    Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
-    
-    auto* icon = static_cast<Ogre::OverlayContainer*>(
-        overlayManager.createOverlayElement("Panel", name));
-    icon->setMetricsMode(Ogre::GMM_PIXELS);
-    icon->setDimensions(4, 4);  // Taille plus petite pour les autres icônes
-    
-    // Utiliser le matériau approprié en fonction du type d'icône
-    if (name.find("Zombie") != std::string::npos) {
-        icon->setMaterialName("Core/ZombieIcon");
-    } else {
-        // Pour les autres icônes (arbres, etc.), utiliser le matériau par défaut
-        icon->setMaterialName("Core/StatsBlockCenter");
-        // Convertir la couleur en string pour la bordure
-        std::stringstream ss;
-        ss << color.r << " " << color.g << " " << color.b;
-        icon->setParameter("border_color", ss.str());
+void Minimap::createStaticLayer() {
+    try {
+        staticLayerTexture = Ogre::TextureManager::getSingleton().createManual(
+            "MinimapStaticLayer", Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, Ogre::TEX_TYPE_2D,
+            STATIC_LAYER_SIZE, STATIC_LAYER_SIZE, 0, Ogre::PF_BYTE_RGBA, Ogre::TU_STATIC_WRITE_ONLY);
+
+        staticLayerMaterial = Ogre::MaterialManager::getSingleton().create(
+            "Minimap/StaticLayer", Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+        Ogre::Pass* pass = staticLayerMaterial->getTechnique(0)->getPass(0);
+        pass->setLightingEnabled(false);
+        pass->setDepthCheckEnabled(false);
+        pass->setDepthWriteEnabled(false);
+        pass->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
+        Ogre::TextureUnitState* unit = pass->createTextureUnitState();
+        unit->setTexture(staticLayerTexture);
+        // Hors de la carte : transparent plutôt que les bords étirés
+        unit->setTextureAddressingMode(Ogre::TextureUnitState::TAM_BORDER);
+        unit->setTextureBorderColour(Ogre::ColourValue::ZERO);
+
+        staticLayerPanel = static_cast<Ogre::PanelOverlayElement*>(
+            Ogre::OverlayManager::getSingleton().createOverlayElement("Panel", "MinimapStaticLayer"));
+        staticLayerPanel->setMetricsMode(Ogre::GMM_PIXELS);
+        staticLayerPanel->setPosition(0, 0);
+        staticLayerPanel->setDimensions(MINIMAP_SIZE, MINIMAP_SIZE);
+        staticLayerPanel->setMaterial(staticLayerMaterial);
+        minimapBackground->addChild(staticLayerPanel);
+    } catch (const Ogre::Exception& e) {
+        std::cerr << "Failed to create minimap static layer: " << e.what() << std::endl;
     }
-    
-    minimapBackground->addChild(icon);
 }
 
-void Minimap::updateIconPosition(const std::string& name, const Ogre::Vector3& worldPos) {
-    auto* icon = static_cast<Ogre::OverlayContainer*>(
-        Ogre::OverlayManager::getSingleton().getOverlayElement(name));
-    if (!icon) return;
+void Minimap::buildStaticLayer(EntityStore& store) {
+    if (!staticLayerTexture) return;
+    MemoryScope memoryScope(MemoryTag::Interface);
+
+    // Monde -> texel : la texture couvre tout le plan
+    // Copies locales : PLANE_WIDTH et PLANE_HEIGHT ne sont pas parenthésées
+    const int size = static_cast<int>(STATIC_LAYER_SIZE);
+    const float mapWidth = PLANE_WIDTH;
+    const float mapHeight = PLANE_HEIGHT;
+    const float texelsPerUnitX = size / mapWidth;
+    const float texelsPerUnitZ = size / mapHeight;
+    auto toTexelX = [&](float x) { return static_cast<int>((x + mapWidth / 2) * texelsPerUnitX); };
+    auto toTexelZ = [&](float z) { return static_cast<int>((z + mapHeight / 2) * texelsPerUnitZ); };
 
-    // Si c'est l'icône du joueur, le placer au centre
-    if (name == "PlayerIcon") {
-        icon->setPosition((MINIMAP_SIZE / 2) - 3, (MINIMAP_SIZE / 2) - 3);  // -3 pour centrer l'icône de 6x6
-        return;
+    std::vector<Ogre::uint8> pixels(static_cast<size_t>(size) * size * 4, 0);
+
+    // Murs et autres corps statiques : leur emprise au sol
+    store.each<Team, RigidBodyRef>([&](EntityId id, Team& team, RigidBodyRef& bodyRef) {
+        if (team.side != Side::Environment || !bodyRef.body || store.has<Tree>(id)) return;
+        btVector3 aabbMin, aabbMax;
+        bodyRef.body->getAabb(aabbMin, aabbMax);
+        fillRect(pixels, size, toTexelX(aabbMin.x()), toTexelZ(aabbMin.z()),
+                 toTexelX(aabbMax.x()), toTexelZ(aabbMax.z()), WALL_COLOUR);
+    });
+
+    // Arbres : même taille que les anciennes icônes, visibles quelle que soit leur emprise
+    const int treeHalfSize = static_cast<int>(ICON_HALF_SIZE);
+    store.each<Tree, Transform>([&](EntityId, Tree&, Transform& transform) {
+        const int x = toTexelX(transform.position.x);
+        const int y = toTexelZ(transform.position.z);
+        fillRect(pixels, size, x - treeHalfSize, y - treeHalfSize, x + treeHalfSize - 1, y + treeHalfSize - 1,
+                 TREE_COLOUR);
+    });
+
+    try {
+        staticLayerTexture->getBuffer()->blitFromMemory(
+            Ogre::PixelBox(STATIC_LAYER_SIZE, STATIC_LAYER_SIZE, 1, Ogre::PF_BYTE_RGBA, pixels.data()));
+    } catch (const Ogre::Exception& e) {
+        std::cerr << "Failed to upload minimap static layer: " << e.what() << std::endl;
     }
+}
 
-    // Pour les autres icônes, calculer leur position relative au joueur
+void Minimap::addIcon(float mapX, float mapY, float halfSize, const Ogre::ColourValue& colour) {
+    icons.addQuad(minimapBackground->getLeft() + mapX - halfSize, minimapBackground->getTop() + mapY - halfSize,
+                  2 * halfSize, 2 * halfSize, colour);
+}
+
+void Minimap::addWorldIcon(const Ogre::Vector3& worldPos, float halfSize, const Ogre::ColourValue& colour) {
+    // Position relative au joueur
     Ogre::Vector3 relativePos = worldPos - playerLastPosition;
-    
+
     // Convertir la position relative en coordonnées de minimap
     float mapX = (MINIMAP_SIZE / 2) + (relativePos.x * MINIMAP_SCALE);
     float mapZ = (MINIMAP_SIZE / 2) + (relativePos.z * MINIMAP_SCALE);
-    
-    // S'assurer que l'icône reste dans les limites du minimap
-    mapX = std::max(0.0f, std::min(mapX, MINIMAP_SIZE));
-    mapZ = std::max(0.0f, std::min(mapZ, MINIMAP_SIZE));
-    
-    // Ajuster pour centrer l'icône (les icônes font 4x4 pixels)
-    icon->setPosition(mapX - 2, mapZ - 2);
+
+    // Hors du minimap : pas d'icône (la requête large peut en renvoyer quelques-unes)
+    if (mapX < 0.0f || mapX > MINIMAP_SIZE || mapZ < 0.0f || mapZ > MINIMAP_SIZE) return;
+
+    addIcon(mapX, mapZ, halfSize, colour);
 }
 
-void Minimap::update(const Ogre::Vector3& playerPos,
-                    const std::vector<Ogre::Vector3>& zombiePositions,
-                    const std::vector<Ogre::Vector3>& treePositions) {
+void Minimap::update(const Ogre::Vector3& playerPos, btCollisionWorld* world) {
+    PROFILE_SCOPE("Minimap");
+    if (!minimapBackground) return;
+
     // Mettre à jour la dernière position du joueur
     playerLastPosition = playerPos;
 
-    // Mettre à jour la position du joueur (toujours au centre)
-    updateIconPosition("PlayerIcon", playerPos);
-
-    // Mettre à jour ou créer les icônes des zombies
-    while (zombieIcons.size() < zombiePositions.size()) {
-        std::string name = "ZombieIcon" + std::to_string(zombieIcons.size());
-        createMinimapIcon(name, Ogre::ColourValue(1, 0, 0));  // Rouge pour les zombies
-        zombieIcons.push_back(static_cast<Ogre::OverlayContainer*>(
-            Ogre::OverlayManager::getSingleton().getOverlayElement(name)));
+    // Faire défiler la couche statique : fenêtre de la carte centrée sur le joueur
+    const float halfExtent = (MINIMAP_SIZE / 2) / MINIMAP_SCALE;
+    if (staticLayerPanel) {
+        const float mapWidth = PLANE_WIDTH;
+        const float mapHeight = PLANE_HEIGHT;
+        const float centreU = (playerPos.x + mapWidth / 2) / mapWidth;
+        const float centreV = (playerPos.z + mapHeight / 2) / mapHeight;
+        const float halfU = halfExtent / mapWidth;
+        const float halfV = halfExtent / mapHeight;
+        staticLayerPanel->setUV(centreU - halfU, centreV - halfV, centreU + halfU, centreV + halfV);
     }
 
-    // Mettre à jour les positions des zombies
-    for (size_t i = 0; i < zombiePositions.size(); ++i) {
-        updateIconPosition("ZombieIcon" + std::to_string(i), zombiePositions[i]);
+    // Seuls les zombies dans la zone affichée, trouvés par la broadphase
+    visibleZombies.clear();
+    if (world) {
+        ZombieQuery query(visibleZombies);
+        const btVector3 queryMin(playerPos.x - halfExtent, -1.0e4f, playerPos.z - halfExtent);
+        const btVector3 queryMax(playerPos.x + halfExtent, 1.0e4f, playerPos.z + halfExtent);
+        world->getBroadphase()->aabbTest(queryMin, queryMax, query);
     }
 
-    // Mettre à jour ou créer les icônes des arbres
-    while (treeIcons.size() < treePositions.size()) {
-        std::string name = "TreeIcon" + std::to_string(treeIcons.size());
-        createMinimapIcon(name, Ogre::ColourValue(0.5, 0.35, 0.05));  // Marron pour les arbres
-        treeIcons.push_back(static_cast<Ogre::OverlayContainer*>(
-            Ogre::OverlayManager::getSingleton().getOverlayElement(name)));
-    }
+    icons.clear();
 
-    // Mettre à jour les positions des arbres
-    for (size_t i = 0; i < treePositions.size(); ++i) {
-        updateIconPosition("TreeIcon" + std::to_string(i), treePositions[i]);
+    for (const btCollisionObject* zombie : visibleZombies) {
+        const btVector3& origin = zombie->getWorldTransform().getOrigin();
+        addWorldIcon(Ogre::Vector3(origin.x(), origin.y(), origin.z()), ICON_HALF_SIZE, ZOMBIE_COLOUR);
     }
-} 
\ No newline at end of file
+
+    // Le joueur reste toujours au centre
+    addIcon(MINIMAP_SIZE / 2, MINIMAP_SIZE / 2, PLAYER_ICON_HALF_SIZE, PLAYER_COLOUR);
+
+    // Rien n'est envoyé au GPU si aucune icône n'a bougé d'un pixel
+    icons.flush();
+}
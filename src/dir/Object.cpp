@@ -1,4 +1,11 @@
 #include "../include/Object.hpp"
+#include "../include/GameRandom.hpp"
+#include "../include/Profiler.hpp"
+#include "../include/AllocationCounter.hpp"
+#include "../include/FrameArena.hpp"
+#include "../include/ShadowSystem.hpp"
+#include <algorithm>
+#include <iterator>
 
 /**
  * @brief Destructor that properly cleans up all physics-related resources
@@ -8,42 +15,44 @@ Object::~Object() {
 }
 
 /**
- * @brief Default constructor
+ * @brief Constructor
+ * @param sharedStore Entity store receiving the trees and walls, null to use a private one
  */
-Object::Object() {}
+Object::Object(EntityStore* sharedStore) : store(sharedStore) {
+    if (!store) {
+        ownStore = std::make_unique<EntityStore>();
+        store = ownStore.get();
+    }
+}
 
 /**
  * @brief Cleans up all physics-related resources
  */
 void Object::cleanupPhysicsResources() {
-    // Clean up rigid bodies and their motion states
-    for (auto body : treeBodies) {
-        if (body && body->getMotionState()) {
-            delete body->getMotionState();
+    // Clean up rigid bodies with their motion states and shapes, then the entities
+    for (EntityId id : entities) {
+        RigidBodyRef* bodyRef = store->get<RigidBodyRef>(id);
+        if (bodyRef && bodyRef->body) {
+            delete bodyRef->body->getMotionState();
+            delete bodyRef->body->getCollisionShape();
+            delete bodyRef->body;
         }
-        delete body;
-    }
-
-    // Clean up collision shapes
-    for (auto shape : treeShapes) {
-        delete shape;
+        store->destroy(id);
     }
-
-    // Clear all vectors
-    treeBodies.clear();
-    treeShapes.clear();
-    treeMotionStates.clear();
+    entities.clear();
 }
 
 /**
  * @brief Creates boundary walls and trees in the scene
  * @param scnMgr Pointer to the scene manager
  * @param dynamicsWorld Pointer to the physics world
+ * @param treeCount Number of random trees
  */
-void Object::createObject(SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld) {
+void Object::createObject(SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld, int treeCount) {
+    MemoryScope memoryScope(MemoryTag::Objects);
     createBoundaryWalls(dynamicsWorld);
     createBoundaryTrees(scnMgr, dynamicsWorld);
-    createRandomTrees(scnMgr, dynamicsWorld);
+    createRandomTrees(scnMgr, dynamicsWorld, treeCount);
 }
 
 /**
@@ -97,12 +106,11 @@ void Object::createWall(const btVector3& size, const btVector3& position, btDisc
     btRigidBody::btRigidBodyConstructionInfo wallRbInfo(0, wallMotionState, wallShape);
     btRigidBody* wallBody = new btRigidBody(wallRbInfo);
     
-    dynamicsWorld->addRigidBody(wallBody);
+    CollisionLayers::addRigidBody(dynamicsWorld, wallBody, CollisionLayer::Static);
     
     // Store for cleanup
-    treeBodies.push_back(wallBody);
-    treeShapes.push_back(wallShape);
-    treeMotionStates.push_back(wallMotionState);
+    entities.push_back(store->create(Transform{Vector3(position.x(), position.y(), position.z())},
+                                     Team{Side::Environment}, RigidBodyRef{wallBody}));
 }
 
 /**
@@ -132,37 +140,121 @@ void Object::createBoundaryTrees(SceneManager* scnMgr, btDiscreteDynamicsWorld*
  * @brief Creates random trees throughout the map
  * @param scnMgr Pointer to the scene manager
  * @param dynamicsWorld Pointer to the physics world
+ * @param treeCount Number of trees to create
  */
-void Object::createRandomTrees(SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld) {
-    std::srand(static_cast<unsigned>(std::time(0)));
-    
-    for (int i = 0; i < TREE_NUMBER; ++i) {
-        float x = static_cast<float>(std::rand()) / RAND_MAX * PLANE_WIDTH - PLANE_WIDTH / 2;
-        float z = static_cast<float>(std::rand()) / RAND_MAX * PLANE_HEIGHT - PLANE_HEIGHT / 2;
+void Object::createRandomTrees(SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld, int treeCount) {
+    MemoryScope memoryScope(MemoryTag::Objects);
+    // Tirage depuis la graine de la partie : un enregistrement reconstruit la même forêt
+    for (int i = 0; i < treeCount; ++i) {
+        float x = GameRandom::uniform(-PLANE_WIDTH / 2, PLANE_WIDTH / 2);
+        float z = GameRandom::uniform(-PLANE_HEIGHT / 2, PLANE_HEIGHT / 2);
         
-        createTreeAtPosition(x, z, scnMgr, dynamicsWorld);
+        randomTrees.push_back(createTreeAtPosition(x, z, scnMgr, dynamicsWorld));
+    }
+}
+
+/**
+ * @brief Adds or removes random trees until there are count of them
+ * @param count Number of random trees wanted
+ * @param scnMgr Pointer to the scene manager
+ * @param dynamicsWorld Pointer to the physics world
+ */
+void Object::setRandomTreeCount(size_t count, SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld) {
+    MemoryScope memoryScope(MemoryTag::Objects);
+    if (count > randomTrees.size()) {
+        createRandomTrees(scnMgr, dynamicsWorld, static_cast<int>(count - randomTrees.size()));
+        return;
+    }
+    while (randomTrees.size() > count) {
+        destroyTree(randomTrees.back(), scnMgr, dynamicsWorld);
+        randomTrees.pop_back();
     }
 }
 
+/**
+ * @brief Removes a tree from the world and the scene and destroys its entity
+ * @param id Tree entity
+ * @param scnMgr Pointer to the scene manager
+ * @param dynamicsWorld Pointer to the physics world
+ */
+void Object::destroyTree(EntityId id, SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld) {
+    if (RigidBodyRef* bodyRef = store->get<RigidBodyRef>(id)) {
+        if (bodyRef->body) {
+            dynamicsWorld->removeRigidBody(bodyRef->body);
+            delete bodyRef->body->getMotionState();
+            delete bodyRef->body->getCollisionShape();
+            delete bodyRef->body;
+        }
+    }
+    if (ShadowCaster* caster = store->get<ShadowCaster>(id)) {
+        if (caster->proxy) {
+            SceneNode* proxyNode = caster->proxy->getParentSceneNode();
+            scnMgr->destroyEntity(caster->proxy);
+            if (proxyNode) scnMgr->destroySceneNode(proxyNode);
+        }
+    }
+    if (SceneNodeRef* visual = store->get<SceneNodeRef>(id)) {
+        if (visual->entity) scnMgr->destroyEntity(visual->entity);
+        if (visual->node) scnMgr->destroySceneNode(visual->node);
+    }
+
+    entities.erase(std::remove(entities.begin(), entities.end(), id), entities.end());
+    store->destroy(id);
+}
+
 /**
  * @brief Creates a tree at the specified position
  * @param x X coordinate
  * @param z Z coordinate
  * @param scnMgr Pointer to the scene manager
  * @param dynamicsWorld Pointer to the physics world
+ * @return The tree entity
  */
-void Object::createTreeAtPosition(float x, float z, SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld) {
+EntityId Object::createTreeAtPosition(float x, float z, SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld) {
     // Create visual representation
     std::string entityName = "tree_placeholder_" + generateUniqueId();
     Entity* placeholder = scnMgr->createEntity(entityName, Ogre::SceneManager::PT_CUBE);
+    placeholder->setCastShadows(false);
+    placeholder->setRenderingDistance(impostorDistance);
     SceneNode* treeNode = scnMgr->getRootSceneNode()->createChildSceneNode();
     treeNode->attachObject(placeholder);
     treeNode->setPosition(Vector3(x, 0, z));
     treeNode->setScale(0.1f, 0.1f, 0.1f);
-    treeNodes.push_back(treeNode);
+    Entity* shadowProxy = createTreeShadowProxy(treeNode, scnMgr);
 
     // Create physics representation
-    createTreePhysics(x, z, dynamicsWorld);
+    btRigidBody* treeBody = createTreePhysics(x, z, dynamicsWorld);
+
+    // Les modèles détaillés alternent dans l'ordre de création
+    Tree tree;
+    tree.model = static_cast<unsigned char>(treeCount++ % 2);
+    const EntityId id = store->create(Transform{Vector3(x, 0, z)}, Team{Side::Environment},
+                                      SceneNodeRef{treeNode, placeholder}, RigidBodyRef{treeBody}, tree,
+                                      ShadowCaster{shadowProxy});
+    entities.push_back(id);
+    return id;
+}
+
+/**
+ * @brief Creates the box casting a tree's shadow in place of its mesh
+ *
+ * Sized like the tree's collision box above the ground. Hidden until a
+ * ShadowSystem enables shadows.
+ * @param treeNode Node of the tree (scaled by 0.1)
+ * @param scnMgr Pointer to the scene manager
+ * @return The proxy entity
+ */
+Entity* Object::createTreeShadowProxy(SceneNode* treeNode, SceneManager* scnMgr) {
+    Entity* proxy = scnMgr->createEntity("tree_shadow_" + generateUniqueId(), Ogre::SceneManager::PT_CUBE);
+    proxy->setMaterialName(ShadowSystem::PROXY_MATERIAL);
+    proxy->setCastShadows(true);
+    proxy->setVisible(false);
+
+    // Cube de 100 unités sous un nœud à l'échelle 0.1 : 40 x 120 x 40 dans le monde, posé au sol
+    SceneNode* proxyNode = treeNode->createChildSceneNode(Vector3(0, 600, 0));
+    proxyNode->setScale(4.0f, 12.0f, 4.0f);
+    proxyNode->attachObject(proxy);
+    return proxy;
 }
 
 /**
@@ -170,93 +262,133 @@ void Object::createTreeAtPosition(float x, float z, SceneManager* scnMgr, btDisc
  * @param x X coordinate
  * @param z Z coordinate
  * @param dynamicsWorld Pointer to the physics world
+ * @return The tree's static body
  */
-void Object::createTreePhysics(float x, float z, btDiscreteDynamicsWorld* dynamicsWorld) {
+btRigidBody* Object::createTreePhysics(float x, float z, btDiscreteDynamicsWorld* dynamicsWorld) {
     btCollisionShape* treeShape = new btBoxShape(btVector3(20.0f, 70.0f, 20.0f));
-    treeShapes.push_back(treeShape);
 
     btTransform treeTransform;
     treeTransform.setIdentity();
     treeTransform.setOrigin(btVector3(x, 0, z));
 
     btDefaultMotionState* motionState = new btDefaultMotionState(treeTransform);
-    treeMotionStates.push_back(motionState);
 
     btRigidBody::btRigidBodyConstructionInfo rbInfo(0.0f, motionState, treeShape, btVector3(0, 0, 0));
     btRigidBody* treeBody = new btRigidBody(rbInfo);
-    treeBodies.push_back(treeBody);
 
-    dynamicsWorld->addRigidBody(treeBody);
+    CollisionLayers::addRigidBody(dynamicsWorld, treeBody, CollisionLayer::Static);
+    return treeBody;
 }
 
 /**
  * @brief Updates the Level of Detail (LOD) for trees based on camera distance
+ *
+ * The distance tests only read the Transform and Tree arrays and run as
+ * parallel jobs; entities are then created and destroyed on the calling
+ * thread, as Ogre requires.
  * @param camNode Camera node
  * @param scnMgr Scene manager
+ * @param jobs Job system sharing out the distance tests, may be null
  */
-void Object::updateObjectLODs(SceneNode* camNode, SceneManager* scnMgr) {
+void Object::updateObjectLODs(SceneNode* camNode, SceneManager* scnMgr, JobSystem* jobs) {
+    MemoryScope memoryScope(MemoryTag::Objects);
+    PROFILE_SCOPE("LOD");
     Vector3 cameraPosition = camNode->getPosition();
-    const std::vector<std::string> treeModels = {"tree_1.mesh", "tree_2.mesh"};
-    const std::vector<std::string> materials = {"MT01_MatTreeF4_M6_P1", "MT01_MatTreeF4_M5_P1"};
 
-    for (size_t i = 0; i < treeNodes.size(); ++i) {
-        updateTreeLOD(i, cameraPosition, treeModels, materials, scnMgr);
-    }
+    store->eachChunk<Tree, Transform, SceneNodeRef>(
+        [&](size_t count, const EntityId*, Tree* trees, Transform* transforms, SceneNodeRef* visuals) {
+        FrameVector<LodChange> changes(count, LodChange::None);
+        auto classifyRange = [this, &cameraPosition, &changes, trees, transforms](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                changes[i] = classifyTreeLOD(trees[i], transforms[i], cameraPosition);
+            }
+        };
+        if (jobs) {
+            jobs->parallelFor(count, LOD_GRAIN_SIZE, classifyRange);
+        } else {
+            classifyRange(0, count);
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            if (changes[i] == LodChange::ToHigh) {
+                switchToHighDetailTree(trees[i], visuals[i], scnMgr);
+            } else if (changes[i] == LodChange::ToLow) {
+                switchToLowDetailTree(trees[i], visuals[i], scnMgr);
+            }
+        }
+    });
+}
+
+/**
+ * @brief Sets the level of detail distances
+ *
+ * The switch distance is read by the next updateObjectLODs; the impostor
+ * distance is applied at once to the placeholders already in the scene.
+ * @param detail Trees closer than this use their full mesh
+ * @param impostor Placeholders are not drawn past this, 0 for no limit
+ */
+void Object::setLodDistances(float detail, float impostor) {
+    detailDistance = detail;
+    if (impostor == impostorDistance) return;
+
+    impostorDistance = impostor;
+    store->each<Tree, SceneNodeRef>([impostor](EntityId, Tree& tree, SceneNodeRef& visual) {
+        if (!tree.detailed && visual.entity) visual.entity->setRenderingDistance(impostor);
+    });
 }
 
 /**
- * @brief Updates the LOD for a single tree
- * @param index Tree index
+ * @brief Decides whether a tree must switch representation
+ * @param tree Tree component
+ * @param transform Tree position
  * @param cameraPosition Camera position
- * @param treeModels Available tree models
- * @param materials Available materials
- * @param scnMgr Scene manager
+ * @return Change to apply, if any
  */
-void Object::updateTreeLOD(size_t index, const Vector3& cameraPosition, 
-                          const std::vector<std::string>& treeModels,
-                          const std::vector<std::string>& materials,
-                          SceneManager* scnMgr) {
-    SceneNode* treeNode = treeNodes[index];
-    Vector3 treePosition = treeNode->getPosition();
-    float distance = cameraPosition.distance(treePosition) - DISTANCE_RENDER_TREE;
-
-    if (distance < lodDistanceThreshold && treeNode->numAttachedObjects() == 1) {
-        switchToHighDetailTree(index, treeNode, treeModels, materials, scnMgr);
-    } else if (distance >= lodDistanceThreshold && treeNode->numAttachedObjects() > 0) {
-        switchToLowDetailTree(index, treeNode, scnMgr);
+Object::LodChange Object::classifyTreeLOD(const Tree& tree, const Transform& transform,
+                                          const Vector3& cameraPosition) const {
+    float distance = cameraPosition.distance(transform.position);
+
+    if (distance < detailDistance && !tree.detailed) {
+        return LodChange::ToHigh;
+    } else if (distance >= detailDistance && tree.detailed) {
+        return LodChange::ToLow;
     }
+    return LodChange::None;
 }
 
 /**
  * @brief Switches a tree to high detail representation
  */
-void Object::switchToHighDetailTree(size_t index, SceneNode* treeNode,
-                                  const std::vector<std::string>& treeModels,
-                                  const std::vector<std::string>& materials,
-                                  SceneManager* scnMgr) {
-    treeNode->detachAllObjects();
+void Object::switchToHighDetailTree(Tree& tree, SceneNodeRef& visual, SceneManager* scnMgr) {
+    if (visual.entity) scnMgr->destroyEntity(visual.entity);
     std::string treeName = "tree_full_" + generateUniqueId();
-    Entity* tree = scnMgr->createEntity(treeName, treeModels[index % treeModels.size()]);
-    tree->setCastShadows(true);
+    Entity* treeEntity = scnMgr->createEntity(treeName, TREE_MODELS[tree.model % std::size(TREE_MODELS)]);
+    treeEntity->setCastShadows(false); // L'ombre vient du ShadowCaster
     
-    std::string materialName = materials[index % materials.size()];
-    tree->setMaterialName(materialName);
+    std::string materialName = TREE_MATERIALS[tree.model % std::size(TREE_MATERIALS)];
+    treeEntity->setMaterialName(materialName);
     
     setupTreeMaterial(materialName);
     
-    treeNode->attachObject(tree);
-    treeNode->setScale(0.1f, 0.1f, 0.1f);
+    visual.node->attachObject(treeEntity);
+    visual.node->setScale(0.1f, 0.1f, 0.1f);
+    visual.entity = treeEntity;
+    tree.detailed = true;
 }
 
 /**
  * @brief Switches a tree to low detail representation
  */
-void Object::switchToLowDetailTree(size_t index, SceneNode* treeNode, SceneManager* scnMgr) {
-    treeNode->detachAllObjects();
+void Object::switchToLowDetailTree(Tree& tree, SceneNodeRef& visual, SceneManager* scnMgr) {
+    if (visual.entity) scnMgr->destroyEntity(visual.entity);
     std::string placeholderName = "object_placeholder_" + generateUniqueId();
     Entity* placeholder = scnMgr->createEntity(placeholderName, Ogre::SceneManager::PT_CUBE);
-    treeNode->attachObject(placeholder);
-    treeNode->setScale(0.1f, 0.1f, 0.1f);
+    placeholder->setCastShadows(false);
+    placeholder->setRenderingDistance(impostorDistance);
+    visual.node->attachObject(placeholder);
+    visual.node->setScale(0.1f, 0.1f, 0.1f);
+    visual.entity = placeholder;
+    tree.detailed = false;
 }
 
 /**
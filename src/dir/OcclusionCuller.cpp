@@ -0,0 +1,255 @@
+#include "../include/OcclusionCuller.hpp"
+#include "../include/GameComponents.hpp"
+#include "../include/FrameArena.hpp"
+#include "../include/Profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FORESTZ_OCCLUSION_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+    const float FAR_DEPTH = std::numeric_limits<float>::max();
+
+    // Les 12 triangles d'une boîte, sommets numérotés comme AxisAlignedBox::getAllCorners()
+    const int BOX_TRIANGLES[12][3] = {
+        {0, 1, 2}, {0, 2, 3},  // Face z min
+        {4, 5, 6}, {4, 6, 7},  // Face z max
+        {0, 3, 5}, {0, 5, 6},  // Face x min
+        {1, 2, 4}, {1, 4, 7},  // Face x max
+        {0, 1, 7}, {0, 7, 6},  // Face y min
+        {2, 3, 5}, {2, 5, 4}   // Face y max
+    };
+
+    /**
+     * @brief Edge function A*x + B*y + C, positive on the inner side of p0 -> p1
+     */
+    struct Edge {
+        float a, b, c;
+
+        Edge(float x0, float y0, float x1, float y1)
+            : a(y0 - y1), b(x1 - x0), c(-(a * x0 + b * y0)) {}
+
+        float at(float x, float y) const { return a * x + b * y + c; }
+    };
+}
+
+OcclusionCuller::OcclusionCuller()
+    : depth(static_cast<size_t>(WIDTH) * HEIGHT, FAR_DEPTH)
+    , viewProjection(Ogre::Matrix4::IDENTITY)
+    , nearClip(1.0f)
+    , occluderCount(0)
+    , testedCount(0)
+    , occludedCount(0)
+    , enabled(true)
+    , hasHidden(false)
+{
+}
+
+void OcclusionCuller::setEnabled(bool enable) {
+    enabled = enable;
+}
+
+void OcclusionCuller::beginFrame(const Ogre::Matrix4& matrix, float near) {
+    viewProjection = matrix;
+    nearClip = near;
+    occluderCount = 0;
+    std::fill(depth.begin(), depth.end(), FAR_DEPTH);
+}
+
+bool OcclusionCuller::project(const Ogre::Vector3& point, ScreenVertex& out) const {
+    const Ogre::Vector4 clip = viewProjection * Ogre::Vector4(point.x, point.y, point.z, 1.0f);
+    if (clip.w < nearClip) return false;
+
+    const float inverseW = 1.0f / clip.w;
+    out.x = (clip.x * inverseW * 0.5f + 0.5f) * WIDTH;
+    out.y = (0.5f - clip.y * inverseW * 0.5f) * HEIGHT;
+    out.w = clip.w;
+    return true;
+}
+
+void OcclusionCuller::addOccluder(const Ogre::AxisAlignedBox& box) {
+    if (!box.isFinite()) return;
+
+    // Un occulteur coupé par le plan proche est ignoré plutôt que découpé
+    const Ogre::Vector3* corners = box.getAllCorners();
+    ScreenVertex screen[8];
+    for (int i = 0; i < 8; ++i) {
+        if (!project(corners[i], screen[i])) return;
+    }
+
+    for (const int* triangle : BOX_TRIANGLES) {
+        rasterizeTriangle(screen[triangle[0]], screen[triangle[1]], screen[triangle[2]]);
+    }
+    ++occluderCount;
+}
+
+void OcclusionCuller::rasterizeTriangle(ScreenVertex a, ScreenVertex b, ScreenVertex c) {
+    const float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    if (std::fabs(area) < 1e-6f) return;
+    if (area < 0.0f) std::swap(b, c);
+
+    // Profondeur constante, celle du sommet le plus loin : l'occulteur n'est jamais rapproché
+    const float triangleDepth = std::max(a.w, std::max(b.w, c.w));
+
+    int minX = std::max(0, static_cast<int>(std::floor(std::min(a.x, std::min(b.x, c.x)))));
+    const int maxX = std::min(WIDTH - 1, static_cast<int>(std::ceil(std::max(a.x, std::max(b.x, c.x)))));
+    const int minY = std::max(0, static_cast<int>(std::floor(std::min(a.y, std::min(b.y, c.y)))));
+    const int maxY = std::min(HEIGHT - 1, static_cast<int>(std::ceil(std::max(a.y, std::max(b.y, c.y)))));
+    if (minX > maxX || minY > maxY) return;
+    minX &= ~3; // Quatre pixels alignés par itération
+
+    const Edge edges[3] = {Edge(a.x, a.y, b.x, b.y), Edge(b.x, b.y, c.x, c.y), Edge(c.x, c.y, a.x, a.y)};
+
+    for (int y = minY; y <= maxY; ++y) {
+        float* row = &depth[static_cast<size_t>(y) * WIDTH];
+        const float pixelY = y + 0.5f;
+#ifdef FORESTZ_OCCLUSION_SSE
+        const __m128 offsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+        const __m128 newDepth = _mm_set1_ps(triangleDepth);
+        const __m128 zero = _mm_setzero_ps();
+        __m128 e[3];
+        __m128 step[3];
+        for (int i = 0; i < 3; ++i) {
+            const __m128 x = _mm_add_ps(_mm_set1_ps(static_cast<float>(minX)), offsets);
+            e[i] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edges[i].a), x),
+                              _mm_set1_ps(edges[i].b * pixelY + edges[i].c));
+            step[i] = _mm_set1_ps(edges[i].a * 4.0f);
+        }
+        for (int x = minX; x <= maxX; x += 4) {
+            const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e[0], zero), _mm_cmpge_ps(e[1], zero)),
+                                             _mm_cmpge_ps(e[2], zero));
+            if (_mm_movemask_ps(inside)) {
+                const __m128 current = _mm_loadu_ps(row + x);
+                const __m128 nearest = _mm_min_ps(current, newDepth);
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+            }
+            for (int i = 0; i < 3; ++i) e[i] = _mm_add_ps(e[i], step[i]);
+        }
+#else
+        for (int x = minX; x <= maxX; ++x) {
+            const float pixelX = x + 0.5f;
+            if (edges[0].at(pixelX, pixelY) >= 0.0f && edges[1].at(pixelX, pixelY) >= 0.0f &&
+                edges[2].at(pixelX, pixelY) >= 0.0f) {
+                row[x] = std::min(row[x], triangleDepth);
+            }
+        }
+#endif
+    }
+}
+
+bool OcclusionCuller::isVisible(const Ogre::AxisAlignedBox& box) const {
+    if (occluderCount == 0 || !box.isFinite()) return true;
+
+    const Ogre::Vector3* corners = box.getAllCorners();
+    float minX = FAR_DEPTH, minY = FAR_DEPTH, maxX = -FAR_DEPTH, maxY = -FAR_DEPTH;
+    float nearestDepth = FAR_DEPTH;
+    for (int i = 0; i < 8; ++i) {
+        ScreenVertex vertex;
+        if (!project(corners[i], vertex)) return true; // Traverse le plan proche
+        minX = std::min(minX, vertex.x);
+        maxX = std::max(maxX, vertex.x);
+        minY = std::min(minY, vertex.y);
+        maxY = std::max(maxY, vertex.y);
+        nearestDepth = std::min(nearestDepth, vertex.w);
+    }
+
+    // Hors de l'écran : affaire du frustum culling d'Ogre
+    int x0 = std::max(0, static_cast<int>(std::floor(minX)));
+    const int x1 = std::min(WIDTH - 1, static_cast<int>(std::ceil(maxX)));
+    const int y0 = std::max(0, static_cast<int>(std::floor(minY)));
+    const int y1 = std::min(HEIGHT - 1, static_cast<int>(std::ceil(maxY)));
+    if (x0 > x1 || y0 > y1) return true;
+    x0 &= ~3; // Tester quelques pixels de plus ne peut que rendre visible
+
+    // Visible dès qu'un pixel couvert n'a pas d'occulteur devant le point le plus proche
+    for (int y = y0; y <= y1; ++y) {
+        const float* row = &depth[static_cast<size_t>(y) * WIDTH];
+#ifdef FORESTZ_OCCLUSION_SSE
+        const __m128 boxDepth = _mm_set1_ps(nearestDepth);
+        for (int x = x0; x <= x1; x += 4) {
+            if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(row + x), boxDepth))) return true;
+        }
+#else
+        for (int x = x0; x <= x1; ++x) {
+            if (row[x] >= nearestDepth) return true;
+        }
+#endif
+    }
+    return false;
+}
+
+void OcclusionCuller::applyVisibility(Ogre::Entity* entity, bool visible) {
+    if (!entity) return;
+    ++testedCount;
+    if (!visible) {
+        ++occludedCount;
+        hasHidden = true;
+    }
+    if (entity->getVisible() != visible) entity->setVisible(visible);
+}
+
+void OcclusionCuller::showAll(EntityStore& store) {
+    store.each<SceneNodeRef>([](EntityId, SceneNodeRef& visual) {
+        if (visual.entity && !visual.entity->getVisible()) visual.entity->setVisible(true);
+    });
+    hasHidden = false;
+}
+
+void OcclusionCuller::cull(EntityStore& store, const Ogre::Camera& camera) {
+    PROFILE_SCOPE("Occlusion");
+    testedCount = 0;
+    occludedCount = 0;
+    if (!enabled) {
+        if (hasHidden) showAll(store);
+        return;
+    }
+
+    beginFrame(camera.getProjectionMatrix() * camera.getViewMatrix(), camera.getNearClipDistance());
+    const Ogre::Vector3 eye = camera.getDerivedPosition();
+
+    // Occulteurs : les troncs des arbres détaillés les plus proches
+    FrameVector<std::pair<float, Ogre::AxisAlignedBox>> candidates;
+    const float maxDistanceSq = OCCLUDER_DISTANCE * OCCLUDER_DISTANCE;
+    store.each<Tree, Transform, SceneNodeRef>([&](EntityId, Tree& tree, Transform& transform, SceneNodeRef& visual) {
+        if (!tree.detailed || !visual.entity) return;
+        const float distanceSq = eye.squaredDistance(transform.position);
+        if (distanceSq > maxDistanceSq) return;
+
+        const Ogre::AxisAlignedBox& bounds = visual.entity->getWorldBoundingBox(true);
+        if (!bounds.isFinite()) return;
+        const Ogre::Vector3 centre = bounds.getCenter();
+        const Ogre::Vector3 size = bounds.getSize();
+        const Ogre::Vector3 trunkMin(centre.x - size.x * TRUNK_WIDTH_RATIO * 0.5f, bounds.getMinimum().y,
+                                     centre.z - size.z * TRUNK_WIDTH_RATIO * 0.5f);
+        const Ogre::Vector3 trunkMax(centre.x + size.x * TRUNK_WIDTH_RATIO * 0.5f,
+                                     bounds.getMinimum().y + size.y * TRUNK_HEIGHT_RATIO,
+                                     centre.z + size.z * TRUNK_WIDTH_RATIO * 0.5f);
+        candidates.emplace_back(distanceSq, Ogre::AxisAlignedBox(trunkMin, trunkMax));
+    });
+
+    const size_t occluders = std::min(candidates.size(), MAX_OCCLUDERS);
+    std::partial_sort(candidates.begin(), candidates.begin() + occluders, candidates.end(),
+                      [](const auto& left, const auto& right) { return left.first < right.first; });
+    for (size_t i = 0; i < occluders; ++i) {
+        addOccluder(candidates[i].second);
+    }
+
+    if (occluderCount == 0) {
+        if (hasHidden) showAll(store);
+        return;
+    }
+
+    // Arbres et zombies : la boîte de l'entité attachée
+    hasHidden = false;
+    store.each<Tree, SceneNodeRef>([this](EntityId, Tree&, SceneNodeRef& visual) {
+        if (visual.entity) applyVisibility(visual.entity, isVisible(visual.entity->getWorldBoundingBox(true)));
+    });
+    store.each<Zombie, SceneNodeRef>([this](EntityId, Zombie&, SceneNodeRef& visual) {
+        if (visual.entity) applyVisibility(visual.entity, isVisible(visual.entity->getWorldBoundingBox(true)));
+    });
+}
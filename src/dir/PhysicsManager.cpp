@@ -0,0 +1,190 @@
+#include "../include/PhysicsManager.hpp"
+#include "../include/GridBroadphase.hpp"
+#include "../include/Profiler.hpp"
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+PhysicsManager::PhysicsManager()
+{
+}
+
+PhysicsManager::~PhysicsManager()
+{
+    // The world references everything else: destroy it first
+    if (dynamicsWorld) {
+        dynamicsWorld->setDebugDrawer(nullptr);
+    }
+    dynamicsWorld.reset();
+#ifdef FORESTZ_PHYSICS_MT
+    solverPool.reset();
+#endif
+    solver.reset();
+    broadphase.reset();
+    dispatcher.reset();
+    collisionConfig.reset();
+#ifdef FORESTZ_PHYSICS_MT
+    if (taskScheduler) {
+        btSetTaskScheduler(nullptr);
+        taskScheduler.reset();
+    }
+#endif
+}
+
+void PhysicsManager::removeAllCollisionObjects()
+{
+    if (!dynamicsWorld) return;
+
+    // From the back: removal swaps the last object into the freed slot
+    for (int i = dynamicsWorld->getNumCollisionObjects() - 1; i >= 0; --i) {
+        dynamicsWorld->removeCollisionObject(dynamicsWorld->getCollisionObjectArray()[i]);
+    }
+}
+
+void PhysicsManager::initialize(const PhysicsSettings& settings)
+{
+#ifdef FORESTZ_PHYSICS_MT
+    if (settings.threadCount != 1) {
+        createMultiThreadedWorld(settings);
+    } else {
+        createSingleThreadedWorld(settings);
+    }
+#else
+    if (settings.threadCount != 1) {
+        std::cerr << "Warning: built without FORESTZ_PHYSICS_MT, using the single-threaded physics world" << std::endl;
+    }
+    createSingleThreadedWorld(settings);
+#endif
+
+    dynamicsWorld->setGravity(btVector3(0, -9.8f, 0));
+    dynamicsWorld->setInternalTickCallback(&PhysicsManager::onInternalTick, this);
+}
+
+void PhysicsManager::getWorldBounds(btVector3& aabbMin, btVector3& aabbMax)
+{
+    // Plane centers reach PLANE_WIDTH / 2 and their edges half a plane further;
+    // a full plane of padding keeps bodies pushed past the edge inside the bounds
+    const float halfExtent = PLANE_WIDTH / 2.0f + PLANE_SIZE;
+    aabbMin = btVector3(-halfExtent, -500.0f, -halfExtent);
+    aabbMax = btVector3(halfExtent, 2000.0f, halfExtent);
+}
+
+bool PhysicsManager::parseBroadphase(const std::string& name, BroadphaseType& type)
+{
+    if (name == "dbvt") {
+        type = BroadphaseType::DynamicAabbTree;
+    } else if (name == "sap") {
+        type = BroadphaseType::AxisSweep;
+    } else if (name == "grid") {
+        type = BroadphaseType::Grid;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void PhysicsManager::createBroadphase(const PhysicsSettings& settings)
+{
+    btVector3 worldMin, worldMax;
+    getWorldBounds(worldMin, worldMax);
+
+    switch (settings.broadphase) {
+    case BroadphaseType::AxisSweep:
+        // 16-bit handles are enough for a full level (trees, planes, zombies and bullets)
+        broadphase = std::make_unique<btAxisSweep3>(worldMin, worldMax, 16384);
+        break;
+    case BroadphaseType::Grid:
+        broadphase = std::make_unique<GridBroadphase>(worldMin, worldMax, settings.gridCellSize);
+        break;
+    case BroadphaseType::DynamicAabbTree:
+    default:
+        broadphase = std::make_unique<btDbvtBroadphase>();
+        break;
+    }
+}
+
+void PhysicsManager::createSingleThreadedWorld(const PhysicsSettings& settings)
+{
+    collisionConfig = std::make_unique<btDefaultCollisionConfiguration>();
+    dispatcher = std::make_unique<btCollisionDispatcher>(collisionConfig.get());
+    createBroadphase(settings);
+    solver = std::make_unique<btSequentialImpulseConstraintSolver>();
+    dynamicsWorld = std::make_unique<btDiscreteDynamicsWorld>(
+        dispatcher.get(), broadphase.get(), solver.get(), collisionConfig.get());
+    threadCount = 1;
+}
+
+#ifdef FORESTZ_PHYSICS_MT
+void PhysicsManager::createMultiThreadedWorld(const PhysicsSettings& settings)
+{
+    // Bullet's scheduler is process-wide: size it to the machine (or the request)
+    taskScheduler.reset(btCreateDefaultTaskScheduler());
+    if (!taskScheduler) {
+        std::cerr << "Warning: Bullet was built without BT_THREADSAFE, using the single-threaded physics world" << std::endl;
+        createSingleThreadedWorld(settings);
+        return;
+    }
+
+    int hardwareThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int wanted = settings.threadCount > 0 ? settings.threadCount : hardwareThreads;
+    threadCount = std::min(wanted, taskScheduler->getMaxNumThreads());
+    taskScheduler->setNumThreads(threadCount);
+    btSetTaskScheduler(taskScheduler.get());
+
+    // Pools are shared between threads: give them room for a full level of zombies
+    btDefaultCollisionConstructionInfo constructionInfo;
+    constructionInfo.m_defaultMaxPersistentManifoldPoolSize = 80000;
+    constructionInfo.m_defaultMaxCollisionAlgorithmPoolSize = 80000;
+    collisionConfig = std::make_unique<btDefaultCollisionConfiguration>(constructionInfo);
+
+    dispatcher = std::make_unique<btCollisionDispatcherMt>(collisionConfig.get(), 40);
+    createBroadphase(settings);
+
+    // One solver per thread for islands solved in parallel, plus the Mt solver for large islands
+    btConstraintSolver* solvers[BT_MAX_THREAD_COUNT];
+    for (int i = 0; i < threadCount; ++i) {
+        solvers[i] = new btSequentialImpulseConstraintSolverMt();
+    }
+    solverPool = std::make_unique<btConstraintSolverPoolMt>(solvers, threadCount);
+    solver = std::make_unique<btSequentialImpulseConstraintSolverMt>();
+
+    dynamicsWorld = std::make_unique<btDiscreteDynamicsWorldMt>(
+        dispatcher.get(), broadphase.get(), solverPool.get(), solver.get(), collisionConfig.get());
+
+    std::cout << "Physics world running on " << threadCount << " threads" << std::endl;
+}
+#endif
+
+void PhysicsManager::setupDebugDrawer(Ogre::SceneManager* scnMgr)
+{
+    if (!scnMgr || !dynamicsWorld) {
+        std::cerr << "Error: SceneManager or DynamicsWorld is null in setupDebugDrawer" << std::endl;
+        return;
+    }
+
+    debugDrawer = std::make_unique<BulletDebugDrawer>(scnMgr);
+    dynamicsWorld->setDebugDrawer(debugDrawer.get());
+}
+
+int PhysicsManager::stepSimulation(float deltaTime)
+{
+    PROFILE_SCOPE("Physics");
+    if (!dynamicsWorld) return 0;
+
+    // Bullet keeps the accumulator: whole ticks are simulated, the remainder
+    // only interpolates the transforms handed to the motion states
+    return dynamicsWorld->stepSimulation(deltaTime, PHYSICS_MAX_SUBSTEPS, tickInterval);
+}
+
+void PhysicsManager::setTickRate(float ticksPerSecond)
+{
+    tickInterval = 1.0f / std::min(std::max(ticksPerSecond, MIN_TICK_RATE), MAX_TICK_RATE);
+}
+
+void PhysicsManager::onInternalTick(btDynamicsWorld* world, btScalar timeStep)
+{
+    auto* self = static_cast<PhysicsManager*>(world->getWorldUserInfo());
+    if (self && self->tickCallback) {
+        self->tickCallback(static_cast<float>(timeStep));
+    }
+}
@@ -37,7 +37,7 @@ void PlaneZ::createPlane(SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamics
             groundEntity->setCastShadows(false);
 
             // Apply the grass material to the plane
-            groundEntity->setMaterialName("Examples/Grass");
+            groundEntity->setMaterialName(GROUND_MATERIAL);
 
             // Add physics to the plane
             btCollisionShape* planeShape = new btStaticPlaneShape(btVector3(0, 1, 0), 0); // Plane along Y-axis
@@ -56,7 +56,7 @@ void PlaneZ::createPlane(SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamics
             planeBody->setFriction(1000000000.8f); 
 
             // Add the rigid body to the physics world
-            dynamicsWorld->addRigidBody(planeBody);
+            CollisionLayers::addRigidBody(dynamicsWorld, planeBody, CollisionLayer::Ground);
 
         }
     }
@@ -1,4 +1,7 @@
 #include "../include/Player.hpp"
+#include "../include/SimulationClock.hpp"
+#include "../include/Profiler.hpp"
+#include "../include/AllocationCounter.hpp"
 #include <OgreSceneManager.h>
 #include <OgreEntity.h>
 #include <OgreMaterialManager.h>
@@ -7,7 +10,7 @@
 Player::Player() : playerBody(nullptr), playerNode(nullptr), playerEntity(nullptr),
     playerAnimation(nullptr), currentAnimation(nullptr), health(100.0f), maxHealth(100.0f),
     energy(100.0f), maxEnergy(100.0f), energyRegenRate(10.0f), lastDamageTime(0.0f),
-    healthRegenDelay(0.0f) {
+    healthRegenDelay(0.0f), playerHandle{BodyHandle::Kind::Player, 0} {
 }
 
 Player::~Player() {
@@ -64,6 +67,7 @@ void Player::createCamera(SceneManager* scnMgr , Camera * cam) {
 }
 
 void Player::createPlayer(SceneManager* scnMgr, Vector3 position, btDiscreteDynamicsWorld* dynamicsWorld) {
+    MemoryScope memoryScope(MemoryTag::Player);
     if (!scnMgr || !dynamicsWorld) {
         std::cerr << "Error: SceneManager or DynamicsWorld is null in createPlayer" << std::endl;
         return;
@@ -71,10 +75,10 @@ void Player::createPlayer(SceneManager* scnMgr, Vector3 position, btDiscreteDyna
 
     // Create a new entity for the player
     try {
-        playerEntity = scnMgr->createEntity("Player", "Mesh.mesh");
+        playerEntity = scnMgr->createEntity("Player", BODY_MESH);
         
         // List all animations available in the mesh
-        std::cout << "\n=== Available Animations in Mesh.mesh ===\n";
+        std::cout << "\n=== Available Animations in " << BODY_MESH << " ===\n";
         Ogre::AnimationStateSet* animationStates = playerEntity->getAllAnimationStates();
         if (animationStates) {
             Ogre::AnimationStateIterator animationIterator = animationStates->getAnimationStateIterator();
@@ -114,11 +118,11 @@ void Player::createPlayer(SceneManager* scnMgr, Vector3 position, btDiscreteDyna
     playerNode->setOrientation(Quaternion(Degree(90), Vector3::UNIT_Y));
 
     // Apply material
-    playerEntity->setMaterialName("Ch15_body1.001");
+    playerEntity->setMaterialName(BODY_MATERIAL);
 
     // Créer et attacher le pistolet
     try {
-        Entity* gunEntity = scnMgr->createEntity("PlayerGun", "Cylinder.mesh");
+        Entity* gunEntity = scnMgr->createEntity("PlayerGun", GUN_MESH);
         if (!gunEntity) {
             std::cerr << "Failed to create gun entity" << std::endl;
             return;
@@ -154,12 +158,12 @@ void Player::createPlayer(SceneManager* scnMgr, Vector3 position, btDiscreteDyna
 
         // Appliquer un matériau métallique au pistolet
         MaterialPtr gunMaterial = MaterialManager::getSingleton().create(
-            "Material.002", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+            GUN_MATERIAL, ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
         Pass* pass = gunMaterial->getTechnique(0)->getPass(0);
         pass->setDiffuse(0.7f, 0.7f, 0.7f, 1.0f);  // Gris métallique
         pass->setSpecular(1.0f, 1.0f, 1.0f, 1.0f);  // Reflet brillant
         pass->setShininess(80.0f);  // Surface très brillante
-        gunEntity->setMaterialName("Material.002");
+        gunEntity->setMaterialName(GUN_MATERIAL);
 
         std::cout << "Gun successfully attached to player" << std::endl;
     } catch (const std::exception& e) {
@@ -178,7 +182,10 @@ void Player::createPlayer(SceneManager* scnMgr, Vector3 position, btDiscreteDyna
     btScalar mass = 150.0f;
     btVector3 localInertia(0, 0, 0);
     playerShape->calculateLocalInertia(mass, localInertia);
-    btDefaultMotionState* motionState = new btDefaultMotionState(playerTransform);
+    // Le corps pilote directement la position du nœud (l'orientation reste contrôlée par les entrées)
+    SceneNodeMotionState* motionState = new SceneNodeMotionState(playerNode, playerTransform);
+    motionState->setNodeOffset(Vector3(0, 20.0f, 0));
+    motionState->setSyncOrientation(false);
     btRigidBody::btRigidBodyConstructionInfo rbInfo(mass, motionState, playerShape, localInertia);
     
     // Ajuster les paramètres de construction avant la création du corps rigide
@@ -208,8 +215,11 @@ void Player::createPlayer(SceneManager* scnMgr, Vector3 position, btDiscreteDyna
     // Contraintes de mouvement supplémentaires
     playerBody->setLinearFactor(btVector3(1, 0, 1));  // Bloque le mouvement vertical
 
+    // Identifier le joueur dans les événements de contact
+    playerBody->setUserPointer(&playerHandle);
+
     // Add the rigid body to the physics world
-    dynamicsWorld->addRigidBody(playerBody);
+    CollisionLayers::addRigidBody(dynamicsWorld, playerBody, CollisionLayer::Player);
 
     // Définir les flags de collision pour améliorer la détection de contact
     playerBody->setCollisionFlags(playerBody->getCollisionFlags() | btCollisionObject::CF_CUSTOM_MATERIAL_CALLBACK);
@@ -236,7 +246,27 @@ void Player::createPlayer(SceneManager* scnMgr, Vector3 position, btDiscreteDyna
     }
 }
 
+MaterialPtr Player::getBulletMaterial() {
+    MaterialManager& materialManager = MaterialManager::getSingleton();
+    MaterialPtr bulletMaterial = materialManager.getByName(BULLET_MATERIAL);
+    if (bulletMaterial) return bulletMaterial;
+
+    bulletMaterial = materialManager.create(BULLET_MATERIAL, ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    Pass* pass = bulletMaterial->getTechnique(0)->getPass(0);
+    pass->setDiffuse(1.0f, 0.0f, 0.0f, 1.0f);  // Rouge
+    pass->setAmbient(0.5f, 0.0f, 0.0f);        // Rouge sombre
+    pass->setSpecular(1.0f, 1.0f, 1.0f, 1.0f); // Reflet blanc
+    pass->setShininess(32.0f);
+
+    // Activer la profondeur
+    pass->setDepthCheckEnabled(true);
+    pass->setDepthWriteEnabled(true);
+    return bulletMaterial;
+}
+
 void Player::shoot(SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld, Vector3 direction) {
+    MemoryScope memoryScope(MemoryTag::Player);
+    PROFILE_SCOPE("Shoot");
     // Créer un nom unique pour la balle
     static unsigned long bulletCounter = 0;
     String uniqueName = "Bullet_" + std::to_string(++bulletCounter) + "_" + 
@@ -249,22 +279,8 @@ void Player::shoot(SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld,
     bulletNode->attachObject(bulletEntity);
     bulletNode->setScale(0.05f, 0.05f, 0.05f);  // Réduit de moitié (était 0.1f)
     
-    // Créer un matériau personnalisé pour la balle
-    MaterialPtr bulletMaterial = MaterialManager::getSingleton().create(
-        uniqueName + "_material", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME
-    );
-    Pass* pass = bulletMaterial->getTechnique(0)->getPass(0);
-    pass->setDiffuse(1.0f, 0.0f, 0.0f, 1.0f);  // Rouge
-    pass->setAmbient(0.5f, 0.0f, 0.0f);        // Rouge sombre
-    pass->setSpecular(1.0f, 1.0f, 1.0f, 1.0f); // Reflet blanc
-    pass->setShininess(32.0f);
-    
-    // Activer la profondeur
-    pass->setDepthCheckEnabled(true);
-    pass->setDepthWriteEnabled(true);
-    
-    // Appliquer le matériau à la balle
-    bulletEntity->setMaterialName(uniqueName + "_material");
+    // Matériau commun : ses shaders sont préparés au chargement, pas au premier tir
+    bulletEntity->setMaterial(getBulletMaterial());
     
     // Position initiale à hauteur de la tête (environ 50 unités au-dessus de la position du joueur)
     Vector3 startPosition = playerNode->getPosition() + Vector3(0, 50, 0);
@@ -288,7 +304,9 @@ void Player::shoot(SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld,
     btVector3 localInertia(0, 0, 0);
     sphereShape->calculateLocalInertia(mass, localInertia);
     
-    btDefaultMotionState* motionState = new btDefaultMotionState(startTransform);
+    // La position interpolée de la balle est écrite directement dans son nœud
+    SceneNodeMotionState* motionState = new SceneNodeMotionState(bulletNode, startTransform);
+    motionState->setSyncOrientation(false);
     btRigidBody::btRigidBodyConstructionInfo rbInfo(mass, motionState, sphereShape, localInertia);
     
     // Paramètres pour une balle réelle
@@ -318,14 +336,11 @@ void Player::shoot(SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld,
     // Configurer les flags de collision pour une balle réelle
     bulletBody->setCollisionFlags(bulletBody->getCollisionFlags() | btCollisionObject::CF_CUSTOM_MATERIAL_CALLBACK);
     
+    // Identifier la balle dans les événements de contact
+    bulletBody->setUserPointer(new BodyHandle{BodyHandle::Kind::Bullet, bullets.size()});
+
     // Ajouter la balle au monde physique
-    dynamicsWorld->addRigidBody(bulletBody);
-    
-    // Forcer une mise à jour immédiate de la position
-    btTransform transform;
-    bulletBody->getMotionState()->getWorldTransform(transform);
-    btVector3 pos = transform.getOrigin();
-    bulletNode->setPosition(Vector3(pos.x(), pos.y(), pos.z()));
+    CollisionLayers::addRigidBody(dynamicsWorld, bulletBody, CollisionLayer::Bullet);
     
     // Stocker la balle
     bullets.push_back(std::make_pair(bulletBody, bulletNode));
@@ -355,35 +370,19 @@ void Player::renderDebug(btIDebugDraw* debugDrawer) {
 }
 
 void Player::updateBulletPositions(btDiscreteDynamicsWorld* dynamicsWorld) {
+    PROFILE_SCOPE("Bullets");
     for (size_t i = 0; i < bullets.size(); /* increment handled in loop */) {
         btRigidBody* bulletBody = bullets[i].first;
         SceneNode* bulletNode = bullets[i].second;
 
         if (bulletBody && bulletNode) {
-            btTransform transform;
-            bulletBody->getMotionState()->getWorldTransform(transform);
-            btVector3 pos = transform.getOrigin();
-            bulletNode->setPosition(Vector3(pos.x(), pos.y(), pos.z()));
-
-            // Calculate distance from player
-            Vector3 bulletPos(pos.x(), pos.y(), pos.z());
+            // The motion state already moved the node: only the range check remains
             Vector3 playerPos = playerNode->getPosition();
-            float distance = bulletPos.distance(playerPos);
+            float distance = bulletNode->getPosition().distance(playerPos);
 
-            // If bullet is too far, remove it
+            // If bullet is too far, remove it (the last bullet is moved into slot i)
             if (distance > BULLET_MAX_DISTANCE) {
-                // Remove bullet from physics world
-                bulletBody->getMotionState()->getWorldTransform(transform);
-                dynamicsWorld->removeRigidBody(bulletBody);
-                delete bulletBody->getMotionState();
-                delete bulletBody->getCollisionShape();
-                delete bulletBody;
-
-                // Remove bullet from scene
-                bulletNode->getCreator()->destroySceneNode(bulletNode);
-
-                // Remove from vector
-                bullets.erase(bullets.begin() + i);
+                removeBullet(i, dynamicsWorld);
             } else {
                 ++i; // Only increment if we didn't remove the bullet
             }
@@ -406,14 +405,20 @@ void Player::removeBullet(size_t index, btDiscreteDynamicsWorld* dynamicsWorld)
 
     // Remove the bullet from the physics world
     dynamicsWorld->removeRigidBody(bulletBody);
+    delete static_cast<BodyHandle*>(bulletBody->getUserPointer());
     delete bulletBody->getMotionState();
+    delete bulletBody->getCollisionShape();
     delete bulletBody;
 
     // Remove the bullet from the scene
     bulletNode->getCreator()->destroySceneNode(bulletNode);
 
-    // Remove the bullet from the vector
-    bullets.erase(bullets.begin() + index);
+    // Swap with the last bullet so removal stays O(1), and keep its handle in sync
+    if (index != bullets.size() - 1) {
+        bullets[index] = bullets.back();
+        static_cast<BodyHandle*>(bullets[index].first->getUserPointer())->index = index;
+    }
+    bullets.pop_back();
 }
 
 void Player::updateAnimations(float deltaTime) {
@@ -450,7 +455,7 @@ void Player::setAnimation(const std::string& animName) {
 }
 
 void Player::takeDamage(float damage) {
-    float currentTime = Ogre::Root::getSingleton().getTimer()->getMilliseconds() / 1000.0f;
+    float currentTime = SimulationClock::now();
     
     // Vérifier le délai entre les dégâts
     if (currentTime - lastDamageTime < DAMAGE_COOLDOWN) {
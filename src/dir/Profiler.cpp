@@ -0,0 +1,206 @@
+#include "../include/Profiler.hpp"
+#include "../include/AllocationCounter.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+Profiler::ThreadRing* Profiler::threadRing()
+{
+    thread_local ThreadRing* ring = nullptr;
+    if (!ring) {
+        ring = new ThreadRing();
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        ring->threadId = static_cast<uint32_t>(rings.size() + 1);
+        rings.push_back(ring);
+    }
+    return ring;
+}
+
+void Profiler::record(const char* name, uint64_t start, uint64_t end)
+{
+    ThreadRing* ring = threadRing();
+    uint64_t index = ring->written.load(std::memory_order_relaxed);
+    ring->events[index % RING_SIZE] = {name, start, end, ring->threadId};
+    ring->written.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::collect()
+{
+    MemoryScope memoryScope(MemoryTag::Profiler);
+    std::vector<ThreadRing*> currentRings;
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        currentRings = rings;
+    }
+
+    static std::vector<ProfileEvent> drained; // Reused: collect() itself should not allocate every frame
+    for (ThreadRing* ring : currentRings) {
+        uint64_t written = ring->written.load(std::memory_order_acquire);
+        // The owner lapped us since the last collect: the oldest events are gone
+        if (written - ring->read > RING_SIZE) {
+            ring->read = written - RING_SIZE;
+        }
+
+        drained.clear();
+        for (uint64_t i = ring->read; i < written; ++i) {
+            drained.push_back(ring->events[i % RING_SIZE]);
+        }
+
+        // Events overwritten while they were being copied may be torn: drop them
+        uint64_t writtenAfter = ring->written.load(std::memory_order_acquire);
+        size_t torn = 0;
+        if (writtenAfter - ring->read > RING_SIZE) {
+            torn = static_cast<size_t>(std::min<uint64_t>(writtenAfter - RING_SIZE - ring->read, drained.size()));
+        }
+        ring->read = written;
+
+        for (size_t i = torn; i < drained.size(); ++i) {
+            const ProfileEvent& event = drained[i];
+
+            auto cached = windowByName.find(event.name);
+            ScopeWindow* window;
+            if (cached != windowByName.end()) {
+                window = cached->second;
+            } else {
+                // The same name may come from several literals (one per translation unit)
+                window = &windows[event.name];
+                windowByName[event.name] = window;
+            }
+
+            double milliseconds = (event.end - event.start) / 1.0e6;
+            if (window->samples.size() < WINDOW_SIZE) {
+                window->samples.push_back(milliseconds);
+            } else {
+                window->samples[window->next] = milliseconds;
+            }
+            window->next = (window->next + 1) % WINDOW_SIZE;
+
+            if (capturing && capture.size() < MAX_CAPTURE) {
+                capture.push_back(event);
+            }
+            if (historyDuration > 0) {
+                // Full: overwrite the oldest event
+                history[(historyFirst + historyCount) % HISTORY_SIZE] = event;
+                if (historyCount < HISTORY_SIZE) {
+                    ++historyCount;
+                } else {
+                    historyFirst = (historyFirst + 1) % HISTORY_SIZE;
+                }
+            }
+        }
+    }
+
+    // Rings are drained in turn, so the history is only roughly sorted: trim by age
+    if (historyDuration > 0) {
+        const uint64_t current = now();
+        while (historyCount > 0 && history[historyFirst].end + historyDuration < current) {
+            historyFirst = (historyFirst + 1) % HISTORY_SIZE;
+            --historyCount;
+        }
+    }
+}
+
+void Profiler::setHistoryDuration(float seconds)
+{
+    MemoryScope memoryScope(MemoryTag::Profiler);
+    historyDuration = seconds > 0.0f ? static_cast<uint64_t>(seconds * 1.0e9) : 0;
+    historyFirst = 0;
+    historyCount = 0;
+    if (historyDuration == 0) {
+        history.clear();
+        history.shrink_to_fit();
+    } else {
+        history.resize(HISTORY_SIZE);
+    }
+}
+
+std::vector<ProfileEvent> Profiler::getHistory()
+{
+    std::vector<ProfileEvent> events;
+    events.reserve(historyCount);
+    for (size_t i = 0; i < historyCount; ++i) {
+        events.push_back(history[(historyFirst + i) % HISTORY_SIZE]);
+    }
+    return events;
+}
+
+std::vector<ProfileScopeStats> Profiler::getStats()
+{
+    std::vector<ProfileScopeStats> stats;
+    std::vector<double> sorted;
+
+    for (const auto& entry : windows) {
+        const std::vector<double>& samples = entry.second.samples;
+        if (samples.empty()) continue;
+
+        sorted = samples;
+        size_t p99Index = static_cast<size_t>(std::ceil(sorted.size() * 0.99)) - 1;
+        std::nth_element(sorted.begin(), sorted.begin() + p99Index, sorted.end());
+
+        double total = 0.0;
+        double maximum = 0.0;
+        for (double sample : samples) {
+            total += sample;
+            maximum = std::max(maximum, sample);
+        }
+
+        stats.push_back({entry.first, total / samples.size(), sorted[p99Index], maximum, samples.size()});
+    }
+
+    std::sort(stats.begin(), stats.end(),
+              [](const ProfileScopeStats& lhs, const ProfileScopeStats& rhs) { return lhs.name < rhs.name; });
+    return stats;
+}
+
+void Profiler::startCapture()
+{
+    if (capturing) return;
+    capture.clear();
+    capturing = true;
+    acquire();
+}
+
+bool Profiler::stopCapture(const std::string& path)
+{
+    if (!capturing) return false;
+    capturing = false;
+    release();
+
+    bool written = writeTrace(path, capture);
+    if (written) {
+        std::cout << "Profiler: " << capture.size() << " events written to " << path << std::endl;
+    }
+    capture.clear();
+    capture.shrink_to_fit();
+    return written;
+}
+
+bool Profiler::openTrace(const std::string& path, std::ofstream& file)
+{
+    file.open(path);
+    if (!file) {
+        std::cerr << "Error: cannot write trace " << path << std::endl;
+        return false;
+    }
+
+    // Chrome trace event format: complete events ("X") and counters ("C"), times in microseconds
+    file << std::fixed << std::setprecision(3);
+    file << "{\"traceEvents\":[\n";
+    return true;
+}
+
+void Profiler::writeTraceEvent(std::ofstream& file, const ProfileEvent& event, bool first)
+{
+    file << (first ? "" : ",\n")
+         << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+         << ",\"ts\":" << event.start / 1000.0 << ",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+}
+
+void Profiler::writeTraceCounter(std::ofstream& file, const ProfileCounterSample& sample, bool first)
+{
+    file << (first ? "" : ",\n")
+         << "{\"name\":\"" << sample.name << "\",\"ph\":\"C\",\"pid\":1"
+         << ",\"ts\":" << sample.time / 1000.0 << ",\"args\":{\"value\":" << sample.value << "}}";
+}
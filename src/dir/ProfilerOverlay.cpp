@@ -0,0 +1,124 @@
+#include "../include/ProfilerOverlay.hpp"
+#include "../include/Profiler.hpp"
+#include "../include/AllocationCounter.hpp"
+#include "../include/FrameArena.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+ProfilerOverlay::ProfilerOverlay()
+    : overlay(nullptr)
+    , panel(nullptr)
+    , text(nullptr)
+    , visible(false)
+    , refreshTimer(0.0f)
+    , lastAllocationCount(0)
+    , intervalAllocations(0)
+    , intervalMaxAllocations(0)
+    , intervalFrames(0)
+{
+}
+
+ProfilerOverlay::~ProfilerOverlay() {
+    if (visible) {
+        Profiler::release();
+    }
+    Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
+    if (text) overlayManager.destroyOverlayElement(text);
+    if (panel) overlayManager.destroyOverlayElement(panel);
+    if (overlay) overlayManager.destroy(overlay);
+}
+
+void ProfilerOverlay::initialize() {
+    MemoryScope memoryScope(MemoryTag::Interface);
+    try {
+        Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
+        overlay = overlayManager.create("ProfilerOverlay");
+
+        panel = static_cast<Ogre::OverlayContainer*>(
+            overlayManager.createOverlayElement("Panel", "ProfilerPanel"));
+        panel->setMetricsMode(Ogre::GMM_PIXELS);
+        panel->setPosition(10, 10);
+        panel->setDimensions(420, 300);
+        panel->setMaterialName("Core/StatsBlockCenter");
+
+        text = static_cast<Ogre::TextAreaOverlayElement*>(
+            overlayManager.createOverlayElement("TextArea", "ProfilerText"));
+        text->setMetricsMode(Ogre::GMM_PIXELS);
+        text->setPosition(8, 8);
+        text->setCharHeight(16);
+        text->setFontName("SdkTrays/Value");
+        text->setColour(Ogre::ColourValue(0.9f, 1.0f, 0.9f, 1.0f));
+
+        panel->addChild(text);
+        overlay->add2D(panel);
+        overlay->setZOrder(400);  // Au-dessus de tout le reste
+        overlay->hide();
+    } catch (const Ogre::Exception& e) {
+        std::cerr << "Failed to initialize profiler overlay: " << e.what() << std::endl;
+    }
+}
+
+void ProfilerOverlay::toggle() {
+    visible = !visible;
+    if (visible) {
+        Profiler::acquire();
+    } else {
+        Profiler::release();
+    }
+    if (!overlay) return;
+
+    if (visible) {
+        refreshTimer = 0.0f;
+        lastAllocationCount = 0;
+        overlay->show();
+    } else {
+        overlay->hide();
+    }
+}
+
+void ProfilerOverlay::update(float deltaTime) {
+    if (!visible || !text) return;
+
+    // The first frame after showing the panel also counts its creation: skipped
+    const uint64_t allocationCount = AllocationCounter::getTotals().count;
+    if (lastAllocationCount != 0) {
+        const uint64_t frameAllocations = allocationCount - lastAllocationCount;
+        intervalAllocations += frameAllocations;
+        intervalMaxAllocations = std::max(intervalMaxAllocations, frameAllocations);
+        ++intervalFrames;
+    }
+    lastAllocationCount = allocationCount;
+
+    refreshTimer -= deltaTime;
+    if (refreshTimer > 0.0f) return;
+    refreshTimer = REFRESH_INTERVAL;
+
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(2);
+    stream << std::left << std::setw(14) << "Scope" << std::right
+           << std::setw(8) << "avg" << std::setw(8) << "p99" << std::setw(8) << "max" << "  (ms)\n";
+    for (const ProfileScopeStats& stats : Profiler::getStats()) {
+        stream << std::left << std::setw(14) << stats.name << std::right
+               << std::setw(8) << stats.averageMs << std::setw(8) << stats.p99Ms
+               << std::setw(8) << stats.maxMs << "\n";
+    }
+    const FrameArena& arena = FrameArena::get();
+#ifdef FORESTZ_ALLOC_TRACKING
+    stream << "\nHeap allocs/frame " << std::setprecision(1)
+           << (intervalFrames ? static_cast<double>(intervalAllocations) / intervalFrames : 0.0)
+           << " avg, " << intervalMaxAllocations << " max";
+#else
+    // Sans FORESTZ_ALLOC_TRACKING les compteurs restent à 0 : ne pas afficher un faux zéro
+    stream << "\nHeap allocs/frame: tracking off";
+#endif
+    stream << "\nFrame arena " << arena.getPeak() / 1024 << " / " << arena.getCapacity() / 1024 << " KB";
+    intervalAllocations = 0;
+    intervalMaxAllocations = 0;
+    intervalFrames = 0;
+
+    if (Profiler::isCapturing()) {
+        stream << "\n[capture en cours]";
+    }
+    text->setCaption(stream.str());
+}
@@ -0,0 +1,71 @@
+#include "../include/QualityGovernor.hpp"
+#include "../include/lib.hpp"
+#include <algorithm>
+
+std::vector<QualityLevel> QualityGovernor::defaultLevels() {
+    // Le niveau 2 reprend les anciennes valeurs fixes (LOD à DISTANCE_RENDER_TREE + 500, ombres du niveau)
+    return {
+        {DISTANCE_RENDER_TREE - 800.0f, 3000.0f, 0.33f, 15.0f},
+        {DISTANCE_RENDER_TREE - 200.0f, 4500.0f, 0.67f, 30.0f},
+        {DISTANCE_RENDER_TREE + 500.0f, 0.0f, 1.0f, 0.0f},
+        {DISTANCE_RENDER_TREE + 1000.0f, 0.0f, 1.0f, 0.0f}
+    };
+}
+
+QualityGovernor::QualityGovernor(const GovernorSettings& settings, std::vector<QualityLevel> qualityLevels,
+                                 size_t initialLevel)
+    : settings(settings)
+    , levels(qualityLevels.empty() ? defaultLevels() : std::move(qualityLevels))
+    , level(std::min(initialLevel, levels.size() - 1))
+    , smoothedMs(0.0f)
+    , overSeconds(0.0f)
+    , underSeconds(0.0f)
+    , settleSeconds(settings.settleSeconds)
+    , hasSample(false)
+{
+}
+
+void QualityGovernor::setLevel(size_t newLevel) {
+    level = std::min(newLevel, levels.size() - 1);
+    overSeconds = 0.0f;
+    underSeconds = 0.0f;
+    settleSeconds = settings.settleSeconds;
+}
+
+bool QualityGovernor::update(float frameSeconds) {
+    frameSeconds = std::min(std::max(frameSeconds, 0.0f), settings.maxFrameSeconds);
+    const float frameMs = frameSeconds * 1000.0f;
+    if (!hasSample) {
+        smoothedMs = frameMs;
+        hasSample = true;
+    } else {
+        smoothedMs += (frameMs - smoothedMs) * settings.smoothing;
+    }
+
+    // Laisser la moyenne refléter le niveau qui vient d'être appliqué
+    if (settleSeconds > 0.0f) {
+        settleSeconds -= frameSeconds;
+        return false;
+    }
+
+    if (smoothedMs > settings.targetMs * settings.downgradeRatio) {
+        overSeconds += frameSeconds;
+        underSeconds = 0.0f;
+    } else if (smoothedMs < settings.targetMs * settings.upgradeRatio) {
+        underSeconds += frameSeconds;
+        overSeconds = 0.0f;
+    } else {
+        overSeconds = 0.0f;
+        underSeconds = 0.0f;
+    }
+
+    if (overSeconds >= settings.downgradeSeconds && level > 0) {
+        setLevel(level - 1);
+        return true;
+    }
+    if (underSeconds >= settings.upgradeSeconds && level + 1 < levels.size()) {
+        setLevel(level + 1);
+        return true;
+    }
+    return false;
+}
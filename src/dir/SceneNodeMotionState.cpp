@@ -0,0 +1,57 @@
+#include "../include/SceneNodeMotionState.hpp"
+
+std::atomic<TransformRecorder*> SceneNodeMotionState::recorder{nullptr};
+
+SceneNodeMotionState::SceneNodeMotionState(Ogre::SceneNode* node, const btTransform& startTransform)
+    : recorderSlot(-1)
+    , node(node)
+    , transform(startTransform)
+    , nodeOffset(Ogre::Vector3::ZERO)
+    , syncOrientation(true)
+    , lockHeight(false)
+{
+}
+
+SceneNodeMotionState::~SceneNodeMotionState()
+{
+    TransformRecorder* currentRecorder = recorder.load();
+    if (currentRecorder && recorderSlot >= 0) {
+        currentRecorder->release(recorderSlot);
+    }
+}
+
+void SceneNodeMotionState::getWorldTransform(btTransform& worldTrans) const
+{
+    worldTrans = transform;
+}
+
+void SceneNodeMotionState::setWorldTransform(const btTransform& worldTrans)
+{
+    // Nothing moved since the last synchronization: leave the node clean
+    if (worldTrans == transform) return;
+    transform = worldTrans;
+
+    if (!node) return;
+
+    const btVector3& origin = worldTrans.getOrigin();
+    Ogre::Vector3 position(origin.x(), origin.y(), origin.z());
+    position -= nodeOffset;
+
+    if (TransformRecorder* currentRecorder = recorder.load()) {
+        btQuaternion rotation = worldTrans.getRotation();
+        recorderSlot = currentRecorder->record(recorderSlot, node, position,
+                                        Ogre::Quaternion(rotation.w(), rotation.x(), rotation.y(), rotation.z()),
+                                        syncOrientation, lockHeight);
+        return;
+    }
+
+    if (lockHeight) {
+        position.y = node->getPosition().y;
+    }
+    node->setPosition(position);
+
+    if (syncOrientation) {
+        btQuaternion rotation = worldTrans.getRotation();
+        node->setOrientation(rotation.w(), rotation.x(), rotation.y(), rotation.z());
+    }
+}
@@ -0,0 +1,147 @@
+#include "../include/ScreenQuadBatch.hpp"
+#include <OgreOverlayManager.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+ScreenQuadBatch::ScreenQuadBatch()
+    : sceneManager(nullptr)
+    , object(nullptr)
+    , quadCount(0)
+    , lastCount(0)
+    , dirty(true)
+    , viewportWidth(0)
+    , viewportHeight(0)
+{
+}
+
+ScreenQuadBatch::~ScreenQuadBatch() {
+    if (object && sceneManager) {
+        sceneManager->destroyManualObject(object);
+    }
+}
+
+bool ScreenQuadBatch::initialize(Ogre::SceneManager* scnMgr, const Ogre::String& name, Ogre::ushort renderPriority) {
+    sceneManager = scnMgr;
+    try {
+        // Coordonnées déjà normalisées : ni vue ni projection, jamais éliminé par le frustum
+        object = scnMgr->createManualObject(name);
+        object->setDynamic(true);
+        object->setUseIdentityProjection(true);
+        object->setUseIdentityView(true);
+        object->setBoundingBox(Ogre::AxisAlignedBox::BOX_INFINITE);
+        object->setCastShadows(false);
+        object->setRenderQueueGroupAndPriority(Ogre::RENDER_QUEUE_OVERLAY, renderPriority);
+        scnMgr->getRootSceneNode()->attachObject(object);
+    } catch (const Ogre::Exception& e) {
+        std::cerr << "Failed to create screen quad batch " << name << ": " << e.what() << std::endl;
+        object = nullptr;
+        return false;
+    }
+    return true;
+}
+
+size_t ScreenQuadBatch::addQuad(float left, float top, float width, float height, const Ogre::ColourValue& colour) {
+    // Après clear(), les anciens rectangles sont réécrits en place : identiques, ils ne salissent rien
+    if (quadCount == quads.size()) {
+        quads.push_back({0, 0, 0, 0, colour, true});
+        dirty = true;
+    }
+    const size_t quad = quadCount++;
+    setRect(quad, left, top, width, height);
+    setColour(quad, colour);
+    setQuadVisible(quad, true);
+    return quad;
+}
+
+void ScreenQuadBatch::setRect(size_t quad, float left, float top, float width, float height) {
+    // Pixels entiers : les petites variations ne provoquent pas de mise à jour
+    const float snappedLeft = std::round(left);
+    const float snappedTop = std::round(top);
+    const float snappedRight = snappedLeft + std::round(width);
+    const float snappedBottom = snappedTop + std::round(height);
+
+    Quad& target = quads[quad];
+    if (target.left == snappedLeft && target.top == snappedTop &&
+        target.right == snappedRight && target.bottom == snappedBottom) return;
+
+    target.left = snappedLeft;
+    target.top = snappedTop;
+    target.right = snappedRight;
+    target.bottom = snappedBottom;
+    dirty = true;
+}
+
+void ScreenQuadBatch::setColour(size_t quad, const Ogre::ColourValue& colour) {
+    if (quads[quad].colour == colour) return;
+    quads[quad].colour = colour;
+    dirty = true;
+}
+
+void ScreenQuadBatch::setQuadVisible(size_t quad, bool visible) {
+    if (quads[quad].visible == visible) return;
+    quads[quad].visible = visible;
+    dirty = true;
+}
+
+void ScreenQuadBatch::clear() {
+    quadCount = 0;
+}
+
+void ScreenQuadBatch::setVisible(bool visible) {
+    if (object) object->setVisible(visible);
+}
+
+bool ScreenQuadBatch::flush() {
+    if (!object) return false;
+
+    Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
+    const int width = std::max(1, overlayManager.getViewportWidth());
+    const int height = std::max(1, overlayManager.getViewportHeight());
+    if (quadCount != lastCount) {
+        lastCount = quadCount;
+        dirty = true;
+    }
+    if (!dirty && width == viewportWidth && height == viewportHeight) return false;
+    viewportWidth = width;
+    viewportHeight = height;
+    dirty = false;
+
+    // Pixels -> coordonnées normalisées de l'écran
+    const float toNdcX = 2.0f / width;
+    const float toNdcY = 2.0f / height;
+
+    // Le tampon est réutilisé tant qu'il est assez grand : pas d'allocation en régime établi
+    if (object->getNumSections() == 0) {
+        object->estimateVertexCount(quadCount * 4);
+        object->estimateIndexCount(quadCount * 6);
+        object->begin(MATERIAL, Ogre::RenderOperation::OT_TRIANGLE_LIST);
+    } else {
+        object->beginUpdate(0);
+    }
+
+    uint32_t vertexCount = 0;
+    for (size_t i = 0; i < quadCount; ++i) {
+        const Quad& quad = quads[i];
+        if (!quad.visible || quad.right <= quad.left || quad.bottom <= quad.top) continue;
+
+        const float left = quad.left * toNdcX - 1.0f;
+        const float right = quad.right * toNdcX - 1.0f;
+        const float top = 1.0f - quad.top * toNdcY;
+        const float bottom = 1.0f - quad.bottom * toNdcY;
+
+        object->position(left, top, 0.0f);
+        object->colour(quad.colour);
+        object->position(left, bottom, 0.0f);
+        object->colour(quad.colour);
+        object->position(right, bottom, 0.0f);
+        object->colour(quad.colour);
+        object->position(right, top, 0.0f);
+        object->colour(quad.colour);
+        object->quad(vertexCount, vertexCount + 1, vertexCount + 2, vertexCount + 3);
+        vertexCount += 4;
+    }
+
+    object->end();
+    return true;
+}
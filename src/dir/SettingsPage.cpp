@@ -0,0 +1,145 @@
+#include "../include/SettingsPage.hpp"
+#include <iostream>
+
+namespace {
+    const OgreBites::TrayLocation PAGE_LOCATION = OgreBites::TL_RIGHT;
+    const Ogre::Real PAGE_WIDTH = 320;
+    const Ogre::Real VALUE_WIDTH = 70;
+}
+
+SettingsPage::SettingsPage(OgreBites::TrayManager* trayManager, GameSettings& gameSettings)
+    : trayMgr(trayManager)
+    , settings(gameSettings)
+    , previousListener(nullptr)
+    , visible(false)
+    , cursorWasVisible(false)
+    , presetMenu(nullptr)
+    , treeCountSlider(nullptr)
+    , drawDistanceSlider(nullptr)
+    , shadowMenu(nullptr)
+    , zombieCapSlider(nullptr)
+    , physicsRateSlider(nullptr)
+    , vsyncBox(nullptr)
+    , applyButton(nullptr)
+    , closeButton(nullptr)
+{
+}
+
+SettingsPage::~SettingsPage()
+{
+    hide();
+}
+
+void SettingsPage::show()
+{
+    if (visible || !trayMgr) return;
+
+    appliedPreset = settings.getPresetName();
+    createWidgets();
+    showPreset(settings.getPreset());
+
+    // La page reçoit les événements de ses widgets tant qu'elle est ouverte
+    previousListener = trayMgr->getListener();
+    trayMgr->setListener(this);
+    cursorWasVisible = trayMgr->isCursorVisible();
+    trayMgr->showCursor();
+    visible = true;
+}
+
+void SettingsPage::hide()
+{
+    if (!visible) return;
+
+    settings.selectPreset(appliedPreset);
+    destroyWidgets();
+    trayMgr->setListener(previousListener);
+    if (!cursorWasVisible) {
+        trayMgr->hideCursor();
+    }
+    visible = false;
+}
+
+void SettingsPage::createWidgets()
+{
+    presetMenu = trayMgr->createThickSelectMenu(PAGE_LOCATION, "Settings/Preset", "Préréglage", PAGE_WIDTH, 5,
+                                                settings.getPresetNames());
+    treeCountSlider = trayMgr->createThickSlider(PAGE_LOCATION, "Settings/TreeCount", "Arbres", PAGE_WIDTH,
+                                                 VALUE_WIDTH, 0, 2000, 41);
+    drawDistanceSlider = trayMgr->createThickSlider(PAGE_LOCATION, "Settings/DrawDistance",
+                                                    "Distance des arbres (0 : tout)", PAGE_WIDTH, VALUE_WIDTH,
+                                                    0, 10000, 21);
+    shadowMenu = trayMgr->createThickSelectMenu(PAGE_LOCATION, "Settings/Shadows", "Ombres", PAGE_WIDTH, 4,
+                                                {"off", "low", "medium", "high"});
+    zombieCapSlider = trayMgr->createThickSlider(PAGE_LOCATION, "Settings/ZombieCap", "Zombies max", PAGE_WIDTH,
+                                                 VALUE_WIDTH, 0, 500, 51);
+    physicsRateSlider = trayMgr->createThickSlider(PAGE_LOCATION, "Settings/PhysicsRate", "Physique (Hz)",
+                                                   PAGE_WIDTH, VALUE_WIDTH, 20, 240, 12);
+    vsyncBox = trayMgr->createCheckBox(PAGE_LOCATION, "Settings/VSync", "Synchronisation verticale", PAGE_WIDTH);
+    applyButton = trayMgr->createButton(PAGE_LOCATION, "Settings/Apply", "Appliquer", PAGE_WIDTH);
+    closeButton = trayMgr->createButton(PAGE_LOCATION, "Settings/Close", "Fermer", PAGE_WIDTH);
+}
+
+void SettingsPage::destroyWidgets()
+{
+    // Détruits en fin d'image par le TrayManager : sûr depuis un de leurs propres événements
+    OgreBites::Widget* widgets[] = {presetMenu, treeCountSlider, drawDistanceSlider, shadowMenu, zombieCapSlider,
+                                    physicsRateSlider, vsyncBox, applyButton, closeButton};
+    for (OgreBites::Widget* widget : widgets) {
+        if (widget) trayMgr->destroyWidget(widget);
+    }
+    presetMenu = nullptr;
+    treeCountSlider = nullptr;
+    drawDistanceSlider = nullptr;
+    shadowMenu = nullptr;
+    zombieCapSlider = nullptr;
+    physicsRateSlider = nullptr;
+    vsyncBox = nullptr;
+    applyButton = nullptr;
+    closeButton = nullptr;
+}
+
+void SettingsPage::showPreset(const QualityPreset& preset)
+{
+    // Sans notification : seul "Appliquer" modifie le préréglage
+    presetMenu->selectItem(settings.getPresetName(), false);
+    treeCountSlider->setValue(static_cast<Ogre::Real>(preset.treeCount), false);
+    drawDistanceSlider->setValue(preset.treeDrawDistance, false);
+    shadowMenu->selectItem(ShadowSystem::getQualityName(preset.shadows), false);
+    zombieCapSlider->setValue(static_cast<Ogre::Real>(preset.zombieCap), false);
+    physicsRateSlider->setValue(preset.physicsRate, false);
+    vsyncBox->setChecked(preset.vsync, false);
+}
+
+void SettingsPage::readWidgets(QualityPreset& preset) const
+{
+    preset.treeCount = static_cast<int>(treeCountSlider->getValue());
+    preset.treeDrawDistance = drawDistanceSlider->getValue();
+    ShadowSystem::parseQuality(shadowMenu->getSelectedItem(), preset.shadows);
+    preset.zombieCap = static_cast<int>(zombieCapSlider->getValue());
+    preset.physicsRate = physicsRateSlider->getValue();
+    preset.vsync = vsyncBox->isChecked();
+}
+
+void SettingsPage::itemSelected(OgreBites::SelectMenu* menu)
+{
+    // Changer de préréglage affiche ses valeurs ; elles s'appliquent avec "Appliquer"
+    if (menu == presetMenu && settings.selectPreset(menu->getSelectedItem())) {
+        showPreset(settings.getPreset());
+    }
+}
+
+void SettingsPage::buttonHit(OgreBites::Button* button)
+{
+    if (button == applyButton) {
+        readWidgets(settings.getPreset());
+        appliedPreset = settings.getPresetName();
+        if (!settings.save()) {
+            std::cerr << "Settings applied but not saved" << std::endl;
+        }
+        if (applyCallback) {
+            applyCallback(settings.getPreset());
+        }
+    } else if (button == closeButton) {
+        hide();
+    }
+}
@@ -0,0 +1,106 @@
+#include "../include/ShaderCache.hpp"
+#include "../include/Profiler.hpp"
+#include <OgreComponents.h>
+#include <OgreGpuProgramManager.h>
+#ifdef OGRE_BUILD_COMPONENT_RTSHADERSYSTEM
+#include <OgreRTShaderSystem.h>
+#endif
+#include <filesystem>
+#include <iostream>
+#include <set>
+
+ShaderCache::ShaderCache(const std::string& cacheDirectory)
+    : directory(cacheDirectory)
+{
+    if (!directory.empty() && directory.back() != '/' && directory.back() != '\\') {
+        directory += '/';
+    }
+    microcodePath = directory + "microcode.cache";
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cerr << "Cannot create shader cache " << directory << ": " << error.message() << std::endl;
+        return;
+    }
+
+#ifdef OGRE_BUILD_COMPONENT_RTSHADERSYSTEM
+    // Sources générées réutilisées d'un lancement à l'autre
+    if (Ogre::RTShader::ShaderGenerator* generator = Ogre::RTShader::ShaderGenerator::getSingletonPtr()) {
+        generator->setShaderCachePath(directory);
+    }
+#endif
+
+    // Programmes compilés : rechargés tels quels, sans passer par le compilateur du pilote
+    Ogre::GpuProgramManager& programs = Ogre::GpuProgramManager::getSingleton();
+    programs.setSaveMicrocodesToCache(true);
+    if (std::filesystem::exists(microcodePath, error)) {
+        try {
+            programs.loadMicrocodeCache(Ogre::Root::openFileStream(microcodePath));
+        } catch (const Ogre::Exception& e) {
+            // Cache d'un autre pilote ou corrompu : il sera reconstruit
+            std::cerr << "Ignoring shader microcode cache: " << e.what() << std::endl;
+        }
+    }
+}
+
+bool ShaderCache::warmUpMaterial(const Ogre::MaterialPtr& material) {
+    try {
+#ifdef OGRE_BUILD_COMPONENT_RTSHADERSYSTEM
+        if (Ogre::RTShader::ShaderGenerator* generator = Ogre::RTShader::ShaderGenerator::getSingletonPtr()) {
+            generator->createShaderBasedTechnique(*material, Ogre::MSN_DEFAULT, Ogre::MSN_SHADERGEN);
+            generator->validateMaterial(Ogre::MSN_SHADERGEN, material->getName(), material->getGroup());
+        }
+#endif
+        // Le chargement compile les programmes de chaque passe supportée
+        material->load();
+    } catch (const Ogre::Exception& e) {
+        std::cerr << "Failed to prepare material " << material->getName() << ": " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+size_t ShaderCache::warmUp(const std::vector<std::string>& meshes, const std::vector<std::string>& materials) {
+    PROFILE_SCOPE("ShaderWarmUp");
+    Ogre::MaterialManager& materialManager = Ogre::MaterialManager::getSingleton();
+
+    std::set<std::string> names(materials.begin(), materials.end());
+    for (const std::string& meshName : meshes) {
+        try {
+            Ogre::MeshPtr mesh = Ogre::MeshManager::getSingleton().load(
+                meshName, Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+            for (const Ogre::SubMesh* subMesh : mesh->getSubMeshes()) {
+                names.insert(subMesh->getMaterialName());
+            }
+        } catch (const Ogre::Exception& e) {
+            std::cerr << "Failed to load mesh " << meshName << " for shader warm-up: " << e.what() << std::endl;
+        }
+    }
+
+    size_t prepared = 0;
+    for (const std::string& name : names) {
+        Ogre::MaterialPtr material =
+            materialManager.getByName(name, Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+        if (!material) {
+            std::cerr << "Shader warm-up: material " << name << " not found" << std::endl;
+            continue;
+        }
+        if (warmUpMaterial(material)) ++prepared;
+    }
+
+    // Tout ce qui vient d'être compilé sert dès le prochain lancement
+    save();
+    return prepared;
+}
+
+void ShaderCache::save() {
+    Ogre::GpuProgramManager& programs = Ogre::GpuProgramManager::getSingleton();
+    if (!programs.isCacheDirty()) return;
+
+    try {
+        programs.saveMicrocodeCache(Ogre::Root::createFileStream(microcodePath));
+    } catch (const Ogre::Exception& e) {
+        std::cerr << "Failed to save shader microcode cache: " << e.what() << std::endl;
+    }
+}
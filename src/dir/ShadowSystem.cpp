@@ -0,0 +1,198 @@
+#include "../include/ShadowSystem.hpp"
+#include "../include/GameComponents.hpp"
+#include <OgreComponents.h>
+#include <OgreShadowCameraSetupPSSM.h>
+#ifdef OGRE_BUILD_COMPONENT_RTSHADERSYSTEM
+#include <OgreRTShaderSystem.h>
+#endif
+#include <algorithm>
+#include <iostream>
+
+ShadowSettings ShadowSettings::forQuality(ShadowQuality quality) {
+    ShadowSettings settings;
+    switch (quality) {
+        case ShadowQuality::Off:
+            settings.cascades = 0;
+            settings.casterDistance = 0.0f;
+            break;
+        case ShadowQuality::Low:
+            settings.cascades = 1;
+            settings.mapSize = 1024;
+            settings.casterDistance = 300.0f;
+            break;
+        case ShadowQuality::Medium:
+            settings.cascades = 3;
+            settings.mapSize = 1024;
+            settings.casterDistance = 600.0f;
+            break;
+        case ShadowQuality::High:
+            settings.cascades = 3;
+            settings.mapSize = 2048;
+            settings.casterDistance = 1000.0f;
+            break;
+    }
+    return settings;
+}
+
+ShadowSystem::ShadowSystem(Ogre::SceneManager* scnMgr)
+    : sceneManager(scnMgr)
+    , light(nullptr)
+    , camera(nullptr)
+    , store(nullptr)
+    , quality(ShadowQuality::Off)
+    , settings(ShadowSettings::forQuality(ShadowQuality::Off))
+    , splitDistance(0.0f)
+{
+}
+
+bool ShadowSystem::parseQuality(const std::string& name, ShadowQuality& quality) {
+    if (name == "off") {
+        quality = ShadowQuality::Off;
+    } else if (name == "low") {
+        quality = ShadowQuality::Low;
+    } else if (name == "medium") {
+        quality = ShadowQuality::Medium;
+    } else if (name == "high") {
+        quality = ShadowQuality::High;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* ShadowSystem::getQualityName(ShadowQuality quality) {
+    switch (quality) {
+        case ShadowQuality::Off: return "off";
+        case ShadowQuality::Low: return "low";
+        case ShadowQuality::Medium: return "medium";
+        case ShadowQuality::High: return "high";
+    }
+    return "off";
+}
+
+void ShadowSystem::initialize(Ogre::Light* mainLight, Ogre::Camera* mainCamera, ShadowQuality initialQuality) {
+    light = mainLight;
+    camera = mainCamera;
+
+    // Les cascades suivent la caméra : il faut une lumière directionnelle
+    if (light) {
+        light->setType(Ogre::Light::LT_DIRECTIONAL);
+        light->setCastShadows(true);
+    }
+    createProxyMaterial();
+    setQuality(initialQuality);
+}
+
+void ShadowSystem::createProxyMaterial() {
+    Ogre::MaterialManager& materialManager = Ogre::MaterialManager::getSingleton();
+    if (materialManager.resourceExists(PROXY_MATERIAL)) return;
+
+    try {
+        // Rien dans la passe principale ; la passe d'ombre utilise le matériau de projection par défaut
+        Ogre::MaterialPtr material = materialManager.create(
+            PROXY_MATERIAL, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+        Ogre::Pass* pass = material->getTechnique(0)->getPass(0);
+        pass->setLightingEnabled(false);
+        pass->setColourWriteEnabled(false);
+        pass->setDepthWriteEnabled(false);
+        material->setReceiveShadows(false);
+    } catch (const Ogre::Exception& e) {
+        std::cerr << "Failed to create shadow proxy material: " << e.what() << std::endl;
+    }
+}
+
+void ShadowSystem::setQuality(ShadowQuality newQuality) {
+    quality = newQuality;
+    settings = ShadowSettings::forQuality(quality);
+    apply();
+}
+
+void ShadowSystem::setCasterDistance(float distance) {
+    if (quality == ShadowQuality::Off) return;
+    settings.casterDistance = std::max(distance, 1.0f);
+    if (settings.casterDistance > splitDistance) {
+        apply();
+    } else {
+        updateCasterDistance();
+    }
+}
+
+void ShadowSystem::setEntityStore(EntityStore* entityStore) {
+    store = entityStore;
+    applyToProxies();
+}
+
+void ShadowSystem::apply() {
+    if (!sceneManager) return;
+
+    try {
+        if (settings.cascades == 0) {
+            sceneManager->setShadowTechnique(Ogre::SHADOWTYPE_NONE);
+            splitDistance = 0.0f;
+            applyToProxies();
+            return;
+        }
+
+        // Cartes de profondeur, intégrées aux matériaux des receveurs (pas de passe additive par lumière)
+        sceneManager->setShadowTechnique(Ogre::SHADOWTYPE_TEXTURE_ADDITIVE_INTEGRATED);
+        sceneManager->setShadowTextureCountPerLightType(Ogre::Light::LT_DIRECTIONAL, settings.cascades);
+        sceneManager->setShadowTextureSettings(settings.mapSize, settings.cascades, Ogre::PF_DEPTH16);
+        sceneManager->setShadowTextureSelfShadow(true);
+        sceneManager->setShadowCasterRenderBackFaces(false);
+        sceneManager->setShadowFarDistance(settings.casterDistance);
+
+        const Ogre::Real nearClip = camera ? camera->getNearClipDistance() : 1.0f;
+        auto pssm = std::make_shared<Ogre::PSSMShadowCameraSetup>();
+        pssm->calculateSplitPoints(settings.cascades, nearClip, settings.casterDistance);
+        pssm->setSplitPadding(nearClip);
+        sceneManager->setShadowCameraSetup(pssm);
+        splitDistance = settings.casterDistance;
+
+#ifdef OGRE_BUILD_COMPONENT_RTSHADERSYSTEM
+        // Les receveurs échantillonnent les cascades dans les shaders générés
+        if (Ogre::RTShader::ShaderGenerator* generator = Ogre::RTShader::ShaderGenerator::getSingletonPtr()) {
+            Ogre::RTShader::RenderState* renderState =
+                generator->getRenderState(Ogre::MSN_SHADERGEN);
+            for (Ogre::RTShader::SubRenderState* state : renderState->getSubRenderStates()) {
+                if (state->getType() == Ogre::RTShader::IntegratedPSSM3::Type) {
+                    renderState->removeSubRenderState(state);
+                    break;
+                }
+            }
+            auto* pssmState = static_cast<Ogre::RTShader::IntegratedPSSM3*>(
+                generator->createSubRenderState(Ogre::RTShader::IntegratedPSSM3::Type));
+            pssmState->setSplitPoints(pssm->getSplitPoints());
+            renderState->addTemplateSubRenderState(pssmState);
+            generator->invalidateScheme(Ogre::MSN_SHADERGEN);
+        }
+#endif
+    } catch (const Ogre::Exception& e) {
+        std::cerr << "Failed to apply shadow settings: " << e.what() << std::endl;
+        sceneManager->setShadowTechnique(Ogre::SHADOWTYPE_NONE);
+        settings = ShadowSettings::forQuality(ShadowQuality::Off);
+        quality = ShadowQuality::Off;
+        splitDistance = 0.0f;
+    }
+
+    applyToProxies();
+}
+
+void ShadowSystem::updateCasterDistance() {
+    if (!sceneManager || splitDistance <= 0.0f) return;
+
+    // Les coupures restent celles des shaders générés : seuls la distance et les proxies changent
+    sceneManager->setShadowFarDistance(settings.casterDistance);
+    applyToProxies();
+}
+
+void ShadowSystem::applyToProxies() {
+    if (!store) return;
+
+    // Ogre mesure la distance depuis la caméra principale, y compris pour les caméras d'ombre
+    const float distance = settings.casterDistance;
+    store->each<ShadowCaster>([distance](EntityId, ShadowCaster& caster) {
+        if (!caster.proxy) return;
+        caster.proxy->setVisible(distance > 0.0f);
+        caster.proxy->setRenderingDistance(distance);
+    });
+}
@@ -0,0 +1,146 @@
+#include "../include/SimulationThread.hpp"
+#include "../include/Profiler.hpp"
+#include <chrono>
+#include <iostream>
+#include <system_error>
+
+SimulationThread::SimulationThread(StepFunction step, float tickInterval)
+    : step(std::move(step))
+    , tickInterval(tickInterval)
+    , running(false)
+    , tickCount(0)
+    , structureVersion(0)
+{
+}
+
+SimulationThread::~SimulationThread()
+{
+    stop();
+}
+
+void SimulationThread::start()
+{
+    if (running.load()) return;
+
+    SceneNodeMotionState::setRecorder(this);
+    running.store(true);
+    try {
+        thread = std::thread(&SimulationThread::run, this);
+    } catch (const std::system_error& e) {
+        std::cerr << "Failed to start the simulation thread: " << e.what() << std::endl;
+        running.store(false);
+        SceneNodeMotionState::setRecorder(nullptr);
+    }
+}
+
+void SimulationThread::stop()
+{
+    if (!running.exchange(false)) return;
+    if (thread.joinable()) {
+        thread.join();
+    }
+    SceneNodeMotionState::setRecorder(nullptr);
+
+    // The thread is gone: the last recorded transforms can be written directly
+    for (const NodeTransform& transform : latest) {
+        if (!transform.node) continue;
+        Ogre::Vector3 position = transform.position;
+        if (transform.lockHeight) {
+            position.y = transform.node->getPosition().y;
+        }
+        transform.node->setPosition(position);
+        if (transform.syncOrientation) {
+            transform.node->setOrientation(transform.orientation);
+        }
+    }
+}
+
+void SimulationThread::run()
+{
+    using Clock = std::chrono::steady_clock;
+
+    auto nextTick = Clock::now();
+    while (running.load()) {
+        // Relu à chaque pas : la cadence peut changer en cours de partie
+        const float seconds = tickInterval.load();
+        const auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(seconds));
+        // Beyond this delay the simulation drops ticks instead of trying to catch up
+        const auto maxLag = interval * 5;
+        {
+            PROFILE_SCOPE("SimTick");
+            std::lock_guard<std::mutex> lock(simMutex);
+            step(seconds);
+            publish();
+        }
+        tickCount.fetch_add(1);
+
+        nextTick += interval;
+        auto now = Clock::now();
+        if (now - nextTick > maxLag) {
+            nextTick = now;
+        }
+        std::this_thread::sleep_until(nextTick);
+    }
+}
+
+void SimulationThread::publish()
+{
+    WorldSnapshot& snapshot = snapshots.writeBuffer();
+    snapshot.tick = tickCount.load() + 1;
+    snapshot.structureVersion = structureVersion.load();
+    snapshot.transforms = latest; // Same size from one tick to the next: no reallocation
+    snapshots.publish();
+}
+
+bool SimulationThread::applyLatestSnapshot()
+{
+    if (!snapshots.update()) return false;
+
+    // Bodies destroyed since this snapshot may have taken their nodes with them
+    const WorldSnapshot& snapshot = snapshots.readBuffer();
+    if (snapshot.structureVersion != structureVersion.load()) return false;
+
+    for (const NodeTransform& transform : snapshot.transforms) {
+        if (!transform.node) continue;
+        Ogre::Vector3 position = transform.position;
+        if (transform.lockHeight) {
+            position.y = transform.node->getPosition().y;
+        }
+        transform.node->setPosition(position);
+        if (transform.syncOrientation) {
+            transform.node->setOrientation(transform.orientation);
+        }
+    }
+    return true;
+}
+
+int SimulationThread::record(int slot, Ogre::SceneNode* node, const Ogre::Vector3& position,
+                             const Ogre::Quaternion& orientation, bool syncOrientation, bool lockHeight)
+{
+    if (slot < 0) {
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = static_cast<int>(latest.size());
+            latest.emplace_back();
+        }
+    }
+
+    NodeTransform& transform = latest[slot];
+    transform.node = node;
+    transform.position = position;
+    transform.orientation = orientation;
+    transform.syncOrientation = syncOrientation;
+    transform.lockHeight = lockHeight;
+    return slot;
+}
+
+void SimulationThread::release(int slot)
+{
+    if (slot < 0 || slot >= static_cast<int>(latest.size())) return;
+
+    latest[slot].node = nullptr;
+    freeSlots.push_back(slot);
+    structureVersion.fetch_add(1);
+}
@@ -1,12 +1,16 @@
 #include "WelcomePage.hpp"
 #include <OgreOverlaySystem.h>
 
-WelcomePage::WelcomePage() : OgreBites::ApplicationContext("ForestZ")
+WelcomePage::WelcomePage() : OgreBites::ApplicationContext("ForestZ"),
+    mTrayMgr(nullptr), mSettings(nullptr), mSettingsPage(nullptr)
 {
 }
 
 WelcomePage::~WelcomePage()
 {
+    // La page détruit ses widgets : avant le gestionnaire de Tray
+    delete mSettingsPage;
+    delete mSettings;
     if (mTrayMgr) delete mTrayMgr;
 }
 
@@ -34,9 +38,19 @@ void WelcomePage::setup()
     mTrayMgr->showFrameStats(OgreBites::TL_BOTTOMLEFT);
     mTrayMgr->showLogo(OgreBites::TL_BOTTOMRIGHT);
     mTrayMgr->hideCursor();
+    addInputListener(mTrayMgr);
 
     // Créer l'interface utilisateur
     createUI();
+
+    // Préréglages de qualité : la synchronisation verticale s'applique aussi à ce menu
+    mSettings = new GameSettings(getFSLayer());
+    mSettings->load();
+    getRenderWindow()->setVSyncEnabled(mSettings->getPreset().vsync);
+    mSettingsPage = new SettingsPage(mTrayMgr, *mSettings);
+    mSettingsPage->setApplyCallback([this](const QualityPreset& preset) {
+        getRenderWindow()->setVSyncEnabled(preset.vsync);
+    });
 }
 
 void WelcomePage::createUI()
@@ -68,7 +82,7 @@ bool WelcomePage::keyPressed(const OgreBites::KeyboardEvent& evt)
     return true;
 }
 
-void WelcomePage::buttonClicked(OgreBites::Button* button)
+void WelcomePage::buttonHit(OgreBites::Button* button)
 {
     if (button == mPlayButton)
     {
@@ -78,7 +92,7 @@ void WelcomePage::buttonClicked(OgreBites::Button* button)
     else if (button == mSettingsButton)
     {
         // Afficher les paramètres
-        // TODO: Implémenter l'affichage des paramètres
+        mSettingsPage->show();
     }
     else if (button == mMultiplayerButton)
     {
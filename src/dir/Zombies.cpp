@@ -1,4 +1,8 @@
 #include "../include/Zombies.hpp"
+#include "../include/GameRandom.hpp"
+#include "../include/Profiler.hpp"
+#include "../include/AllocationCounter.hpp"
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
@@ -20,134 +24,40 @@ namespace {
     }
 }
 
-Zombies::Zombies() 
-    : gameOverlay(nullptr)
-    , overlayContainer(nullptr)
-    , messageText(nullptr)
-    , messageDisplayTimeRemaining(0.0f)
+Zombies::Zombies(EntityStore* sharedStore)
+    : store(sharedStore)
+    , messageFeed(nullptr)
 {
-    initializeOverlay();
-}
-
-Zombies::~Zombies() {
-    // Clean up overlay system
-    if (messageText) {
-        Ogre::OverlayManager::getSingleton().destroyOverlayElement(messageText);
-    }
-    if (overlayContainer) {
-        Ogre::OverlayManager::getSingleton().destroyOverlayElement(overlayContainer);
-    }
-    if (gameOverlay) {
-        Ogre::OverlayManager::getSingleton().destroy(gameOverlay);
-    }
-
-    // Clean up zombie bodies and nodes
-    for (auto body : zombieBodies) {
-        if (body) {
-            delete body->getMotionState();
-            delete body->getCollisionShape();
-            delete body;
-        }
-    }
-    zombieBodies.clear();
-    zombieNodes.clear();
-    zombieEntities.clear();
-    zombieHealth.clear();
-}
-
-void Zombies::initializeOverlay() {
-    try {
-        // Create overlay
-        Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
-        gameOverlay = overlayManager.create("GameMessageOverlay");
-
-        // Create container
-        overlayContainer = static_cast<Ogre::OverlayContainer*>(
-            overlayManager.createOverlayElement("Panel", "MessageContainer"));
-        overlayContainer->setMetricsMode(Ogre::GMM_RELATIVE);
-        overlayContainer->setPosition(0, 0);
-        overlayContainer->setDimensions(1.0, 1.0);
-
-        // Create text area
-        messageText = static_cast<Ogre::TextAreaOverlayElement*>(
-            overlayManager.createOverlayElement("TextArea", "MessageText"));
-        messageText->setMetricsMode(Ogre::GMM_RELATIVE);
-        messageText->setPosition(0.0, 0.3);  // Position verticale à 30% du haut
-        messageText->setDimensions(1.0, 0.4);  // Hauteur de 40% de l'écran
-        messageText->setCharHeight(0.15);  // Taille relative plus grande
-        messageText->setAlignment(Ogre::TextAreaOverlayElement::Center);
-        messageText->setHorizontalAlignment(Ogre::GHA_CENTER);
-        messageText->setVerticalAlignment(Ogre::GVA_CENTER);
-        messageText->setFontName("SdkTrays/Value");
-        messageText->setColour(Ogre::ColourValue(1.0, 1.0, 1.0, 1.0));
-
-        // Add elements to overlay
-        overlayContainer->addChild(messageText);
-        gameOverlay->add2D(overlayContainer);
-        gameOverlay->setZOrder(300);
-        gameOverlay->show();
-
-        std::cout << "Overlay system initialized successfully" << std::endl;
-
-    } catch (const Ogre::Exception& e) {
-        std::cerr << "Failed to initialize overlay system: " << e.what() << std::endl;
+    if (!store) {
+        ownStore = std::make_unique<EntityStore>();
+        store = ownStore.get();
     }
 }
 
-void Zombies::showKillLogMessage(const std::string& message, float displayTime) {
-    if (!messageText || !gameOverlay) {
-        std::cerr << "Error: Message text or overlay not initialized" << std::endl;
-        return;
-    }
-
-    try {
-        messageText->setCaption(message);
-        messageText->setCharHeight(0.03);  // Petite taille pour les logs
-        messageText->setPosition(0.7, 0.05);  // Position en haut à droite
-        messageText->setDimensions(0.25, 0.1);  // Dimensions réduites
-        messageDisplayTimeRemaining = displayTime;
-        gameOverlay->show();
-    } catch (const Ogre::Exception& e) {
-        std::cerr << "Error showing kill log message: " << e.what() << std::endl;
-    }
-}
-
-void Zombies::showGameMessage(const std::string& message, float displayTime, int fontSize) {
-    if (!messageText || !gameOverlay) {
-        std::cerr << "Error: Message text or overlay not initialized" << std::endl;
-        return;
-    }
-
-    try {
-        messageText->setCaption(message);
-        float relativeSize = static_cast<float>(fontSize) / 500.0f;
-        messageText->setCharHeight(relativeSize);
-        messageText->setPosition(0.0, 0.3);  // Position centrale pour les messages de niveau
-        messageText->setDimensions(1.0, 0.4);  // Dimensions normales
-        messageDisplayTimeRemaining = displayTime;
-        gameOverlay->show();
-    } catch (const Ogre::Exception& e) {
-        std::cerr << "Error showing game message: " << e.what() << std::endl;
-    }
-}
-
-void Zombies::updateOverlay(float deltaTime) {
-    if (!gameOverlay) return;
-
-    if (messageDisplayTimeRemaining > 0) {
-        messageDisplayTimeRemaining -= deltaTime;
-        if (messageDisplayTimeRemaining <= 0) {
-            gameOverlay->hide();
+Zombies::~Zombies() {
+    // Clean up zombie bodies and entities
+    for (EntityId id : zombieIds) {
+        RigidBodyRef* bodyRef = store->get<RigidBodyRef>(id);
+        if (bodyRef && bodyRef->body) {
+            delete bodyRef->body->getMotionState();
+            delete bodyRef->body->getCollisionShape();
+            delete bodyRef->body;
         }
+        store->destroy(id);
     }
+    zombieIds.clear();
+    zombieHandles.clear();
 }
 
 void Zombies::createZombies(Ogre::SceneManager* scnMgr, int numZombies, float radius, btDiscreteDynamicsWorld* dynamicsWorld) {
-    std::srand(static_cast<unsigned>(std::time(0)));
-
+    MemoryScope memoryScope(MemoryTag::Zombies);
+    PROFILE_SCOPE("SpawnZombies");
+    const size_t alive = store->count<Zombie>();
+    if (alive >= maxZombies) return;
+    numZombies = static_cast<int>(std::min(static_cast<size_t>(std::max(numZombies, 0)), maxZombies - alive));
     for (int i = 0; i < numZombies; ++i) {
-        float x = static_cast<float>(std::rand()) / RAND_MAX * radius * 2 - radius;
-        float z = static_cast<float>(std::rand()) / RAND_MAX * radius * 2 - radius;
+        float x = GameRandom::uniform(-radius, radius);
+        float z = GameRandom::uniform(-radius, radius);
         float y = 0.0f;
 
         Ogre::Vector3 position(x, y, z);
@@ -156,7 +66,7 @@ void Zombies::createZombies(Ogre::SceneManager* scnMgr, int numZombies, float ra
         std::string uniqueName = generateUniqueName();
         Ogre::Entity* zombieEntity = nullptr;
         try {
-            zombieEntity = scnMgr->createEntity(uniqueName, "ZombieGirl_Body.mesh");
+            zombieEntity = scnMgr->createEntity(uniqueName, MESH);
             if (!zombieEntity) {
                 std::cerr << "Failed to create zombie entity: " << uniqueName << std::endl;
                 continue;
@@ -187,9 +97,6 @@ void Zombies::createZombies(Ogre::SceneManager* scnMgr, int numZombies, float ra
             zombieAnimation->setLoop(true);
         }
 
-        zombieNodes.push_back(zombieNode);
-        zombieEntities.push_back(zombieEntity);
-
         // Create physics for the zombie
         btCollisionShape* zombieShape = new btCapsuleShape(10.0f, 70.0f);
         btTransform zombieTransform;
@@ -204,75 +111,108 @@ void Zombies::createZombies(Ogre::SceneManager* scnMgr, int numZombies, float ra
         btScalar mass = 50.0f;
         btVector3 localInertia(0, 0, 0);
         zombieShape->calculateLocalInertia(mass, localInertia);
-        btDefaultMotionState* motionState = new btDefaultMotionState(zombieTransform);
+        // Le corps pilote directement le nœud, qui reste posé au sol
+        SceneNodeMotionState* motionState = new SceneNodeMotionState(zombieNode, zombieTransform);
+        motionState->setLockHeight(true);
         btRigidBody::btRigidBodyConstructionInfo rbInfo(mass, motionState, zombieShape, localInertia);
         btRigidBody* zombieBody = new btRigidBody(rbInfo);
 
         zombieBody->setAngularFactor(btVector3(0, 1, 0));
-        dynamicsWorld->addRigidBody(zombieBody);
-        zombieBodies.push_back(zombieBody);
 
-        // Initialize zombie health
-        zombieHealth.push_back(baseZombieHealth * healthMultiplier);
+        // Identifier le zombie dans les événements de contact
+        const size_t slot = zombieIds.size();
+        zombieHandles.push_back({BodyHandle::Kind::Zombie, slot});
+        zombieBody->setUserPointer(&zombieHandles.back());
+
+        CollisionLayers::addRigidBody(dynamicsWorld, zombieBody, CollisionLayer::Zombie);
+
+        const float health = baseZombieHealth * healthMultiplier;
+        const btVector3& origin = zombieTransform.getOrigin();
+        zombieIds.push_back(store->create(Transform{Vector3(origin.x(), origin.y(), origin.z()), orientation},
+                                          Health{health, health}, Team{Side::Zombies},
+                                          SceneNodeRef{zombieNode, zombieEntity}, RigidBodyRef{zombieBody},
+                                          Zombie{slot}));
     }
 }
 
 void Zombies::updateZombies(Ogre::SceneNode* playerNode, float deltaTime) {
     if (!playerNode) return;
 
-    Ogre::Vector3 playerPos = playerNode->getPosition();
+    steerZombies(playerNode->getPosition());
+    updateAnimations(deltaTime);
+}
 
-    for (size_t i = 0; i < zombieBodies.size(); ++i) {
-        if (!isZombieAlive(i) || !zombieBodies[i] || !zombieNodes[i]) continue;
+void Zombies::steerZombies(const Ogre::Vector3& playerPos, JobSystem* jobs) {
+    PROFILE_SCOPE("AI");
+    // Ne touche qu'aux corps physiques : l'orientation du nœud suit via le motion state
+    store->eachChunk<Zombie, RigidBodyRef, Transform>(
+        [this, &playerPos, jobs](size_t count, const EntityId*, Zombie*, RigidBodyRef* bodies, Transform* transforms) {
+        auto steerRange = [this, &playerPos, bodies, transforms](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                btRigidBody* body = bodies[i].body;
+                if (!body) continue;
+
+                btVector3 zombiePos = body->getWorldTransform().getOrigin();
+                Vector3 zombiePosition(zombiePos.x(), zombiePos.y(), zombiePos.z());
+                transforms[i].position = zombiePosition;
+                Vector3 direction = playerPos - zombiePosition;
+                direction.y = 0; // Garder le zombie droit
+
+                if (direction.length() > 1.0f) {
+                    // Normaliser la direction pour le mouvement
+                    Vector3 normalizedDirection = direction.normalisedCopy();
+                    Vector3 velocity = normalizedDirection * ZOMBIE_SPEED * speedMultiplier;
+                    body->setLinearVelocity(btVector3(velocity.x, 0, velocity.z));
+
+                    // Faire face au joueur
+                    Quaternion zombieRotation;
+                    // Calculer l'angle entre l'axe Z et la direction vers le joueur
+                    zombieRotation = Vector3::UNIT_Z.getRotationTo(direction);
+                    transforms[i].orientation = zombieRotation;
+
+                    // Mettre à jour la rotation dans le monde physique
+                    btTransform transform = body->getWorldTransform();
+                    transform.setRotation(btQuaternion(zombieRotation.x, zombieRotation.y,
+                                                     zombieRotation.z, zombieRotation.w));
+                    body->setWorldTransform(transform);
+                }
+            }
+        };
 
-        btVector3 zombiePos = zombieBodies[i]->getWorldTransform().getOrigin();
-        Vector3 zombiePosition(zombiePos.x(), zombiePos.y(), zombiePos.z());
-        Vector3 direction = playerPos - zombiePosition;
-        direction.y = 0; // Garder le zombie droit
-        
-        if (direction.length() > 1.0f) {
-            // Normaliser la direction pour le mouvement
-            Vector3 normalizedDirection = direction.normalisedCopy();
-            Vector3 velocity = normalizedDirection * ZOMBIE_SPEED * speedMultiplier;
-            zombieBodies[i]->setLinearVelocity(btVector3(velocity.x, 0, velocity.z));
-            
-            // Faire face au joueur
-            Quaternion zombieRotation;
-            // Calculer l'angle entre l'axe Z et la direction vers le joueur
-            zombieRotation = Vector3::UNIT_Z.getRotationTo(direction);
-            
-            // Appliquer la rotation au zombie
-            zombieNodes[i]->setOrientation(zombieRotation);
-            
-            // Mettre à jour la rotation dans le monde physique
-            btTransform transform = zombieBodies[i]->getWorldTransform();
-            transform.setRotation(btQuaternion(zombieRotation.x, zombieRotation.y, 
-                                             zombieRotation.z, zombieRotation.w));
-            zombieBodies[i]->setWorldTransform(transform);
+        if (jobs) {
+            jobs->parallelFor(count, STEER_GRAIN_SIZE, steerRange);
+        } else {
+            steerRange(0, count);
         }
-        
-        // Update visual position
-        btTransform trans;
-        zombieBodies[i]->getMotionState()->getWorldTransform(trans);
-        zombieNodes[i]->setPosition(trans.getOrigin().x(), 0, trans.getOrigin().z());
-
-        // Update animation
-        if (zombieEntities[i]) {
-            Ogre::AnimationState* zombieAnimation = zombieEntities[i]->getAnimationState("my_animation");
-            if (zombieAnimation) {
-                zombieAnimation->addTime(deltaTime * 0.5f);
-            }
+    });
+}
+
+void Zombies::updateAnimations(float deltaTime) {
+    animationElapsed += deltaTime;
+    if (animationElapsed < animationInterval) return;
+    deltaTime = animationElapsed;
+    animationElapsed = 0.0f;
+
+    PROFILE_SCOPE("Animation");
+    store->each<Zombie, SceneNodeRef>([deltaTime](EntityId, Zombie&, SceneNodeRef& visual) {
+        if (!visual.entity) return;
+
+        Ogre::AnimationState* zombieAnimation = visual.entity->getAnimationState("my_animation");
+        if (zombieAnimation) {
+            zombieAnimation->addTime(deltaTime * 0.5f);
         }
-    }
+    });
+}
+
+void Zombies::setAnimationRate(float updatesPerSecond) {
+    animationInterval = updatesPerSecond > 0.0f ? 1.0f / updatesPerSecond : 0.0f;
 }
 
 void Zombies::setHealthMultiplier(float multiplier) {
     healthMultiplier = multiplier;
-    for (size_t i = 0; i < zombieHealth.size(); ++i) {
-        if (isZombieAlive(i)) {
-            zombieHealth[i] = baseZombieHealth * healthMultiplier;
-        }
-    }
+    store->each<Zombie, Health>([this](EntityId, Zombie&, Health& health) {
+        health.current = health.maximum = baseZombieHealth * healthMultiplier;
+    });
 }
 
 void Zombies::setSpeedMultiplier(float multiplier) {
@@ -280,40 +220,39 @@ void Zombies::setSpeedMultiplier(float multiplier) {
 }
 
 bool Zombies::isZombieAlive(size_t index) const {
-    if (index >= zombieHealth.size()) return false;
-    return zombieHealth[index] > 0;
+    // Un zombie mort n'a plus d'entité
+    return index < zombieIds.size() && store->isAlive(zombieIds[index]);
 }
 
 void Zombies::onBulletHit(size_t zombieIndex, float damage, btDiscreteDynamicsWorld* dynamicsWorld) {
-    if (zombieIndex >= zombieHealth.size() || !isZombieAlive(zombieIndex)) return;
+    if (!isZombieAlive(zombieIndex)) return;
 
-    zombieHealth[zombieIndex] -= damage;
+    const EntityId id = zombieIds[zombieIndex];
+    Health* health = store->get<Health>(id);
+    health->current -= damage;
     
-    if (zombieHealth[zombieIndex] <= 0) {
+    if (health->current <= 0) {
         // Zombie is dead
-        if (zombieBodies[zombieIndex]) {
-            dynamicsWorld->removeRigidBody(zombieBodies[zombieIndex]);
-            delete zombieBodies[zombieIndex]->getMotionState();
-            delete zombieBodies[zombieIndex]->getCollisionShape();
-            delete zombieBodies[zombieIndex];
-            zombieBodies[zombieIndex] = nullptr;
+        RigidBodyRef* bodyRef = store->get<RigidBodyRef>(id);
+        if (bodyRef->body) {
+            dynamicsWorld->removeRigidBody(bodyRef->body);
+            delete bodyRef->body->getMotionState();
+            delete bodyRef->body->getCollisionShape();
+            delete bodyRef->body;
         }
         
-        if (zombieNodes[zombieIndex]) {
-            zombieNodes[zombieIndex]->getCreator()->destroySceneNode(zombieNodes[zombieIndex]);
-            zombieNodes[zombieIndex] = nullptr;
+        SceneNodeRef* visual = store->get<SceneNodeRef>(id);
+        if (visual->node) {
+            Ogre::SceneManager* scnMgr = visual->node->getCreator();
+            if (visual->entity) scnMgr->destroyEntity(visual->entity);
+            scnMgr->destroySceneNode(visual->node);
         }
+        store->destroy(id);
 
-        std::stringstream ss;
-        ss << "Zombie " << zombieIndex << " éliminé!";
-        showKillLogMessage(ss.str(), 2.0f);  // Affichage pendant 2 secondes
-    } else {
-        std::stringstream ss;
-        ss << "Zombie " << zombieIndex << " touché! Vie: " << zombieHealth[zombieIndex];
-        showKillLogMessage(ss.str(), 1.0f);  // Affichage pendant 1 seconde
+        if (messageFeed) {
+            messageFeed->postFeed(2.0f, "Zombie %zu éliminé!", zombieIndex);  // Affichage pendant 2 secondes
+        }
+    } else if (messageFeed) {
+        messageFeed->postFeed(1.0f, "Zombie %zu touché! Vie: %g", zombieIndex, health->current);  // Affichage pendant 1 seconde
     }
 }
-
-const std::vector<btRigidBody*>& Zombies::getZombieBodies() const {
-    return zombieBodies;
-}
\ No newline at end of file
@@ -1,7 +1,9 @@
 #include "../include/forest.hpp"
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <OgreOverlaySystem.h>
 #include <SDL2/SDL_keycode.h>
@@ -15,8 +17,13 @@ Forest::Forest()
       planeZ(nullptr),
       player(nullptr),
       zombies(nullptr),
+      messageFeed(nullptr),
+      minimap(nullptr),
+      hud(nullptr),
+      crosshair(nullptr),
       overlaySystem(nullptr),
       shadergen(nullptr),
+      shaderCache(nullptr),
       lastFrameTime(0.0f),
       gameStarted(false),
       cameraManager(nullptr),
@@ -24,15 +31,43 @@ Forest::Forest()
       inputManager(nullptr),
       physicsManager(nullptr),
       uiManager(nullptr),
+      contactEvents(nullptr),
+      simulationThread(nullptr),
+      jobSystem(nullptr),
+      entityStore(nullptr),
+      occlusionCuller(nullptr),
+      qualityGovernor(nullptr),
+      gameSettings(nullptr),
+      settingsPage(nullptr),
+      shadowDistanceLimit(0.0f),
+      profilerOverlay(nullptr),
+      hitchDetector(nullptr),
+      memoryOverlay(nullptr),
       light(nullptr),
-      lightNode(nullptr)
+      lightNode(nullptr),
+      shadowSystem(nullptr)
 {
 }
 
 Forest::~Forest()
 {
+    // The simulation thread uses everything below
+    delete simulationThread;
+    delete jobSystem;
+
     // Clean up managers
+    delete hitchDetector;
+    delete qualityGovernor;
+    delete memoryOverlay;
+    delete messageFeed;
+    delete profilerOverlay;
+    delete occlusionCuller;
+    delete shadowSystem;
+    delete shaderCache;
+    delete contactEvents;
+    delete settingsPage;
     delete uiManager;
+    delete gameSettings;
     delete physicsManager;
     delete inputManager;
     delete levelManager;
@@ -43,14 +78,43 @@ Forest::~Forest()
     delete player;
     delete planeZ;
     delete object;
+    delete entityStore;
+
+    // Ce qui reste ici après la destruction du jeu est une fuite
+    report.collect(nullptr);
+    std::cout << "Memory after cleanup:" << std::endl;
+    report.print(std::cout);
+
     delete overlaySystem;
 }
 
+/**
+ * @brief Prints the memory report, then tears down Ogre
+ *
+ * Called by closeApp() before Root goes away: the scene manager is still
+ * alive here, unlike in the destructor.
+ */
+void Forest::shutdown()
+{
+    if (scnMgr) {
+        MemoryReport report;
+        report.collect(scnMgr);
+        std::cout << "Memory at exit:" << std::endl;
+        report.print(std::cout);
+    }
+    ApplicationContext::shutdown();
+}
+
 void Forest::setup()
 {
     ApplicationContext::setup();
     addInputListener(this);
 
+    // FORESTZ_SHADER_CACHE remplace le dossier du cache de shaders (par défaut dans le dossier utilisateur)
+    shadergen = RTShader::ShaderGenerator::getSingletonPtr();
+    const char* shaderCacheDir = std::getenv("FORESTZ_SHADER_CACHE");
+    shaderCache = new ShaderCache(shaderCacheDir ? shaderCacheDir : getFSLayer().getWritablePath("shadercache/"));
+
     root = getRoot();
     overlaySystem = getOverlaySystem();
     scnMgr = root->createSceneManager();
@@ -58,10 +122,47 @@ void Forest::setup()
     if (overlaySystem)
         scnMgr->addRenderQueueListener(overlaySystem);
 
+    // FORESTZ_JOB_THREADS=1 garde tout sur le thread appelant ; par défaut un thread par cœur
+    unsigned int jobThreads = 0;
+    if (const char* jobThreadsValue = std::getenv("FORESTZ_JOB_THREADS")) {
+        jobThreads = static_cast<unsigned int>(std::max(0, std::atoi(jobThreadsValue)));
+    }
+    jobSystem = new JobSystem(jobThreads);
+
     // Initialize managers
+    // FORESTZ_PHYSICS_THREADS=0 steps the world on every hardware thread (multithreaded builds only)
+    PhysicsSettings physicsSettings;
+    if (const char* physicsThreads = std::getenv("FORESTZ_PHYSICS_THREADS")) {
+        physicsSettings.threadCount = std::atoi(physicsThreads);
+    }
+    // FORESTZ_BROADPHASE=dbvt|sap|grid
+    if (const char* broadphaseName = std::getenv("FORESTZ_BROADPHASE")) {
+        if (!PhysicsManager::parseBroadphase(broadphaseName, physicsSettings.broadphase)) {
+            std::cerr << "Unknown broadphase '" << broadphaseName << "', using dbvt" << std::endl;
+        }
+    }
+
     physicsManager = new PhysicsManager();
-    physicsManager->initialize();
+    physicsManager->initialize(physicsSettings);
     physicsManager->setupDebugDrawer(scnMgr);
+
+    // Préréglage de qualité (settings.cfg ou FORESTZ_SETTINGS), modifiable en jeu depuis la page des paramètres
+    gameSettings = new GameSettings(getFSLayer());
+    gameSettings->load();
+    appliedSettings = gameSettings->getPreset();
+    physicsManager->setTickRate(appliedSettings.physicsRate);
+    getRenderWindow()->setVSyncEnabled(appliedSettings.vsync);
+
+    // Hits and damage are resolved after every fixed physics tick. With the
+    // simulation thread they are only collected there and delivered by the render thread.
+    contactEvents = new ContactEvents();
+    physicsManager->setTickCallback([this](float) {
+        if (simulationThread) {
+            contactEvents->collect(physicsManager->getDynamicsWorld());
+        } else {
+            contactEvents->dispatch(physicsManager->getDynamicsWorld(), player, zombies);
+        }
+    });
     
     cameraManager = new CameraManager(scnMgr, getRenderWindow());
     
@@ -78,9 +179,14 @@ void Forest::setup()
         // TODO: Implémenter le mode multijoueur
         std::cout << "Mode multijoueur pas encore implémenté" << std::endl;
     });
+    if (uiManager->getTrayManager()) {
+        settingsPage = new SettingsPage(uiManager->getTrayManager(), *gameSettings);
+        settingsPage->setApplyCallback([this](const QualityPreset&) { applySettings(); });
+    }
     uiManager->setSettingsCallback([this]() {
-        // TODO: Implémenter la page des paramètres
-        std::cout << "Page des paramètres pas encore implémentée" << std::endl;
+        if (settingsPage) {
+            settingsPage->show();
+        }
     });
     uiManager->setQuitCallback([this]() { this->quitGame(); });
     
@@ -88,6 +194,34 @@ void Forest::setup()
         addInputListener(uiManager->getTrayManager());
     }
 
+    // F3 : statistiques par scope, F4 : capture Chrome trace. FORESTZ_PROFILE=1 affiche le panneau dès le départ
+    profilerOverlay = new ProfilerOverlay();
+    profilerOverlay->initialize();
+    const char* profile = std::getenv("FORESTZ_PROFILE");
+    if (profile && std::atoi(profile) != 0) {
+        profilerOverlay->toggle();
+    }
+
+    // Fil des éliminations et bannières de niveau
+    messageFeed = new MessageFeed();
+    messageFeed->initialize();
+
+    // F5 : mémoire par sous-système et objets Ogre vivants
+    memoryOverlay = new MemoryOverlay();
+    memoryOverlay->initialize();
+
+    // FORESTZ_HITCH_MS=50 : toute image plus longue écrit hitch_<date>.json (FORESTZ_HITCH_HISTORY secondes d'historique)
+    if (const char* hitchMs = std::getenv("FORESTZ_HITCH_MS")) {
+        HitchSettings hitchSettings;
+        hitchSettings.thresholdMs = static_cast<float>(std::atof(hitchMs));
+        if (const char* history = std::getenv("FORESTZ_HITCH_HISTORY")) {
+            hitchSettings.historySeconds = static_cast<float>(std::atof(history));
+        }
+        if (hitchSettings.thresholdMs > 0.0f) {
+            hitchDetector = new HitchDetector(hitchSettings);
+        }
+    }
+
     createLight();
 }
 
@@ -105,11 +239,191 @@ void Forest::startGame()
     planeZ = new PlaneZ();
     planeZ->createPlane(scnMgr, dynamicsWorld);
     
-    object = new Object();
-    object->createObject(scnMgr, dynamicsWorld);
+    entityStore = new EntityStore();
+    object = new Object(entityStore);
+    object->createObject(scnMgr, dynamicsWorld, appliedSettings.treeCount);
+    if (shadowSystem) {
+        shadowSystem->setEntityStore(entityStore);
+    }
+
+    // FORESTZ_OCCLUSION=0 : pas d'occlusion logicielle (F8 la bascule en jeu)
+    const char* occlusion = std::getenv("FORESTZ_OCCLUSION");
+    occlusionCuller = new OcclusionCuller();
+    occlusionCuller->setEnabled(!occlusion || std::atoi(occlusion) != 0);
     
     player = new Player();
     player->createPlayer(scnMgr, Ogre::Vector3::ZERO, dynamicsWorld);
+
+    // Touches et éliminations vont au fil de messages créé dans setup()
+    zombies = new Zombies(entityStore);
+    zombies->setMessageFeed(messageFeed);
+
+    // FORESTZ_TARGET_FPS=60 : la qualité suit le temps d'image ; FORESTZ_QUALITY_GOVERNOR=0 garde les valeurs fixes
+    const char* governor = std::getenv("FORESTZ_QUALITY_GOVERNOR");
+    if (!governor || std::atoi(governor) != 0) {
+        GovernorSettings governorSettings;
+        if (const char* targetFps = std::getenv("FORESTZ_TARGET_FPS")) {
+            const float fps = static_cast<float>(std::atof(targetFps));
+            if (fps > 0.0f) {
+                governorSettings.targetMs = 1000.0f / fps;
+            }
+        }
+        qualityGovernor = new QualityGovernor(governorSettings);
+    }
+    zombies->setMaxZombies(static_cast<size_t>(appliedSettings.zombieCap));
+    zombies->createZombies(scnMgr, ZOMBIES_NUMBER, ZOMBIE_SPAWN_RADIUS, dynamicsWorld);
+    if (messageFeed) {
+        messageFeed->showBanner(3.0f, 40, "Niveau %d", 1);
+    }
+    applyQuality();
+
+    // Après applyQuality : changer les ombres invalide les shaders générés
+    warmUpShaders();
+
+    // FORESTZ_SIM_THREAD=1 : physique et IA des zombies sur leur propre thread, à pas fixe
+    const char* simThread = std::getenv("FORESTZ_SIM_THREAD");
+    if (simThread && std::atoi(simThread) != 0) {
+        // Appelée sous le verrou de synchronized() : le rendu ne touche au corps du joueur qu'entre deux pas
+        simulationThread = new SimulationThread([this](float deltaTime) {
+            if (zombies && player && player->playerBody) {
+                const btVector3 playerPos = player->playerBody->getWorldTransform().getOrigin();
+                zombies->steerZombies(Ogre::Vector3(playerPos.x(), playerPos.y(), playerPos.z()), jobSystem);
+            }
+            physicsManager->stepSimulation(deltaTime);
+        }, physicsManager->getTickInterval());
+        simulationThread->start();
+    }
+}
+
+/**
+ * @brief Generates and compiles the shaders of everything the game shows
+ *
+ * Runs once the world exists and the shadow settings are applied, so that
+ * no material compiles its programs when it first appears mid-game.
+ */
+void Forest::warmUpShaders()
+{
+    if (!shaderCache) return;
+
+    // Maillages (et leurs matériaux) puis matériaux affectés par le code, nommés par leurs propriétaires
+    std::vector<std::string> meshes = {Player::BODY_MESH, Player::GUN_MESH, Zombies::MESH};
+    meshes.insert(meshes.end(), std::begin(Object::TREE_MODELS), std::end(Object::TREE_MODELS));
+
+    Player::getBulletMaterial();
+    std::vector<std::string> materials = {
+        Player::BODY_MATERIAL, Player::GUN_MATERIAL, Player::BULLET_MATERIAL, PlaneZ::GROUND_MATERIAL,
+        ShadowSystem::PROXY_MATERIAL, BulletDebugDrawer::LINE_MATERIAL, ScreenQuadBatch::MATERIAL,
+        "BaseWhite" // Matériau par défaut d'Ogre : cubes des arbres lointains
+    };
+    materials.insert(materials.end(), std::begin(Object::TREE_MATERIALS), std::end(Object::TREE_MATERIALS));
+
+    const size_t prepared = shaderCache->warmUp(meshes, materials);
+    std::cout << "Shaders ready for " << prepared << " materials (cache: " << shaderCache->getDirectory() << ")"
+              << std::endl;
+}
+
+/**
+ * @brief Applies the governor's level, bounded by the preset, to the subsystems owning each knob
+ */
+void Forest::applyQuality()
+{
+    const float drawDistance = appliedSettings.treeDrawDistance;
+    if (!qualityGovernor) {
+        if (object) {
+            object->setLodDistances(object->getDetailDistance(), drawDistance);
+        }
+        applyShadowDistance(1.0f);
+        return;
+    }
+
+    // Le gouverneur ne dépasse jamais le préréglage (0 : pas de limite)
+    const QualityLevel& quality = qualityGovernor->getCurrent();
+    float impostorDistance = quality.impostorDistance;
+    if (drawDistance > 0.0f && (impostorDistance <= 0.0f || drawDistance < impostorDistance)) {
+        impostorDistance = drawDistance;
+    }
+    if (object) {
+        object->setLodDistances(quality.detailDistance, impostorDistance);
+    }
+    applyShadowDistance(quality.shadowScale);
+    if (zombies) {
+        zombies->setAnimationRate(quality.animationRate);
+    }
+}
+
+/**
+ * @brief Sets the shadow caster distance to a fraction of its upper bound
+ *
+ * The bound is FORESTZ_SHADOW_DISTANCE when set, else the distance of the
+ * current shadow tier.
+ * @param scale Fraction of the bound, 1 for the full distance
+ */
+void Forest::applyShadowDistance(float scale)
+{
+    if (!shadowSystem) return;
+    const float limit = shadowDistanceLimit > 0.0f
+        ? shadowDistanceLimit
+        : ShadowSettings::forQuality(shadowSystem->getQuality()).casterDistance;
+    const float distance = limit * std::min(std::max(scale, 0.0f), 1.0f);
+    if (distance != shadowSystem->getCasterDistance()) {
+        shadowSystem->setCasterDistance(distance);
+    }
+}
+
+/**
+ * @brief Applies the selected preset to the running game
+ *
+ * Only what differs from the preset already applied is changed; a new tree
+ * count adds or removes trees between two simulation ticks.
+ */
+void Forest::applySettings()
+{
+    if (!gameSettings) return;
+    const QualityPreset preset = gameSettings->getPreset();
+
+    if (preset.vsync != appliedSettings.vsync) {
+        getRenderWindow()->setVSyncEnabled(preset.vsync);
+    }
+    if (physicsManager && preset.physicsRate != appliedSettings.physicsRate) {
+        // stepSimulation lit la cadence sur le thread de simulation : changée entre deux pas
+        if (simulationThread) {
+            simulationThread->synchronized([&]() {
+                physicsManager->setTickRate(preset.physicsRate);
+                simulationThread->setTickInterval(physicsManager->getTickInterval());
+            });
+        } else {
+            physicsManager->setTickRate(preset.physicsRate);
+        }
+    }
+    if (shadowSystem && preset.shadows != appliedSettings.shadows) {
+        shadowSystem->setQuality(preset.shadows);
+    }
+    if (zombies) {
+        zombies->setMaxZombies(static_cast<size_t>(preset.zombieCap));
+    }
+
+    if (object && physicsManager && static_cast<size_t>(preset.treeCount) != object->getRandomTreeCount()) {
+        auto resizeForest = [&]() {
+            object->setRandomTreeCount(static_cast<size_t>(preset.treeCount), scnMgr,
+                                       physicsManager->getDynamicsWorld());
+        };
+        if (simulationThread) {
+            simulationThread->synchronized(resizeForest);
+        } else {
+            resizeForest();
+        }
+        // Ce qui a été construit une fois à partir des arbres
+        if (shadowSystem) {
+            shadowSystem->setEntityStore(entityStore);
+        }
+        if (physicsManager->getDebugDrawer()) {
+            physicsManager->getDebugDrawer()->invalidateStatic();
+        }
+    }
+
+    appliedSettings = preset;
+    applyQuality();
+    std::cout << "Settings: preset " << gameSettings->getPresetName() << " applied" << std::endl;
 }
 
 void Forest::quitGame()
@@ -129,6 +443,53 @@ bool Forest::keyPressed(const OgreBites::KeyboardEvent& evt)
         getRoot()->queueEndRendering();
     }
 
+    // F2 : compteurs de paires et de manifolds par couche de collision
+    if (evt.keysym.sym == OgreBites::SDLK_F2 && physicsManager) {
+        CollisionLayerStats stats;
+        stats.collect(physicsManager->getDynamicsWorld());
+        stats.print(std::cout);
+    }
+
+    if (evt.keysym.sym == OgreBites::SDLK_F3 && profilerOverlay) {
+        profilerOverlay->toggle();
+    }
+
+    if (evt.keysym.sym == OgreBites::SDLK_F5 && memoryOverlay) {
+        memoryOverlay->toggle();
+    }
+
+    // F6 : formes physiques, F7 : avec ou sans le décor statique
+    if (evt.keysym.sym == OgreBites::SDLK_F6 && physicsManager && physicsManager->getDebugDrawer()) {
+        BulletDebugDrawer* debugDrawer = physicsManager->getDebugDrawer();
+        debugDrawer->setVisible(!debugDrawer->isVisible());
+    }
+
+    if (evt.keysym.sym == OgreBites::SDLK_F7 && physicsManager && physicsManager->getDebugDrawer()) {
+        physicsManager->getDebugDrawer()->toggleCategory(DebugCategory::Static);
+    }
+
+    // F9 : paramètres de qualité, appliqués sans quitter la partie
+    if (evt.keysym.sym == OgreBites::SDLK_F9 && settingsPage) {
+        if (settingsPage->isVisible()) {
+            settingsPage->hide();
+        } else {
+            settingsPage->show();
+        }
+    }
+
+    if (evt.keysym.sym == OgreBites::SDLK_F8 && occlusionCuller) {
+        occlusionCuller->setEnabled(!occlusionCuller->isEnabled());
+    }
+
+    if (evt.keysym.sym == OgreBites::SDLK_F4) {
+        if (Profiler::isCapturing()) {
+            Profiler::stopCapture("forestz_trace.json");
+        } else {
+            Profiler::startCapture();
+            std::cout << "Profiler: capture started (F4 to stop)" << std::endl;
+        }
+    }
+
     return true;
 }
 
@@ -185,10 +546,28 @@ void Forest::createLight()
     lightNode->attachObject(light);
     lightNode->setPosition(Ogre::Vector3(500, 600, 500));
     lightNode->setDirection(Ogre::Vector3(-1, -1, -1).normalisedCopy());
+
+    // FORESTZ_SHADOWS=off|low|medium|high, FORESTZ_SHADOW_DISTANCE borne la distance à la place du niveau
+    ShadowQuality shadowQuality = gameSettings ? gameSettings->getPreset().shadows : ShadowQuality::Medium;
+    if (const char* shadows = std::getenv("FORESTZ_SHADOWS")) {
+        if (!ShadowSystem::parseQuality(shadows, shadowQuality)) {
+            std::cerr << "Unknown shadow quality '" << shadows << "', using the preset's" << std::endl;
+        }
+    }
+    Ogre::Viewport* viewport = getRenderWindow()->getViewport(0);
+    shadowSystem = new ShadowSystem(scnMgr);
+    shadowSystem->initialize(light, viewport ? viewport->getCamera() : nullptr, shadowQuality);
+    if (const char* shadowDistance = std::getenv("FORESTZ_SHADOW_DISTANCE")) {
+        shadowDistanceLimit = std::max(static_cast<float>(std::atof(shadowDistance)), 0.0f);
+    }
+    applyShadowDistance(1.0f);
 }
 
 bool Forest::frameRenderingQueued(const Ogre::FrameEvent& evt)
 {
+    // Tout ce qui a été alloué dans l'arène pendant l'image précédente est libéré
+    FrameArena::get().reset();
+
     if (!gameStarted) {
         if (uiManager && uiManager->getTrayManager()) {
             uiManager->getTrayManager()->frameRendered(evt);
@@ -196,7 +575,42 @@ bool Forest::frameRenderingQueued(const Ogre::FrameEvent& evt)
         return true;
     }
 
-    if (physicsManager) {
+    // Events of the previous frame, including the simulation thread's ticks
+    if (Profiler::isEnabled()) {
+        Profiler::collect();
+    }
+    if (hitchDetector) {
+        hitchDetector->update(evt.timeSinceLastFrame);
+    }
+    if (qualityGovernor && qualityGovernor->update(evt.timeSinceLastFrame)) {
+        std::cout << "Quality: level " << qualityGovernor->getLevel() << " (" << qualityGovernor->getSmoothedMs()
+                  << "ms average)" << std::endl;
+        applyQuality();
+    }
+    if (profilerOverlay) {
+        profilerOverlay->update(evt.timeSinceLastFrame);
+    }
+    if (memoryOverlay) {
+        memoryOverlay->update(evt.timeSinceLastFrame, scnMgr);
+    }
+    if (messageFeed) {
+        messageFeed->update(evt.timeSinceLastFrame);
+    }
+    PROFILE_SCOPE("Frame");
+
+    if (simulationThread) {
+        // Bodies are only added or removed between two simulation ticks
+        simulationThread->synchronized([this]() {
+            contactEvents->deliver(physicsManager->getDynamicsWorld(), player, zombies);
+        });
+        simulationThread->applyLatestSnapshot();
+        if (zombies) {
+            zombies->updateAnimations(evt.timeSinceLastFrame);
+        }
+    } else if (physicsManager) {
+        if (zombies && player && player->playerNode) {
+            zombies->updateZombies(player->playerNode, evt.timeSinceLastFrame);
+        }
         physicsManager->stepSimulation(evt.timeSinceLastFrame);
     }
 
@@ -204,5 +618,32 @@ bool Forest::frameRenderingQueued(const Ogre::FrameEvent& evt)
         cameraManager->updateCameraPosition(player->playerNode);
     }
 
+    // Les nœuds viennent d'être placés : l'image suivante profite du résultat
+    Ogre::Viewport* viewport = getRenderWindow()->getViewport(0);
+    if (occlusionCuller && entityStore && viewport && viewport->getCamera()) {
+        occlusionCuller->cull(*entityStore, *viewport->getCamera());
+    }
+
+    renderDebugLines();
+
     return true;
 }
+
+void Forest::renderDebugLines()
+{
+    if (!physicsManager) return;
+    BulletDebugDrawer* debugDrawer = physicsManager->getDebugDrawer();
+    if (!debugDrawer || !debugDrawer->isVisible()) return;
+
+    Ogre::Viewport* viewport = getRenderWindow()->getViewport(0);
+    const Ogre::Camera* camera = viewport ? viewport->getCamera() : nullptr;
+
+    // Le monde ne doit pas avancer pendant qu'on le parcourt
+    if (simulationThread) {
+        simulationThread->synchronized([&]() {
+            debugDrawer->drawWorld(physicsManager->getDynamicsWorld(), camera);
+        });
+    } else {
+        debugDrawer->drawWorld(physicsManager->getDynamicsWorld(), camera);
+    }
+}
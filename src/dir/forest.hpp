@@ -76,8 +76,6 @@ private:
 
     // Helper methods
     void updateMovementAndAnimation();
-    std::vector<Vector3> getTreePositions() const;
-    std::vector<Vector3> getZombiePositions() const;
 
 public:
     Forest();
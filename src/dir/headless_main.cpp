@@ -0,0 +1,94 @@
+#include "HeadlessRunner.hpp"
+#include "AllocationCounter.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+static void printUsage(const char* program)
+{
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --duration <seconds>   simulated time before stopping (default 300)\n"
+              << "  --levels <count>       levels to clear before stopping (default 3)\n"
+              << "  --zombies <count>      zombies of level 1 (default 10)\n"
+              << "  --script <file>        scripted inputs (default: fire at the nearest zombie)\n"
+              << "  --broadphase <name>    dbvt, sap or grid\n"
+              << "  --threads <count>      physics threads (multithreaded builds only)\n"
+              << "  --seed <value>         random seed of the forest and spawns (default: time)\n"
+              << "  --record <file>        write the session to an input log\n"
+              << "  --replay <file>        replay an input log and verify its checksums\n"
+              << "  --checksums <file>     write the world checksum of every tick\n"
+              << "  --trace <file>         write a Chrome trace of the run (profiler builds only)\n"
+              << "  --jobs <count>         threads sharing the parallel phases, 0 for every core (default 1)\n";
+}
+
+int main(int argc, char *argv[])
+{
+    // Before anything creates a Bullet object: blocks must be freed by the allocator that made them
+    AllocationCounter::installBulletHooks();
+
+    HeadlessSettings settings;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(arg, "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        }
+        if (!value) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        if (std::strcmp(arg, "--duration") == 0) {
+            settings.duration = static_cast<float>(std::atof(value));
+        } else if (std::strcmp(arg, "--levels") == 0) {
+            settings.levels = std::atoi(value);
+        } else if (std::strcmp(arg, "--zombies") == 0) {
+            settings.zombiesPerLevel = std::atoi(value);
+        } else if (std::strcmp(arg, "--script") == 0) {
+            settings.scriptPath = value;
+        } else if (std::strcmp(arg, "--broadphase") == 0) {
+            if (!PhysicsManager::parseBroadphase(value, settings.physics.broadphase)) {
+                std::cerr << "Unknown broadphase '" << value << "'" << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            settings.physics.threadCount = std::atoi(value);
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            settings.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--record") == 0) {
+            settings.recordPath = value;
+        } else if (std::strcmp(arg, "--replay") == 0) {
+            settings.replayPath = value;
+        } else if (std::strcmp(arg, "--checksums") == 0) {
+            settings.checksumPath = value;
+        } else if (std::strcmp(arg, "--trace") == 0) {
+            settings.tracePath = value;
+        } else if (std::strcmp(arg, "--jobs") == 0) {
+            settings.jobThreads = static_cast<unsigned int>(std::max(0, std::atoi(value)));
+        } else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+        ++i;
+    }
+
+    try
+    {
+        HeadlessRunner runner;
+        if (!runner.initialize(settings)) {
+            return 1;
+        }
+        return runner.run();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error occurred during execution: " << e.what() << std::endl;
+        return 1;
+    }
+}
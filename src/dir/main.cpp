@@ -1,9 +1,13 @@
 #include "WelcomePage.hpp"
+#include "AllocationCounter.hpp"
 #include <Ogre.h>
 #include <OgreApplicationContext.h>
 
 int main(int argc, char *argv[])
 {
+    // Before anything creates a Bullet object: blocks must be freed by the allocator that made them
+    AllocationCounter::installBulletHooks();
+
     try
     {
         WelcomePage app;
@@ -0,0 +1,107 @@
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @enum MemoryTag
+ * @brief Subsystem charged for a heap allocation
+ */
+enum class MemoryTag : uint8_t {
+    Other = 0,  // Ogre, the standard library, untagged game code
+    Physics,    // Everything Bullet allocates (btAlignedAlloc)
+    Player,     // Player, gun and bullets
+    Zombies,
+    Objects,    // Forest, walls and LOD entities
+    Interface,  // HUD, minimap, crosshair and overlays
+    Profiler,
+    Count
+};
+
+/**
+ * @struct AllocationTotals
+ * @brief Heap allocations made through operator new since startup
+ */
+struct AllocationTotals {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+
+/**
+ * @struct MemoryTagStats
+ * @brief Allocations charged to one subsystem
+ */
+struct MemoryTagStats {
+    int64_t liveBytes = 0;   // Allocated and not yet freed
+    int64_t liveCount = 0;
+    uint64_t totalCount = 0; // Since startup
+};
+
+/**
+ * @class AllocationCounter
+ * @brief Counts every heap allocation of the process, per subsystem
+ *
+ * With FORESTZ_ALLOC_TRACKING, AllocationCounter.cpp replaces the global
+ * operator new: each block gets a 16-byte header holding its size and tag, so
+ * frees are charged back to the subsystem that allocated. Allocations are
+ * charged to the calling thread's current tag (see MemoryScope).
+ * installBulletHooks() routes Bullet through the same accounting under
+ * MemoryTag::Physics. Without it (the default) nothing is replaced and every
+ * counter stays at 0.
+ */
+class AllocationCounter {
+public:
+    static AllocationTotals getTotals();
+
+    static MemoryTagStats getStats(MemoryTag tag);
+    static const char* getTagName(MemoryTag tag);
+
+    static MemoryTag getCurrentTag() { return currentTag; }
+    static void setCurrentTag(MemoryTag tag) { currentTag = tag; }
+
+    /**
+     * @brief Allocates a block charged to a tag (used by operator new and the Bullet hooks)
+     * @return Null if malloc failed
+     */
+    static void* allocate(size_t size, MemoryTag tag);
+
+    /**
+     * @brief Frees a block returned by allocate()
+     */
+    static void deallocate(void* pointer);
+
+    /**
+     * @brief Routes btAlignedAlloc through allocate(); call before Bullet allocates anything
+     */
+    static void installBulletHooks();
+
+private:
+    // Counters live in AllocationCounter.cpp: constant-initialized, usable before main()
+    static inline thread_local MemoryTag currentTag = MemoryTag::Other;
+};
+
+/**
+ * @class MemoryScope
+ * @brief Charges the allocations of the enclosing block to a subsystem
+ */
+class MemoryScope {
+public:
+    explicit MemoryScope(MemoryTag tag)
+        : previous(AllocationCounter::getCurrentTag())
+    {
+        AllocationCounter::setCurrentTag(tag);
+    }
+
+    ~MemoryScope() {
+        AllocationCounter::setCurrentTag(previous);
+    }
+
+    MemoryScope(const MemoryScope&) = delete;
+    MemoryScope& operator=(const MemoryScope&) = delete;
+
+private:
+    MemoryTag previous;
+};
+
+#endif // ALLOCATION_COUNTER_HPP
@@ -3,15 +3,48 @@
 
 #include <Ogre.h>
 #include <btBulletDynamicsCommon.h>
+#include <vector>
 
+/**
+ * @enum DebugCategory
+ * @brief Groups of bodies that can be shown or hidden separately
+ */
+enum class DebugCategory : unsigned int {
+    Static = 1 << 0,   // Trees, walls, ground planes
+    Player = 1 << 1,
+    Zombies = 1 << 2,
+    Bullets = 1 << 3,
+    Other = 1 << 4,    // Dynamic bodies without a handle
+    Contacts = 1 << 5
+};
+
+/**
+ * @class BulletDebugDrawer
+ * @brief Physics wireframes usable at full world scale
+ *
+ * Static bodies are emitted once into a grid of line meshes: Ogre culls the
+ * tiles against the frustum and the rendering distance, and they are never
+ * regenerated. Dynamic bodies are culled on their AABB (frustum and
+ * distance) before Bullet emits their lines, which are appended to a CPU
+ * array and uploaded once per frame into a persistent vertex buffer used as
+ * a ring: each frame writes after the previous one without waiting on the
+ * GPU, and the buffer is only discarded when it wraps.
+ *
+ * Lines drawn through btIDebugDraw between begin() and end() (for example by
+ * debugDrawWorld()) also go to the ring buffer, unculled. The ring buffer is
+ * only created the first time the drawer is shown.
+ */
 class BulletDebugDrawer : public btIDebugDraw {
 public:
+    static constexpr const char* LINE_MATERIAL = "BaseWhiteNoLighting";
+
     BulletDebugDrawer(Ogre::SceneManager* sceneMgr);
     ~BulletDebugDrawer();
 
     void drawLine(const btVector3& from, const btVector3& to, const btVector3& color) override;
     void reportErrorWarning(const char* warningString) override;
-    void drawContactPoint(const btVector3&, const btVector3&, btScalar, int, const btVector3&) override {}
+    void drawContactPoint(const btVector3& pointOnB, const btVector3& normalOnB, btScalar distance,
+                          int lifeTime, const btVector3& color) override;
     void draw3dText(const btVector3&, const char*) override {}
 
     void setDebugMode(int debugMode) override { mDebugMode = debugMode; }
@@ -21,11 +54,70 @@ public:
     void end();     // Must be called after debug drawing
     void clear();   // Optional: clear old lines
 
+    /**
+     * @brief Draws the world seen by the camera: cached static tiles, culled dynamic bodies, contacts
+     *
+     * Must not run while the world is stepping. Calls begin() and end() itself.
+     * @param world World to draw
+     * @param camera Camera used for culling
+     */
+    void drawWorld(btCollisionWorld* world, const Ogre::Camera* camera);
+
+    /**
+     * @brief Forgets the static tiles; they are rebuilt on the next drawWorld()
+     *
+     * To call when static bodies are added, moved or removed.
+     */
+    void invalidateStatic();
+
+    void setCategoryEnabled(DebugCategory category, bool enabled);
+    bool isCategoryEnabled(DebugCategory category) const;
+    void toggleCategory(DebugCategory category);
+
+    /**
+     * @brief Sets the distance beyond which nothing is drawn
+     */
+    void setMaxDistance(float distance);
+
+    /**
+     * @brief Shows or hides everything, static tiles included; hidden by default
+     */
+    void setVisible(bool visible);
+    bool isVisible() const { return mVisible; }
+
 private:
+    struct LineVertex {
+        float x, y, z;
+        Ogre::uint32 colour;
+    };
+
+    class LineRenderable;
+
+    void createRingBuffer();
+    void upload();
+    void buildStaticTiles(btCollisionWorld* world);
+    void destroyStaticTiles();
+    void updateStaticVisibility();
+    DebugCategory categoryOf(const btCollisionObject* object) const;
+
     Ogre::SceneManager* mSceneMgr;
-    Ogre::ManualObject* mLines;
+    Ogre::SceneNode* mNode;
+    LineRenderable* mLines;          // Ring buffer for the per-frame lines
+    std::vector<LineVertex> mVertices; // Lines of the current frame, reused
+    std::vector<LineVertex>* mTarget;  // Where drawLine() writes: mVertices or a static tile
+    std::vector<Ogre::ManualObject*> mStaticTiles; // Each on a child node of mNode at its centre
+    size_t mRingCapacity;            // In vertices
+    size_t mRingOffset;              // Next vertex to write
+    unsigned int mCategories;
+    float mMaxDistance;
     int mDebugMode;
     bool mDrawing;
+    bool mStaticBuilt;
+    bool mVisible;
+
+    // Grille des tuiles statiques et capacité de l'anneau (une image en occupe au plus la moitié)
+    static const int STATIC_TILE_GRID = 8;
+    static const size_t RING_VERTICES = 1 << 20;
 };
 
 #endif // BULLET_DEBUG_DRAWER_HPP
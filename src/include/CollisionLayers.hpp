@@ -0,0 +1,94 @@
+#ifndef COLLISION_LAYERS_HPP
+#define COLLISION_LAYERS_HPP
+
+#include <btBulletDynamicsCommon.h>
+#include <ostream>
+
+/**
+ * @enum CollisionLayer
+ * @brief Collision layer of every kind of body in the game
+ */
+enum class CollisionLayer {
+    Static,   // Trees and boundary walls
+    Ground,   // Ground planes
+    Player,
+    Zombie,
+    Bullet,
+    Count
+};
+
+/**
+ * @namespace CollisionLayers
+ * @brief Central table of collision groups and masks
+ *
+ * Bodies must be registered through addRigidBody so that pairs which can
+ * never matter (static/static, bullet/bullet, bullet/player) are rejected
+ * by the broadphase filter instead of reaching the narrowphase.
+ */
+namespace CollisionLayers {
+    /**
+     * @brief Gets the collision group bit of a layer
+     */
+    int group(CollisionLayer layer);
+
+    /**
+     * @brief Gets the mask of the layers a layer collides with
+     */
+    int mask(CollisionLayer layer);
+
+    /**
+     * @brief Gets the display name of a layer
+     */
+    const char* name(CollisionLayer layer);
+
+    /**
+     * @brief Finds the layer of a collision filter group
+     * @return The layer, or CollisionLayer::Count for an unknown group
+     */
+    CollisionLayer fromGroup(int group);
+
+    /**
+     * @brief Adds a rigid body to the world with the group and mask of its layer
+     * @param dynamicsWorld Pointer to the physics world
+     * @param body Body to add
+     * @param layer Layer of the body
+     */
+    void addRigidBody(btDiscreteDynamicsWorld* dynamicsWorld, btRigidBody* body, CollisionLayer layer);
+}
+
+/**
+ * @class CollisionLayerStats
+ * @brief Debug counters of broadphase pairs and manifolds per layer pair
+ */
+class CollisionLayerStats {
+public:
+    static const int LAYER_COUNT = static_cast<int>(CollisionLayer::Count);
+
+    /**
+     * @brief Counts the current broadphase pairs and contact manifolds
+     * @param dynamicsWorld Pointer to the physics world
+     */
+    void collect(btDiscreteDynamicsWorld* dynamicsWorld);
+
+    /**
+     * @brief Prints the non-empty layer pairs
+     * @param out Output stream
+     */
+    void print(std::ostream& out) const;
+
+    int getPairCount(CollisionLayer a, CollisionLayer b) const;
+    int getManifoldCount(CollisionLayer a, CollisionLayer b) const;
+    int getTotalPairs() const { return totalPairs; }
+    int getTotalManifolds() const { return totalManifolds; }
+
+private:
+    // Symmetric matrices, indexed [min(a, b)][max(a, b)]; the extra row/column counts untagged bodies
+    int pairs[LAYER_COUNT + 1][LAYER_COUNT + 1] = {};
+    int manifolds[LAYER_COUNT + 1][LAYER_COUNT + 1] = {};
+    int totalPairs = 0;
+    int totalManifolds = 0;
+
+    static void count(int (&matrix)[LAYER_COUNT + 1][LAYER_COUNT + 1], int groupA, int groupB);
+};
+
+#endif // COLLISION_LAYERS_HPP
@@ -0,0 +1,80 @@
+#ifndef CONTACT_EVENTS_HPP
+#define CONTACT_EVENTS_HPP
+
+#include <btBulletDynamicsCommon.h>
+#include <cstddef>
+#include <vector>
+
+class Player;
+class Zombies;
+
+/**
+ * @struct BodyHandle
+ * @brief Typed handle stored in a rigid body's user pointer
+ *
+ * Bodies without a handle (trees, walls, ground planes) are treated as
+ * static world geometry by the contact dispatcher.
+ */
+struct BodyHandle {
+    enum class Kind {
+        Player,
+        Zombie,
+        Bullet
+    };
+
+    Kind kind;
+    size_t index; // Index in the owner's storage (zombie slot, bullet slot)
+};
+
+/**
+ * @class ContactEvents
+ * @brief Turns Bullet contact manifolds into game events
+ *
+ * After each physics step the dispatcher's persistent manifolds are walked
+ * once. Bullet/zombie contacts become hits delivered to Zombies::onBulletHit,
+ * zombie/player contacts become damage delivered to Player::takeDamage.
+ * The cost is proportional to the number of manifolds, not to the size of
+ * the entity lists.
+ */
+class ContactEvents {
+public:
+    /**
+     * @brief Collects the contacts of the last step and delivers the events
+     * @param dynamicsWorld Pointer to the physics world
+     * @param player Player receiving damage and owning the bullets
+     * @param zombies Zombies receiving bullet hits
+     */
+    void dispatch(btDiscreteDynamicsWorld* dynamicsWorld, Player* player, Zombies* zombies);
+
+    /**
+     * @brief Collects the contacts of the last step without touching the game
+     *
+     * Contacts accumulate until the next deliver(), so several physics ticks
+     * can be collected for one delivery.
+     * @param dynamicsWorld Pointer to the physics world
+     */
+    void collect(btDiscreteDynamicsWorld* dynamicsWorld);
+
+    /**
+     * @brief Delivers the collected events and clears them
+     * @param dynamicsWorld Pointer to the physics world
+     * @param player Player receiving damage and owning the bullets
+     * @param zombies Zombies receiving bullet hits
+     */
+    void deliver(btDiscreteDynamicsWorld* dynamicsWorld, Player* player, Zombies* zombies);
+
+private:
+    struct BulletHit {
+        BodyHandle* bullet;
+        size_t zombieIndex;
+    };
+
+    // Reused between steps to avoid reallocating every frame
+    std::vector<BulletHit> bulletHits;
+    std::vector<size_t> playerHits;
+
+    static BodyHandle* getHandle(const btCollisionObject* object);
+    static bool isTouching(const btPersistentManifold* manifold);
+};
+
+#endif // CONTACT_EVENTS_HPP
@@ -1,27 +1,35 @@
 #ifndef CROSSHAIR_HPP
 #define CROSSHAIR_HPP
 
-#include <OgreOverlay.h>
-#include <OgreOverlayContainer.h>
-#include <OgrePanelOverlayElement.h>
+#include "ScreenQuadBatch.hpp"
 
+/**
+ * @class Crosshair
+ * @brief Two thin lines at the centre of the screen, drawn in the HUD batch
+ */
 class Crosshair {
 public:
     Crosshair();
     ~Crosshair();
 
-    void initialize(Ogre::SceneManager* scnMgr);
+    /**
+     * @param widgets Batch the lines are added to, usually HUD::getWidgets()
+     */
+    void initialize(ScreenQuadBatch& widgets);
+
+    /**
+     * @brief Lays the lines out for the screen size; free when the size did not change
+     */
     void update(int screenWidth, int screenHeight);
 
 private:
     void createCrosshairElements();
 
-    Ogre::Overlay* mOverlay;
-    Ogre::OverlayContainer* mContainer;
-    Ogre::PanelOverlayElement* mCrosshairVertical;
-    Ogre::PanelOverlayElement* mCrosshairHorizontal;
+    ScreenQuadBatch* mWidgets;
+    size_t mCrosshairVertical;
+    size_t mCrosshairHorizontal;
     float mCenterX;
     float mCenterY;
 };
 
-#endif // CROSSHAIR_HPP 
\ No newline at end of file
+#endif // CROSSHAIR_HPP
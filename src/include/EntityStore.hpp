@@ -0,0 +1,310 @@
+#ifndef ENTITY_STORE_HPP
+#define ENTITY_STORE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct EntityId
+ * @brief Typed handle to an entity of an EntityStore
+ *
+ * The generation tells a destroyed entity apart from a newer one reusing
+ * its index: a stale handle is simply no longer alive.
+ */
+struct EntityId {
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+
+    bool isValid() const { return index != INVALID_INDEX; }
+    bool operator==(const EntityId& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const EntityId& other) const { return !(*this == other); }
+};
+
+/**
+ * @class EntityStore
+ * @brief Archetype-based entity-component storage
+ *
+ * Entities with the same set of component types share an archetype, which
+ * keeps one contiguous array per component type: a query such as
+ * each<Transform, Health, Team>() walks plain arrays, in step, and never
+ * touches the components it did not ask for. Adding or removing a
+ * component moves the entity to another archetype.
+ *
+ * Components are plain structs. Structural changes (create, destroy, add,
+ * remove) must not happen during a query nor concurrently with one; queries
+ * may run on several threads at once, and different rows of a chunk may be
+ * written by different jobs.
+ */
+class EntityStore {
+public:
+    static constexpr size_t MAX_COMPONENT_TYPES = 64;
+
+    EntityStore() = default;
+    ~EntityStore() = default;
+
+    EntityStore(const EntityStore&) = delete;
+    EntityStore& operator=(const EntityStore&) = delete;
+
+    /**
+     * @brief Creates an entity with the given components (distinct types)
+     */
+    template <typename... Components>
+    EntityId create(Components... components);
+
+    /**
+     * @brief Destroys an entity and its components; does nothing if it is already dead
+     */
+    void destroy(EntityId entity);
+
+    bool isAlive(EntityId entity) const;
+
+    /**
+     * @brief Component of an entity
+     * @return Null if the entity is dead or does not have this component; valid until the next structural change
+     */
+    template <typename Component>
+    Component* get(EntityId entity);
+
+    template <typename Component>
+    bool has(EntityId entity) const;
+
+    /**
+     * @brief Adds a component, or overwrites it if the entity already has one
+     */
+    template <typename Component>
+    void add(EntityId entity, Component component);
+
+    /**
+     * @brief Removes a component if the entity has it
+     */
+    template <typename Component>
+    void remove(EntityId entity);
+
+    /**
+     * @brief Calls fn(EntityId, Components&...) for every entity having all the components
+     */
+    template <typename... Components, typename Function>
+    void each(Function&& fn);
+
+    /**
+     * @brief Calls fn(count, const EntityId*, Components*...) once per matching archetype
+     *
+     * The arrays are contiguous and indexed alike: a chunk can be split
+     * between jobs with JobSystem::parallelFor().
+     */
+    template <typename... Components, typename Function>
+    void eachChunk(Function&& fn);
+
+    /**
+     * @brief Number of entities having all the components
+     */
+    template <typename... Components>
+    size_t count() const;
+
+    /**
+     * @brief Number of living entities
+     */
+    size_t size() const { return liveCount; }
+
+    /**
+     * @brief Dense identifier of a component type, assigned on first use
+     */
+    template <typename Component>
+    static unsigned int componentId();
+
+private:
+    using ComponentMask = uint64_t;
+
+    struct ColumnBase {
+        virtual ~ColumnBase() = default;
+        virtual std::unique_ptr<ColumnBase> createEmpty() const = 0;
+        virtual void appendFrom(ColumnBase& source, size_t row) = 0; // Moves source[row] to the end
+        virtual void swapRemove(size_t row) = 0;
+    };
+
+    template <typename Component>
+    struct Column : ColumnBase {
+        std::vector<Component> data;
+
+        std::unique_ptr<ColumnBase> createEmpty() const override { return std::make_unique<Column>(); }
+        void appendFrom(ColumnBase& source, size_t row) override {
+            data.push_back(std::move(static_cast<Column&>(source).data[row]));
+        }
+        void swapRemove(size_t row) override {
+            if (row + 1 != data.size()) data[row] = std::move(data.back());
+            data.pop_back();
+        }
+    };
+
+    struct Archetype {
+        ComponentMask mask = 0;
+        std::vector<EntityId> entities;                 // Row -> entity
+        std::vector<std::unique_ptr<ColumnBase>> columns;
+        int columnOf[MAX_COMPONENT_TYPES];              // Component id -> column, -1 when absent
+
+        Archetype() { for (int& column : columnOf) column = -1; }
+
+        template <typename Component>
+        std::vector<Component>& column() {
+            return static_cast<Column<Component>*>(columns[columnOf[componentId<Component>()]].get())->data;
+        }
+    };
+
+    struct EntityRecord {
+        uint32_t generation = 0;
+        uint32_t archetype = 0;
+        uint32_t row = 0;
+        bool alive = false;
+    };
+
+    // unique_ptr: an archetype stays in place while others are created
+    std::vector<std::unique_ptr<Archetype>> archetypes;
+    std::vector<EntityRecord> records;
+    std::vector<uint32_t> freeIndices;
+    size_t liveCount = 0;
+
+    static inline std::atomic<unsigned int> nextComponentId{0};
+
+    template <typename... Components>
+    static ComponentMask maskOf() { return (ComponentMask(0) | ... | (ComponentMask(1) << componentId<Components>())); }
+
+    uint32_t findArchetype(ComponentMask mask) const;
+    uint32_t createArchetypeFrom(const Archetype* source, ComponentMask keep);
+    template <typename Component>
+    void addColumn(Archetype& archetype);
+
+    EntityId allocateEntity(uint32_t archetype, uint32_t row);
+    void removeRow(Archetype& archetype, uint32_t row);
+    void moveEntity(EntityId entity, uint32_t target);
+
+    static void reportTooManyComponents();
+};
+
+template <typename Component>
+unsigned int EntityStore::componentId()
+{
+    static const unsigned int id = [] {
+        unsigned int next = nextComponentId.fetch_add(1, std::memory_order_relaxed);
+        if (next >= MAX_COMPONENT_TYPES) reportTooManyComponents();
+        return next;
+    }();
+    return id;
+}
+
+template <typename Component>
+void EntityStore::addColumn(Archetype& archetype)
+{
+    const unsigned int id = componentId<Component>();
+    archetype.columnOf[id] = static_cast<int>(archetype.columns.size());
+    archetype.columns.push_back(std::make_unique<Column<Component>>());
+    archetype.mask |= ComponentMask(1) << id;
+}
+
+template <typename... Components>
+EntityId EntityStore::create(Components... components)
+{
+    const ComponentMask mask = maskOf<Components...>();
+    uint32_t index = findArchetype(mask);
+    if (index == archetypes.size()) {
+        index = createArchetypeFrom(nullptr, 0);
+        (addColumn<Components>(*archetypes[index]), ...);
+    }
+
+    Archetype& archetype = *archetypes[index];
+    EntityId entity = allocateEntity(index, static_cast<uint32_t>(archetype.entities.size()));
+    archetype.entities.push_back(entity);
+    (archetype.template column<Components>().push_back(std::move(components)), ...);
+    return entity;
+}
+
+template <typename Component>
+Component* EntityStore::get(EntityId entity)
+{
+    if (!isAlive(entity)) return nullptr;
+    const EntityRecord& record = records[entity.index];
+    Archetype& archetype = *archetypes[record.archetype];
+    if (archetype.columnOf[componentId<Component>()] < 0) return nullptr;
+    return &archetype.template column<Component>()[record.row];
+}
+
+template <typename Component>
+bool EntityStore::has(EntityId entity) const
+{
+    if (!isAlive(entity)) return false;
+    return (archetypes[records[entity.index].archetype]->mask & maskOf<Component>()) != 0;
+}
+
+template <typename Component>
+void EntityStore::add(EntityId entity, Component component)
+{
+    if (!isAlive(entity)) return;
+    if (Component* existing = get<Component>(entity)) {
+        *existing = std::move(component);
+        return;
+    }
+
+    const ComponentMask sourceMask = archetypes[records[entity.index].archetype]->mask;
+    uint32_t target = findArchetype(sourceMask | maskOf<Component>());
+    if (target == archetypes.size()) {
+        target = createArchetypeFrom(archetypes[records[entity.index].archetype].get(), sourceMask);
+        addColumn<Component>(*archetypes[target]);
+    }
+
+    // The new column gets its row first: moveEntity() appends the entity's other components
+    archetypes[target]->template column<Component>().push_back(std::move(component));
+    moveEntity(entity, target);
+}
+
+template <typename Component>
+void EntityStore::remove(EntityId entity)
+{
+    if (!has<Component>(entity)) return;
+
+    const Archetype* source = archetypes[records[entity.index].archetype].get();
+    const ComponentMask targetMask = source->mask & ~maskOf<Component>();
+    uint32_t target = findArchetype(targetMask);
+    if (target == archetypes.size()) {
+        target = createArchetypeFrom(source, targetMask);
+    }
+    moveEntity(entity, target);
+}
+
+template <typename... Components, typename Function>
+void EntityStore::each(Function&& fn)
+{
+    eachChunk<Components...>([&fn](size_t count, const EntityId* entities, Components*... columns) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(entities[i], columns[i]...);
+        }
+    });
+}
+
+template <typename... Components, typename Function>
+void EntityStore::eachChunk(Function&& fn)
+{
+    const ComponentMask required = maskOf<Components...>();
+    for (const std::unique_ptr<Archetype>& archetype : archetypes) {
+        if ((archetype->mask & required) != required || archetype->entities.empty()) continue;
+        fn(archetype->entities.size(), archetype->entities.data(),
+           archetype->template column<Components>().data()...);
+    }
+}
+
+template <typename... Components>
+size_t EntityStore::count() const
+{
+    const ComponentMask required = maskOf<Components...>();
+    size_t total = 0;
+    for (const std::unique_ptr<Archetype>& archetype : archetypes) {
+        if ((archetype->mask & required) == required) total += archetype->entities.size();
+    }
+    return total;
+}
+
+#endif // ENTITY_STORE_HPP
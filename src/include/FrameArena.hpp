@@ -0,0 +1,107 @@
+#ifndef FRAME_ARENA_HPP
+#define FRAME_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class FrameArena
+ * @brief Linear allocator for data that only lives until the end of the frame
+ *
+ * Allocating bumps an offset in one preallocated block; nothing is freed
+ * individually and reset() makes the whole block available again. When a
+ * frame needs more than the block, the excess comes from the heap and the
+ * block is enlarged at the next reset(), so a steady frame stops touching
+ * the heap after a few frames.
+ *
+ * FrameArena::get() is the game's arena, reset by the render thread at the
+ * start of every frame (or of every headless tick). It must only be used
+ * from that thread.
+ */
+class FrameArena {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256 * 1024;
+
+    explicit FrameArena(size_t capacity = DEFAULT_CAPACITY);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    static FrameArena& get();
+
+    /**
+     * @brief Returns uninitialized memory valid until the next reset()
+     */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Releases everything allocated since the previous reset
+     */
+    void reset();
+
+    /**
+     * @brief printf-style formatting into the arena
+     * @return Null-terminated string valid until the next reset()
+     */
+    const char* format(const char* fmt, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 2, 3)))
+#endif
+        ;
+
+    size_t getUsed() const { return offset + overflowBytes; }
+    size_t getCapacity() const { return capacity; }
+    size_t getPeak() const { return peak; }
+    size_t getOverflowCount() const { return overflowCount; } // Heap fallbacks since startup
+
+private:
+    char* buffer;
+    size_t capacity;
+    size_t offset;
+    size_t peak;
+    std::vector<void*> overflowBlocks;
+    size_t overflowBytes;
+    size_t overflowCount;
+};
+
+/**
+ * @class ArenaAllocator
+ * @brief Standard allocator drawing from a FrameArena (deallocation is a no-op)
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator() noexcept : arena(&FrameArena::get()) {}
+    explicit ArenaAllocator(FrameArena& arena) noexcept : arena(&arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.getArena()) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) noexcept {}
+
+    FrameArena* getArena() const noexcept { return arena; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena == other.getArena(); }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena != other.getArena(); }
+
+private:
+    FrameArena* arena;
+};
+
+// Conteneurs temporaires : à ne jamais conserver d'une image à l'autre
+template <typename T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
+using FrameString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+#endif // FRAME_ARENA_HPP
@@ -0,0 +1,94 @@
+#ifndef GAME_COMPONENTS_HPP
+#define GAME_COMPONENTS_HPP
+
+#include <Ogre.h>
+#include <btBulletDynamicsCommon.h>
+#include <cstddef>
+
+/**
+ * Components of the game's EntityStore. Plain data: the systems owning an
+ * entity (Zombies, Object) create it, keep it current and destroy it.
+ */
+
+/**
+ * @struct Transform
+ * @brief World position and orientation
+ *
+ * Written by the simulation for moving bodies (steering step), set once for
+ * static ones. Rendering reads SceneNodeRef instead, which the simulation
+ * thread does not touch.
+ */
+struct Transform {
+    Ogre::Vector3 position = Ogre::Vector3::ZERO;
+    Ogre::Quaternion orientation = Ogre::Quaternion::IDENTITY;
+};
+
+/**
+ * @struct Health
+ */
+struct Health {
+    float current = 0.0f;
+    float maximum = 0.0f;
+};
+
+/**
+ * @enum Side
+ */
+enum class Side : unsigned char {
+    Player,
+    Zombies,
+    Environment
+};
+
+/**
+ * @struct Team
+ */
+struct Team {
+    Side side = Side::Environment;
+};
+
+/**
+ * @struct SceneNodeRef
+ * @brief Visual representation (not owned)
+ */
+struct SceneNodeRef {
+    Ogre::SceneNode* node = nullptr;
+    Ogre::Entity* entity = nullptr; // Currently attached entity, may be null
+};
+
+/**
+ * @struct RigidBodyRef
+ * @brief Physics body; the creating system deletes it with its motion state and shape
+ */
+struct RigidBodyRef {
+    btRigidBody* body = nullptr;
+};
+
+/**
+ * @struct Zombie
+ * @brief Marks a zombie; slot is the index carried by its BodyHandle
+ */
+struct Zombie {
+    size_t slot = 0;
+};
+
+/**
+ * @struct Tree
+ * @brief Marks a tree and its level of detail
+ */
+struct Tree {
+    unsigned char model = 0; // Index of the high detail mesh
+    bool detailed = false;   // Full mesh attached instead of the placeholder
+};
+
+/**
+ * @struct ShadowCaster
+ * @brief Cheap stand-in casting the shadow of a detailed visual (not owned)
+ *
+ * Invisible in the main pass; ShadowSystem shows it and sets its caster distance.
+ */
+struct ShadowCaster {
+    Ogre::Entity* proxy = nullptr;
+};
+
+#endif // GAME_COMPONENTS_HPP
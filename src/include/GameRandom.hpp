@@ -0,0 +1,53 @@
+#ifndef GAME_RANDOM_HPP
+#define GAME_RANDOM_HPP
+
+#include <cstdint>
+#include <ctime>
+#include <random>
+
+/**
+ * @class GameRandom
+ * @brief Seeded random source for everything that shapes the simulation
+ *
+ * Tree placement and zombie spawns draw from this single generator, so a
+ * recorded seed rebuilds the same level. The float conversion is done by
+ * hand rather than with std::uniform_real_distribution, whose output is
+ * implementation-defined.
+ */
+class GameRandom {
+public:
+    /**
+     * @brief Restarts the sequence
+     * @param value Seed (0 picks one from the current time)
+     */
+    static void seed(uint32_t value) {
+        currentSeed = value != 0 ? value : static_cast<uint32_t>(std::time(nullptr));
+        engine.seed(currentSeed);
+        seeded = true;
+    }
+
+    /**
+     * @brief Seed of the current sequence
+     */
+    static uint32_t getSeed() {
+        if (!seeded) seed(0);
+        return currentSeed;
+    }
+
+    /**
+     * @brief Uniform value in [min, max)
+     */
+    static float uniform(float min, float max) {
+        if (!seeded) seed(0);
+        // 24 bits: every value is exactly representable as a float
+        float unit = static_cast<float>(engine() >> 8) * (1.0f / 16777216.0f);
+        return min + unit * (max - min);
+    }
+
+private:
+    static inline std::mt19937 engine;
+    static inline uint32_t currentSeed = 0;
+    static inline bool seeded = false;
+};
+
+#endif // GAME_RANDOM_HPP
@@ -0,0 +1,87 @@
+#ifndef GAME_SETTINGS_HPP
+#define GAME_SETTINGS_HPP
+
+#include <OgreFileSystemLayer.h>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lib.hpp"
+#include "ShadowSystem.hpp"
+
+/**
+ * @struct QualityPreset
+ * @brief Performance settings of one preset
+ */
+struct QualityPreset {
+    int treeCount = TREE_NUMBER;        // Random trees, on top of the boundary ones
+    float treeDrawDistance = 0.0f;      // Placeholder trees are not drawn past this, 0 for no limit
+    ShadowQuality shadows = ShadowQuality::Medium;
+    int zombieCap = 200;                // Living zombies at most
+    float physicsRate = 1.0f / PHYSICS_FIXED_TIMESTEP; // Physics ticks per second
+    bool vsync = true;
+};
+
+/**
+ * @class GameSettings
+ * @brief Quality presets kept in settings.cfg
+ *
+ * The file has a [General] section naming the selected preset and one
+ * section per preset:
+ * @code
+ * [General]
+ * Preset=low
+ *
+ * [low]
+ * TreeCount=200
+ * TreeDrawDistance=3000
+ * Shadows=off
+ * ZombieCap=40
+ * PhysicsRate=30
+ * VSync=yes
+ * @endcode
+ * The user's copy (FORESTZ_SETTINGS, else settings.cfg in the writable
+ * directory) is read first, then the one shipped in configs/. Keys missing
+ * from a section keep the built-in value of that preset.
+ */
+class GameSettings {
+public:
+    /**
+     * @brief Built-in low, medium and high presets, medium selected
+     * @param fsLayer Locates the shipped and the user's settings.cfg
+     */
+    explicit GameSettings(const OgreBites::FileSystemLayer& fsLayer);
+
+    /**
+     * @brief Reads the user's file, or the shipped one if the user has none
+     * @return False if neither could be read (built-in presets are kept)
+     */
+    bool load();
+
+    /**
+     * @brief Writes every preset and the selection to the user's file
+     * @return False if the file could not be written
+     */
+    bool save() const;
+
+    /**
+     * @brief Selects a preset by name
+     * @return False if there is no such preset
+     */
+    bool selectPreset(const std::string& name);
+
+    const std::string& getPresetName() const { return presets[selected].first; }
+    QualityPreset& getPreset() { return presets[selected].second; }
+    const QualityPreset& getPreset() const { return presets[selected].second; }
+    std::vector<std::string> getPresetNames() const;
+    const std::string& getUserPath() const { return userPath; }
+
+private:
+    bool read(const std::string& path);
+
+    std::vector<std::pair<std::string, QualityPreset>> presets; // In file order
+    size_t selected;
+    std::string userPath;
+    std::string defaultPath;
+};
+
+#endif // GAME_SETTINGS_HPP
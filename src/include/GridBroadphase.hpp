@@ -0,0 +1,100 @@
+#ifndef GRID_BROADPHASE_HPP
+#define GRID_BROADPHASE_HPP
+
+#include <btBulletDynamicsCommon.h>
+#include <vector>
+
+/**
+ * @class GridBroadphase
+ * @brief Uniform 2D grid broadphase over the X/Z plane of a bounded world
+ *
+ * The forest is flat and bounded, so bodies are binned by their X/Z extent
+ * only. A proxy is inserted in every cell its AABB covers; proxies that
+ * would cover too many cells (infinite ground planes, boundary walls) are
+ * kept in a separate list tested against every moving proxy. Only proxies
+ * whose AABB changed since the last step look for new pairs, so static
+ * trees cost nothing once inserted.
+ */
+class GridBroadphase : public btBroadphaseInterface {
+public:
+    /**
+     * @brief Constructor
+     * @param worldMin Minimum corner of the world (Y is ignored)
+     * @param worldMax Maximum corner of the world (Y is ignored)
+     * @param cellSize Edge length of a grid cell
+     * @param pairCache Pair cache to use (a hashed one is created when null)
+     */
+    GridBroadphase(const btVector3& worldMin, const btVector3& worldMax, btScalar cellSize,
+                   btOverlappingPairCache* pairCache = nullptr);
+    ~GridBroadphase() override;
+
+    btBroadphaseProxy* createProxy(const btVector3& aabbMin, const btVector3& aabbMax, int shapeType,
+                                   void* userPtr, int collisionFilterGroup, int collisionFilterMask,
+                                   btDispatcher* dispatcher) override;
+    void destroyProxy(btBroadphaseProxy* proxy, btDispatcher* dispatcher) override;
+    void setAabb(btBroadphaseProxy* proxy, const btVector3& aabbMin, const btVector3& aabbMax,
+                 btDispatcher* dispatcher) override;
+    void getAabb(btBroadphaseProxy* proxy, btVector3& aabbMin, btVector3& aabbMax) const override;
+
+    void rayTest(const btVector3& rayFrom, const btVector3& rayTo, btBroadphaseRayCallback& rayCallback,
+                 const btVector3& aabbMin = btVector3(0, 0, 0),
+                 const btVector3& aabbMax = btVector3(0, 0, 0)) override;
+    void aabbTest(const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseAabbCallback& callback) override;
+
+    void calculateOverlappingPairs(btDispatcher* dispatcher) override;
+
+    btOverlappingPairCache* getOverlappingPairCache() override { return pairCache; }
+    const btOverlappingPairCache* getOverlappingPairCache() const override { return pairCache; }
+
+    void getBroadphaseAabb(btVector3& aabbMin, btVector3& aabbMax) const override;
+    void printStats() override;
+
+private:
+    struct GridProxy : public btBroadphaseProxy {
+        GridProxy(const btVector3& aabbMin, const btVector3& aabbMax, void* userPtr,
+                  int collisionFilterGroup, int collisionFilterMask)
+            : btBroadphaseProxy(aabbMin, aabbMax, userPtr, collisionFilterGroup, collisionFilterMask) {}
+
+        int cellMinX = 0;
+        int cellMinZ = 0;
+        int cellMaxX = -1;
+        int cellMaxZ = -1;
+        bool oversized = false;
+        bool moved = false;
+        int slot = -1;           // Index in proxies
+        unsigned queryStamp = 0; // Last query that visited this proxy
+    };
+
+    btVector3 worldMin;
+    btVector3 worldMax;
+    btScalar cellSize;
+    btScalar inverseCellSize;
+    int cellsX;
+    int cellsZ;
+
+    std::vector<std::vector<GridProxy*>> cells;
+    std::vector<GridProxy*> proxies;
+    std::vector<GridProxy*> oversizedProxies;
+    std::vector<GridProxy*> movedProxies;
+
+    btOverlappingPairCache* pairCache;
+    bool ownsPairCache;
+    int nextUniqueId;
+    unsigned queryStamp;
+
+    // Beyond this many cells a proxy is cheaper to test against everything
+    static const int MAX_CELLS_PER_PROXY = 64;
+
+    void computeCellRange(const btVector3& aabbMin, const btVector3& aabbMax,
+                          int& minX, int& minZ, int& maxX, int& maxZ) const;
+    void insertInCells(GridProxy* proxy);
+    void removeFromCells(GridProxy* proxy);
+    void markMoved(GridProxy* proxy);
+    void findPairs(GridProxy* proxy);
+    bool testPair(GridProxy* proxy, GridProxy* other);
+
+    template <typename Visitor>
+    void visitCandidates(const btVector3& aabbMin, const btVector3& aabbMax, Visitor&& visit);
+};
+
+#endif // GRID_BROADPHASE_HPP
@@ -2,31 +2,43 @@
 #define HUD_HPP
 
 #include <Ogre.h>
-#include <OgreOverlay.h>
-#include <OgreOverlaySystem.h>
-#include <OgreOverlayManager.h>
-#include <OgreOverlayContainer.h>
-#include <OgreTextAreaOverlayElement.h>
+#include "ScreenQuadBatch.hpp"
 
+/**
+ * @class HUD
+ * @brief Health and energy bars, drawn with the crosshair as one screen batch
+ *
+ * Bar widths are kept in whole pixels: the batch is only rebuilt when a bar
+ * gains or loses a pixel, so steady frames upload nothing.
+ */
 class HUD {
 public:
     HUD();
     ~HUD();
 
-    void initialize();
+    void initialize(Ogre::SceneManager* scnMgr);
     void show();
     void hide();
     void updateEnergyBar(float currentEnergy, float maxEnergy);
     void updateHealthBar(float currentHealth, float maxHealth);
 
+    /**
+     * @brief Uploads the widgets changed since the last frame, if any
+     */
+    void update();
+
+    /**
+     * @brief Batch shared by the other screen widgets (crosshair)
+     */
+    ScreenQuadBatch& getWidgets() { return widgets; }
+
 private:
-    Ogre::Overlay* hudOverlay;
-    Ogre::OverlayContainer* bar1;
-    Ogre::OverlayContainer* bar2;
-    Ogre::OverlayContainer* energyFill;
-    Ogre::OverlayContainer* healthFill;
-    
+    ScreenQuadBatch widgets;
+    size_t healthFill;
+    size_t energyFill;
+
     void createBars();
+    void setFill(size_t fill, float top, float current, float maximum);
 };
 
-#endif 
\ No newline at end of file
+#endif
@@ -0,0 +1,47 @@
+#ifndef HEADLESS_OGRE_HPP
+#define HEADLESS_OGRE_HPP
+
+#include <Ogre.h>
+#include <string>
+
+namespace Ogre {
+    class OverlaySystem;
+}
+
+/**
+ * @class HeadlessOgre
+ * @brief Ogre started without a display, for simulation runs and benchmarks
+ *
+ * Uses the Tiny software render system with a 1x1 window that is never
+ * rendered, so meshes, materials, overlays and scene nodes behave as in
+ * the game. Configuration files are found the same way as ApplicationContext.
+ */
+class HeadlessOgre {
+public:
+    HeadlessOgre();
+    ~HeadlessOgre();
+
+    /**
+     * @brief Starts Ogre, creates a scene manager and loads the game resources
+     * @param logName Name of the Ogre log file
+     * @return True on success
+     */
+    bool initialize(const std::string& logName);
+
+    /**
+     * @brief Destroys every node and movable object of the scene
+     */
+    void clearScene();
+
+    Ogre::Root* getRoot() const { return root; }
+    Ogre::SceneManager* getSceneManager() const { return scnMgr; }
+
+private:
+    Ogre::Root* root;
+    Ogre::OverlaySystem* overlaySystem;
+    Ogre::SceneManager* scnMgr;
+
+    void locateResources(const Ogre::String& resourcesPath);
+};
+
+#endif // HEADLESS_OGRE_HPP
@@ -0,0 +1,151 @@
+#ifndef HEADLESS_RUNNER_HPP
+#define HEADLESS_RUNNER_HPP
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include "lib.hpp"
+#include "Plane.hpp"
+#include "Object.hpp"
+#include "Player.hpp"
+#include "Zombies.hpp"
+#include "ContactEvents.hpp"
+#include "PhysicsManager.hpp"
+#include "InputLog.hpp"
+#include "HeadlessOgre.hpp"
+#include "EntityStore.hpp"
+#include "JobSystem.hpp"
+
+/**
+ * @struct ScriptedInput
+ * @brief One timed command of a headless input script
+ *
+ * Script files hold one command per line, "<time> <command> [x y z]":
+ *   0.0 move 1 0 0    walk along a direction (0 0 0 stops)
+ *   2.5 shoot 0 0 -1  fire one bullet along a direction
+ *   3.0 autofire 1    fire at the nearest zombie (1) or stop (0)
+ * Empty lines and lines starting with '#' are ignored.
+ */
+struct ScriptedInput {
+    enum class Command {
+        Move,
+        Shoot,
+        AutoFire
+    };
+
+    float time;
+    Command command;
+    Ogre::Vector3 value;
+};
+
+/**
+ * @struct HeadlessSettings
+ * @brief Parameters of a headless run
+ */
+struct HeadlessSettings {
+    float duration = 300.0f;       // Simulated seconds before stopping
+    int levels = 3;                // Levels to clear before stopping
+    int zombiesPerLevel = 10;      // Zombies of level 1, multiplied by the level number
+    float spawnRadius = ZOMBIE_SPAWN_RADIUS;
+    std::string scriptPath;        // Empty: the player stands still and fires at the nearest zombie
+    PhysicsSettings physics;
+    uint32_t seed = 0;             // 0: seeded from the current time
+    std::string recordPath;        // Input log written during the run
+    std::string replayPath;        // Input log replayed instead of the script (overrides the above)
+    std::string checksumPath;      // Text file receiving "<tick> <checksum>" after every tick
+    std::string tracePath;         // Chrome trace of the whole run (profiler builds only)
+    unsigned int jobThreads = 1;   // Threads sharing the parallel phases (0: every core)
+};
+
+/**
+ * @class HeadlessRunner
+ * @brief Runs the game simulation without a window, overlays or input devices
+ *
+ * Ogre is started through HeadlessOgre, so meshes, materials and scene
+ * nodes behave as in the game. The level is then stepped at the fixed physics rate as fast as the
+ * CPU allows, driven by a script instead of the keyboard and mouse.
+ *
+ * A run can be recorded to an InputLog and replayed: the seed and the
+ * inputs of each tick are restored, and the world checksum stored every
+ * second in the log is compared with the replayed one. Replays are
+ * bit-exact with single-threaded physics on the same build.
+ */
+class HeadlessRunner {
+public:
+    HeadlessRunner();
+    ~HeadlessRunner();
+
+    /**
+     * @brief Starts Ogre and the physics world, then creates the level
+     * @param settings Parameters of the run
+     * @return True on success
+     */
+    bool initialize(const HeadlessSettings& settings);
+
+    /**
+     * @brief Simulates until the duration elapses, the levels are cleared or the player dies
+     * @return Process exit code (0 on success)
+     */
+    int run();
+
+    /**
+     * @brief Reads a script file
+     * @param path Script file path
+     * @param inputs Commands sorted by time
+     * @return True on success
+     */
+    static bool loadScript(const std::string& path, std::vector<ScriptedInput>& inputs);
+
+private:
+    HeadlessSettings settings;
+    HeadlessOgre ogre;
+    Ogre::SceneManager* scnMgr;
+    PhysicsManager* physicsManager;
+    ContactEvents* contactEvents;
+    PlaneZ* planeZ;
+    Object* object;
+    Player* player;
+    Zombies* zombies;
+    JobSystem* jobSystem;
+    EntityStore* entityStore; // Trees, walls and zombies
+
+    std::vector<ScriptedInput> script;
+    size_t nextInput;
+    Ogre::Vector3 moveDirection;
+    bool autoFire;
+    float fireCooldown;
+
+    int currentLevel;
+    float simulatedTime;
+    unsigned long tickCount;
+
+    // Enregistrement et rejeu
+    InputLog recorder;
+    bool recording;
+    Ogre::Vector3 recordedMove;
+    std::vector<Ogre::Vector3> pendingShots;
+    bool replaying;
+    std::vector<InputEvent> replayInputs;
+    std::vector<InputEvent> replayChecksums;
+    std::vector<InputEvent> replayLevelStarts;
+    size_t replayInputIndex;
+    size_t replayChecksumIndex;
+    size_t levelStartCount;
+    uint32_t replayEndTick;
+    long divergentTick; // First tick whose checksum differs from the log, -1 if none
+    std::ofstream checksumFile;
+
+    bool loadReplay(const std::string& path);
+    void startLevel(int level);
+    void applyScript();
+    void applyReplay();
+    void recordInputs();
+    void checkTick();
+    uint64_t computeChecksum() const;
+    void tick(float deltaTime);
+    size_t countAliveZombies() const;
+    bool findNearestZombie(Ogre::Vector3& direction) const;
+    Ogre::Vector3 getPlayerPosition() const;
+};
+
+#endif // HEADLESS_RUNNER_HPP
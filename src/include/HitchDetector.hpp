@@ -0,0 +1,67 @@
+#ifndef HITCH_DETECTOR_HPP
+#define HITCH_DETECTOR_HPP
+
+#include <string>
+#include <vector>
+#include "Profiler.hpp"
+#include "AllocationCounter.hpp"
+
+/**
+ * @struct HitchSettings
+ * @brief When the hitch detector triggers and what it keeps
+ */
+struct HitchSettings {
+    float thresholdMs = 50.0f;     // Frames longer than this are hitches
+    float historySeconds = 5.0f;   // Profiler events and frame samples kept before the hitch
+    float cooldownSeconds = 10.0f; // Minimum time between two captures (a hitch storm writes one file)
+    std::string directory = ".";   // Where hitch_<date>_<time>.json files are written
+};
+
+/**
+ * @class HitchDetector
+ * @brief Writes a profiler capture to disk whenever a frame is too long
+ *
+ * The detector holds the profiler for its whole lifetime and asks it to keep
+ * the last historySeconds of events. Each frame it also samples its duration
+ * and the allocations made since the previous frame. When a frame exceeds the
+ * threshold, everything in memory is written as a Chrome trace: scopes of
+ * every thread plus "Frame ms", "Allocations" and "Allocated KB" counters.
+ */
+class HitchDetector {
+public:
+    explicit HitchDetector(const HitchSettings& settings);
+    ~HitchDetector();
+
+    /**
+     * @brief Samples the frame that just ended and writes a capture if it was a hitch
+     * @param frameSeconds Duration of that frame, called after Profiler::collect()
+     * @return True if a capture was written
+     */
+    bool update(float frameSeconds);
+
+    unsigned int getCaptureCount() const { return captureCount; }
+
+private:
+    struct FrameSample {
+        uint64_t end;        // Profiler time
+        float milliseconds;
+        uint64_t allocations;
+        uint64_t allocatedBytes;
+    };
+
+    static constexpr float MAX_SAMPLED_FPS = 500.0f; // Sizes the frame ring: faster frames lose the oldest samples
+
+    HitchSettings settings;
+    std::vector<FrameSample> frames; // Circular, sized at construction
+    size_t firstFrame;               // Oldest sample
+    size_t frameCount;
+    AllocationTotals lastTotals;
+    uint64_t lastCaptureTime;
+    bool hasCaptured;
+    unsigned int captureCount;
+
+    bool writeCapture(const FrameSample& hitch);
+    std::string makeCapturePath(float milliseconds) const;
+};
+
+#endif // HITCH_DETECTOR_HPP
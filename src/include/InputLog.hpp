@@ -0,0 +1,100 @@
+#ifndef INPUT_LOG_HPP
+#define INPUT_LOG_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @struct InputLogHeader
+ * @brief Everything needed to rebuild the session before the first tick
+ */
+struct InputLogHeader {
+    uint32_t seed = 0;
+    float tickInterval = 0.0f;
+    int32_t levels = 0;
+    int32_t zombiesPerLevel = 0;
+    float spawnRadius = 0.0f;
+    uint8_t broadphase = 0;  // BroadphaseType
+    int32_t physicsThreads = 1;
+    int32_t jobThreads = 1;  // Threads of the job system, as resolved when recording
+};
+
+/**
+ * @struct InputEvent
+ * @brief One entry of the log, attached to a fixed simulation tick
+ */
+struct InputEvent {
+    enum class Type : uint8_t {
+        Move = 1,       // Direction de déplacement (x, z), conservée jusqu'au prochain Move
+        Shoot = 2,      // Direction de tir (x, y, z)
+        LevelStart = 3, // Niveau démarré (value)
+        Checksum = 4,   // Somme de contrôle du monde après le tick (value)
+        End = 5         // Fin de la session
+    };
+
+    uint32_t tick = 0;
+    Type type = Type::End;
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    uint64_t value = 0;
+};
+
+/**
+ * @class InputLog
+ * @brief Compact binary log of a fixed-tick session
+ *
+ * Layout: "FZIL", a version byte, the header, then the events. Each event
+ * is a varint tick delta, a type byte and its payload (two floats for a
+ * move, three for a shot, a varint for a level, eight bytes for a
+ * checksum). Movement is only logged when it changes, so an idle tick
+ * costs nothing. Values are stored little-endian.
+ */
+class InputLog {
+public:
+    /**
+     * @brief Starts writing a log
+     * @param path Output file
+     * @param header Session parameters
+     * @return True on success
+     */
+    bool openForWrite(const std::string& path, const InputLogHeader& header);
+
+    /**
+     * @brief Appends an event (ticks must not decrease)
+     */
+    void write(const InputEvent& event);
+
+    /**
+     * @brief Flushes and closes the output file
+     */
+    void close();
+
+    /**
+     * @brief Reads a whole log
+     * @param path Input file
+     * @return True on success
+     */
+    bool load(const std::string& path);
+
+    const InputLogHeader& getHeader() const { return header; }
+    const std::vector<InputEvent>& getEvents() const { return events; }
+
+private:
+    static constexpr uint8_t VERSION = 2;
+
+    InputLogHeader header;
+    std::vector<InputEvent> events;
+    std::ofstream output;
+    uint32_t lastTick = 0;
+
+    void writeBytes(const void* data, size_t size);
+    void writeVarint(uint64_t value);
+    void writeFloat(float value);
+    static bool readVarint(std::istream& input, uint64_t& value);
+    static bool readFloat(std::istream& input, float& value);
+};
+
+#endif // INPUT_LOG_HPP
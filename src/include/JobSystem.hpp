@@ -0,0 +1,229 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class JobCounter
+ * @brief Number of unfinished jobs of a group, waited on with JobSystem::wait()
+ */
+class JobCounter {
+public:
+    bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> pending{0};
+};
+
+/**
+ * @class JobSystem
+ * @brief Work-stealing task scheduler shared by the game subsystems
+ *
+ * Every worker owns a deque: it pushes and pops its own jobs at the back
+ * (most recent first, still in cache) and steals from the front of the
+ * others' deques when it runs dry. Threads that are not workers (render,
+ * simulation) submit to a shared deque. A thread waiting for a counter runs
+ * jobs meanwhile instead of blocking, so waiting from inside a job is safe
+ * and the caller of parallelFor() works as one more core.
+ *
+ * Jobs are plain function pointers plus a range: parallelFor() and JobGraph
+ * do not allocate per job. Only submit(std::function) does.
+ */
+class JobSystem {
+public:
+    /**
+     * @brief Starts the workers
+     * @param threadCount Threads running jobs, the caller included (1: no worker); 0 uses every hardware thread
+     */
+    explicit JobSystem(unsigned int threadCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /**
+     * @brief Threads executing jobs: the workers plus the waiting caller
+     */
+    unsigned int getThreadCount() const { return static_cast<unsigned int>(workers.size()) + 1; }
+
+    /**
+     * @brief Queues a job
+     * @param job Function to run
+     * @param counter Incremented now and decremented when the job has run, may be null
+     */
+    void submit(std::function<void()> job, JobCounter* counter = nullptr);
+
+    /**
+     * @brief Runs jobs until the counter reaches zero
+     */
+    void wait(JobCounter& counter);
+
+    /**
+     * @brief Runs fn(begin, end) over [0, count) split into chunks, and waits for all of them
+     *
+     * Iterations of different chunks must be independent.
+     * @param count Number of items
+     * @param grainSize Items per chunk at least (keeps tiny loops on one thread)
+     * @param fn Callable taking (size_t begin, size_t end)
+     */
+    template <typename Function>
+    void parallelFor(size_t count, size_t grainSize, Function&& fn);
+
+    /**
+     * @brief Queues a range job calling function(data, begin, end)
+     */
+    void submitRange(void (*function)(void*, size_t, size_t), void* data, size_t begin, size_t end,
+                     JobCounter* counter);
+
+private:
+    struct Job {
+        void (*function)(void* data, size_t begin, size_t end) = nullptr;
+        void* data = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+        JobCounter* counter = nullptr;
+    };
+
+    /**
+     * Ring buffer deque: the owner uses the back, thieves the front. Grows
+     * by doubling and never shrinks, so a steady frame does not allocate.
+     */
+    struct JobQueue {
+        std::mutex mutex;
+        std::vector<Job> ring = std::vector<Job>(256);
+        size_t head = 0;  // Index of the front job
+        size_t size = 0;
+
+        void pushBack(const Job& job);
+        bool popBack(Job& job);
+        bool popFront(Job& job);
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<JobQueue>> queues; // One per worker, the last one for other threads
+    std::atomic<int> queuedJobs{0};
+    std::atomic<int> sleepingWorkers{0};
+    std::mutex sleepMutex;
+    std::condition_variable wakeCondition;
+    bool stopping = false; // Guarded by sleepMutex
+
+    void workerLoop(unsigned int index);
+    bool findJob(Job& job);
+    void execute(const Job& job);
+    void enqueue(const Job& job);
+    int currentQueueIndex() const;
+};
+
+/**
+ * @class JobPhase
+ * @brief Frame-phase barrier: jobs submitted through it are finished when it goes out of scope
+ */
+class JobPhase {
+public:
+    explicit JobPhase(JobSystem& jobs) : jobs(jobs) {}
+    ~JobPhase() { jobs.wait(counter); }
+
+    JobPhase(const JobPhase&) = delete;
+    JobPhase& operator=(const JobPhase&) = delete;
+
+    void submit(std::function<void()> job) { jobs.submit(std::move(job), &counter); }
+
+    /**
+     * @brief Waits now for the jobs submitted so far
+     */
+    void wait() { jobs.wait(counter); }
+
+private:
+    JobSystem& jobs;
+    JobCounter counter;
+};
+
+/**
+ * @class JobGraph
+ * @brief Tasks with dependencies, built once and run every frame
+ *
+ * A task is submitted as soon as all the tasks it depends on are finished.
+ */
+class JobGraph {
+public:
+    using TaskId = size_t;
+
+    /**
+     * @brief Adds a task
+     * @return Identifier used by dependsOn()
+     */
+    TaskId add(std::function<void()> task);
+
+    /**
+     * @brief Makes a task wait for another one
+     * @param task Task that must run later
+     * @param dependency Task that must be finished first
+     */
+    void dependsOn(TaskId task, TaskId dependency);
+
+    /**
+     * @brief Runs every task once and returns when they are all finished
+     */
+    void run(JobSystem& jobs);
+
+private:
+    struct Task {
+        std::function<void()> function;
+        std::vector<TaskId> successors;
+        int dependencyCount = 0;
+        std::atomic<int> remaining{0};
+    };
+
+    struct RunContext {
+        JobGraph* graph;
+        JobSystem* jobs;
+        JobCounter* counter;
+    };
+
+    std::vector<std::unique_ptr<Task>> tasks;
+    RunContext context = {nullptr, nullptr, nullptr};
+
+    static void runTask(void* data, size_t taskId, size_t);
+};
+
+template <typename Function>
+void JobSystem::parallelFor(size_t count, size_t grainSize, Function&& fn)
+{
+    if (count == 0) return;
+    grainSize = grainSize > 0 ? grainSize : 1;
+
+    // About four chunks per thread: enough slack for stealing to balance uneven items
+    const size_t threads = getThreadCount();
+    size_t chunkSize = (count + threads * 4 - 1) / (threads * 4);
+    if (chunkSize < grainSize) chunkSize = grainSize;
+
+    if (chunkSize >= count || threads == 1) {
+        fn(size_t(0), count);
+        return;
+    }
+
+    using Callable = typename std::remove_reference<Function>::type;
+    void (*invoke)(void*, size_t, size_t) = [](void* data, size_t begin, size_t end) {
+        (*static_cast<Callable*>(data))(begin, end);
+    };
+
+    JobCounter counter;
+    // The caller keeps the first chunk and helps with the rest in wait()
+    for (size_t begin = chunkSize; begin < count; begin += chunkSize) {
+        const size_t end = begin + chunkSize < count ? begin + chunkSize : count;
+        submitRange(invoke, const_cast<void*>(static_cast<const void*>(&fn)), begin, end, &counter);
+    }
+    fn(size_t(0), chunkSize);
+    wait(counter);
+}
+
+#endif // JOB_SYSTEM_HPP
@@ -0,0 +1,42 @@
+#ifndef MEMORY_OVERLAY_HPP
+#define MEMORY_OVERLAY_HPP
+
+#include <Ogre.h>
+#include <OgreOverlay.h>
+#include <OgreOverlayManager.h>
+#include <OgreOverlayContainer.h>
+#include <OgreTextAreaOverlayElement.h>
+#include "MemoryReport.hpp"
+
+/**
+ * @class MemoryOverlay
+ * @brief In-game panel with the live heap per subsystem and the Ogre object counts
+ */
+class MemoryOverlay {
+public:
+    MemoryOverlay();
+    ~MemoryOverlay();
+
+    void initialize();
+    void toggle();
+    bool isVisible() const { return visible; }
+
+    /**
+     * @brief Refreshes the text twice per second while visible
+     * @param deltaTime Frame time in seconds
+     * @param scnMgr Scene manager whose objects are counted
+     */
+    void update(float deltaTime, Ogre::SceneManager* scnMgr);
+
+private:
+    Ogre::Overlay* overlay;
+    Ogre::OverlayContainer* panel;
+    Ogre::TextAreaOverlayElement* text;
+    bool visible;
+    float refreshTimer;
+    MemoryReport report;
+
+    static constexpr float REFRESH_INTERVAL = 0.5f;
+};
+
+#endif // MEMORY_OVERLAY_HPP
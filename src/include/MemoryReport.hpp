@@ -0,0 +1,52 @@
+#ifndef MEMORY_REPORT_HPP
+#define MEMORY_REPORT_HPP
+
+#include <ostream>
+#include "AllocationCounter.hpp"
+
+namespace Ogre {
+    class SceneManager;
+}
+
+/**
+ * @class MemoryReport
+ * @brief Snapshot of the heap per subsystem and of the live Ogre objects
+ *
+ * Ogre object counts catch what heap totals hide: an entity or a material
+ * created per bullet or per LOD switch shows up as a count that only grows.
+ */
+class MemoryReport {
+public:
+    static const int TAG_COUNT = static_cast<int>(MemoryTag::Count);
+
+    /**
+     * @brief Reads the allocation counters and counts the Ogre objects
+     * @param scnMgr Scene manager whose entities and nodes are counted, may be null
+     */
+    void collect(Ogre::SceneManager* scnMgr);
+
+    /**
+     * @brief Prints one line per subsystem, then the Ogre counts
+     * @param out Output stream
+     */
+    void print(std::ostream& out) const;
+
+    const MemoryTagStats& getTagStats(MemoryTag tag) const { return tags[static_cast<int>(tag)]; }
+    int64_t getTotalLiveBytes() const;
+
+    size_t getEntityCount() const { return entities; }
+    size_t getSceneNodeCount() const { return sceneNodes; }
+    size_t getMaterialCount() const { return materials; }
+    size_t getMeshCount() const { return meshes; }
+    size_t getTextureCount() const { return textures; }
+
+private:
+    MemoryTagStats tags[TAG_COUNT];
+    size_t entities = 0;
+    size_t sceneNodes = 0;
+    size_t materials = 0;
+    size_t meshes = 0;
+    size_t textures = 0;
+};
+
+#endif // MEMORY_REPORT_HPP
@@ -0,0 +1,86 @@
+#ifndef MESSAGE_FEED_HPP
+#define MESSAGE_FEED_HPP
+
+#include <Ogre.h>
+#include <OgreOverlay.h>
+#include <OgreOverlayManager.h>
+#include <OgreOverlayContainer.h>
+#include <OgreTextAreaOverlayElement.h>
+#include <cstdarg>
+#include <cstddef>
+
+/**
+ * @class MessageFeed
+ * @brief In-game text: a kill feed of a few lines and a centred banner
+ *
+ * Every line is a text area created once, with a fixed character buffer
+ * and its own expiry. Messages are formatted printf-style into that buffer,
+ * and the caption is uploaded to Ogre in update() only when the text has
+ * changed. Captions and glyph buffers are sized for the longest message up
+ * front, so posting at combat rate does not allocate.
+ */
+class MessageFeed {
+public:
+    static const size_t FEED_LINES = 6;
+    static const size_t MAX_MESSAGE_LENGTH = 64; // Longer messages are truncated
+
+    MessageFeed();
+    ~MessageFeed();
+
+    void initialize();
+
+    /**
+     * @brief Adds a kill feed line at the top; the oldest line makes room when all are taken
+     * @param displayTime Seconds before the line disappears
+     * @param format printf format
+     */
+    void postFeed(float displayTime, const char* format, ...);
+
+    /**
+     * @brief Shows a centred banner (level start, game over), replacing the current one
+     * @param displayTime Seconds before the banner disappears
+     * @param fontSize Character height, in 1/500 of the screen height
+     * @param format printf format
+     */
+    void showBanner(float displayTime, int fontSize, const char* format, ...);
+
+    /**
+     * @brief Expires old messages and uploads the changed captions
+     * @param deltaTime Frame time in seconds
+     */
+    void update(float deltaTime);
+
+    /**
+     * @brief Hides every message
+     */
+    void clear();
+
+private:
+    struct Slot {
+        Ogre::TextAreaOverlayElement* element = nullptr;
+        char text[MAX_MESSAGE_LENGTH] = {};
+        Ogre::String caption;        // Last caption uploaded, its capacity is reused
+        float remaining = 0.0f;      // Seconds left, 0 when free
+        unsigned long sequence = 0;  // Post order, the newest is the highest
+        int line = -1;               // Line of the feed it is laid out on
+        bool shown = false;
+    };
+
+    Ogre::Overlay* overlay;
+    Ogre::OverlayContainer* container;
+    Slot feed[FEED_LINES];
+    Slot banner;
+    unsigned long nextSequence;
+
+    static constexpr float FEED_LEFT = 0.7f;
+    static constexpr float FEED_TOP = 0.05f;
+    static constexpr float FEED_CHAR_HEIGHT = 0.03f;
+    static constexpr float FEED_LINE_SPACING = 0.035f;
+
+    Ogre::TextAreaOverlayElement* createText(const char* name);
+    void write(Slot& slot, float displayTime, const char* format, va_list args);
+    void upload(Slot& slot);
+    void expire(Slot& slot, float deltaTime);
+};
+
+#endif // MESSAGE_FEED_HPP
@@ -6,36 +6,75 @@
 #include <OgreOverlaySystem.h>
 #include <OgreOverlayManager.h>
 #include <OgreOverlayContainer.h>
+#include <OgrePanelOverlayElement.h>
+#include <btBulletDynamicsCommon.h>
 #include <vector>
+#include "EntityStore.hpp"
+#include "ScreenQuadBatch.hpp"
 
+/**
+ * @class Minimap
+ * @brief Top-right map centred on the player
+ *
+ * Static geometry (trees, walls) is rasterized once into a texture covering
+ * the whole map; a panel shows the window around the player by scrolling
+ * its UVs. Dynamic actors are found with a broadphase query limited to the
+ * area shown, and drawn as one ScreenQuadBatch on top of it, whose buffer
+ * is only rebuilt when an icon actually moved by a pixel. The cost of a frame depends on the zombies nearby, not on the
+ * size of the forest.
+ */
 class Minimap {
 public:
     Minimap();
     ~Minimap();
 
     void initialize(Ogre::SceneManager* scnMgr);
-    void update(const Ogre::Vector3& playerPos, 
-                const std::vector<Ogre::Vector3>& zombiePositions,
-                const std::vector<Ogre::Vector3>& treePositions);
-    void show() { if(minimapOverlay) minimapOverlay->show(); }
-    void hide() { if(minimapOverlay) minimapOverlay->hide(); }
+
+    /**
+     * @brief Rasterizes the static bodies of the store (trees, walls) into the map texture
+     *
+     * To call again only when the static world changes.
+     */
+    void buildStaticLayer(EntityStore& store);
+
+    /**
+     * @brief Scrolls the map and redraws the actors around the player
+     * @param playerPos Player position
+     * @param world World queried for the zombies in view; must not be stepping meanwhile
+     */
+    void update(const Ogre::Vector3& playerPos, btCollisionWorld* world);
+    void show();
+    void hide();
     void adjustPosition(unsigned int screenWidth);
 
 private:
-    void createMinimapIcon(const std::string& name, const Ogre::ColourValue& color);
-    void updateIconPosition(const std::string& name, const Ogre::Vector3& worldPos);
+    // Ajoute une icône centrée sur (mapX, mapY), en pixels dans le minimap
+    void addIcon(float mapX, float mapY, float halfSize, const Ogre::ColourValue& colour);
+    void addWorldIcon(const Ogre::Vector3& worldPos, float halfSize, const Ogre::ColourValue& colour);
+    void createStaticLayer();
 
+    Ogre::SceneManager* sceneManager;
     Ogre::Overlay* minimapOverlay;
     Ogre::OverlayContainer* minimapBackground;
-    Ogre::OverlayContainer* playerIcon;
-    std::vector<Ogre::OverlayContainer*> zombieIcons;
-    std::vector<Ogre::OverlayContainer*> treeIcons;
+    Ogre::PanelOverlayElement* staticLayerPanel;
+    Ogre::TexturePtr staticLayerTexture;
+    Ogre::MaterialPtr staticLayerMaterial;
+    ScreenQuadBatch icons;
+    std::vector<btCollisionObject*> visibleZombies; // Résultat de la requête broadphase, réutilisé d'une image à l'autre
     Ogre::Vector3 playerLastPosition;
 
     // Paramètres du minimap
     const float MINIMAP_SIZE = 200.0f;  // Taille en pixels
     const float MINIMAP_SCALE = 0.1f;   // Échelle monde->minimap
     const float MINIMAP_MARGIN = 20.0f;  // Marge depuis le coin de l'écran
+    const float PLAYER_ICON_HALF_SIZE = 3.0f;
+    const float ICON_HALF_SIZE = 2.0f;
+    // Texture de la couche statique : la carte entière, environ un texel par pixel du minimap
+    static const unsigned int STATIC_LAYER_SIZE = 1024;
+    // Zombies visibles prévus à la construction : la requête n'alloue qu'au-delà
+    static const size_t VISIBLE_ZOMBIES_RESERVE = 256;
+    // Overlay en Z 200 : fond à 20000, ses enfants à 20001 ; les icônes passent juste après
+    static const Ogre::ushort ICON_RENDER_PRIORITY = 20002;
 };
 
-#endif 
\ No newline at end of file
+#endif
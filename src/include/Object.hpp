@@ -9,6 +9,10 @@
 #include <cstdlib>
 #include <chrono>
 #include "lib.hpp"
+#include "CollisionLayers.hpp"
+#include "JobSystem.hpp"
+#include "EntityStore.hpp"
+#include "GameComponents.hpp"
 
 using namespace Ogre;
 
@@ -19,13 +23,21 @@ using namespace Ogre;
  * This class is responsible for creating and managing objects like trees and walls
  * in the game world, including both their visual representation and physics properties.
  * It implements a Level of Detail (LOD) system for optimizing rendering performance.
+ * Trees and walls are entities of an EntityStore (Tree, Transform, SceneNodeRef,
+ * RigidBodyRef, Team components) owned by this object. Trees also carry a
+ * ShadowCaster proxy, driven by ShadowSystem.
  */
 class Object {
 public:
+    // Maillages des arbres détaillés et leurs matériaux, choisis selon Tree::model
+    static constexpr const char* TREE_MODELS[] = {"tree_1.mesh", "tree_2.mesh"};
+    static constexpr const char* TREE_MATERIALS[] = {"MT01_MatTreeF4_M6_P1", "MT01_MatTreeF4_M5_P1"};
+
     /**
-     * @brief Default constructor
+     * @brief Constructor
+     * @param store Entity store receiving the trees and walls, null to use a private one
      */
-    Object();
+    explicit Object(EntityStore* store = nullptr);
 
     /**
      * @brief Destructor that cleans up all resources
@@ -36,73 +48,88 @@ public:
      * @brief Creates all objects in the scene
      * @param scnMgr Pointer to the scene manager
      * @param dynamicsWorld Pointer to the physics world
+     * @param treeCount Number of random trees
      */
-    void createObject(SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld);
+    void createObject(SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld, int treeCount = TREE_NUMBER);
 
     /**
-     * @brief Updates the Level of Detail for objects based on camera distance
-     * @param camNode Pointer to the camera node
+     * @brief Scatters trees randomly over the map
      * @param scnMgr Pointer to the scene manager
+     * @param dynamicsWorld Pointer to the physics world
+     * @param treeCount Number of trees to create
      */
-    void updateObjectLODs(SceneNode* camNode, SceneManager* scnMgr);
+    void createRandomTrees(SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld, int treeCount = TREE_NUMBER);
 
     /**
-     * @brief Renders debug information for physics objects
-     * @param debugDrawer Pointer to the debug drawer
+     * @brief Adds or removes random trees until there are count of them
+     *
+     * Trees are removed newest first. Bodies leave the world here: with a
+     * simulation thread, call it from SimulationThread::synchronized().
+     * @param count Number of random trees wanted
+     * @param scnMgr Pointer to the scene manager
      * @param dynamicsWorld Pointer to the physics world
      */
-    void renderDebug(btIDebugDraw* debugDrawer, btDiscreteDynamicsWorld* dynamicsWorld);
+    void setRandomTreeCount(size_t count, SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld);
+    size_t getRandomTreeCount() const { return randomTrees.size(); }
 
     /**
-     * @brief Gets the vector of tree nodes
-     * @return Constant reference to the vector of tree nodes
+     * @brief Updates the Level of Detail for objects based on camera distance
+     * @param camNode Pointer to the camera node
+     * @param scnMgr Pointer to the scene manager
+     * @param jobs Job system sharing out the distance tests, may be null
      */
-    const std::vector<Ogre::SceneNode*>& getTreeNodes() const { return treeNodes; }
+    void updateObjectLODs(SceneNode* camNode, SceneManager* scnMgr, JobSystem* jobs = nullptr);
 
     /**
-     * @brief Gets the vector of rigid bodies
-     * @return Constant reference to the vector of rigid bodies
+     * @brief Sets the level of detail distances, applied from the next updateObjectLODs
+     * @param detail Trees closer than this use their full mesh
+     * @param impostor Placeholders are not drawn past this, 0 for no limit
      */
-    const std::vector<btRigidBody*>& getRigidBodies() const { return treeBodies; }
+    void setLodDistances(float detail, float impostor);
+    float getDetailDistance() const { return detailDistance; }
 
     /**
-     * @brief Gets the vector of collision shapes
-     * @return Constant reference to the vector of collision shapes
+     * @brief Renders debug information for physics objects
+     * @param debugDrawer Pointer to the debug drawer
+     * @param dynamicsWorld Pointer to the physics world
      */
-    const std::vector<btCollisionShape*>& getCollisionShapes() const { return treeShapes; }
+    void renderDebug(btIDebugDraw* debugDrawer, btDiscreteDynamicsWorld* dynamicsWorld);
 
     /**
-     * @brief Gets the vector of motion states
-     * @return Constant reference to the vector of motion states
+     * @brief Gets the entity store holding the trees and walls
      */
-    const std::vector<btDefaultMotionState*>& getMotionStates() const { return treeMotionStates; }
+    EntityStore& getEntityStore() { return *store; }
 
 private:
     // Member variables
-    std::vector<btRigidBody*> treeBodies;
-    std::vector<btCollisionShape*> treeShapes;
-    std::vector<btDefaultMotionState*> treeMotionStates;
-    std::vector<SceneNode*> treeNodes;
+    EntityStore* store;
+    std::unique_ptr<EntityStore> ownStore;
+    std::vector<EntityId> entities; // Trees and walls created by this object
+    std::vector<EntityId> randomTrees; // Those of createRandomTrees, in creation order
+    size_t treeCount = 0;
     MaterialPtr material;
-    float lodDistanceThreshold = 500.0f;
+    float detailDistance = DISTANCE_RENDER_TREE + 500.0f;
+    float impostorDistance = 0.0f; // Sans limite
 
     // Helper methods
     void cleanupPhysicsResources();
     void createBoundaryWalls(btDiscreteDynamicsWorld* dynamicsWorld);
     void createWall(const btVector3& size, const btVector3& position, btDiscreteDynamicsWorld* dynamicsWorld);
     void createBoundaryTrees(SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld);
-    void createRandomTrees(SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld);
-    void createTreeAtPosition(float x, float z, SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld);
-    void createTreePhysics(float x, float z, btDiscreteDynamicsWorld* dynamicsWorld);
-    void updateTreeLOD(size_t index, const Vector3& cameraPosition, 
-                      const std::vector<std::string>& treeModels,
-                      const std::vector<std::string>& materials,
-                      SceneManager* scnMgr);
-    void switchToHighDetailTree(size_t index, SceneNode* treeNode,
-                              const std::vector<std::string>& treeModels,
-                              const std::vector<std::string>& materials,
-                              SceneManager* scnMgr);
-    void switchToLowDetailTree(size_t index, SceneNode* treeNode, SceneManager* scnMgr);
+    EntityId createTreeAtPosition(float x, float z, SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld);
+    void destroyTree(EntityId id, SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld);
+    btRigidBody* createTreePhysics(float x, float z, btDiscreteDynamicsWorld* dynamicsWorld);
+    Entity* createTreeShadowProxy(SceneNode* treeNode, SceneManager* scnMgr);
+    enum class LodChange : unsigned char {
+        None,
+        ToHigh,
+        ToLow
+    };
+    static const size_t LOD_GRAIN_SIZE = 256; // Arbres par job au minimum
+
+    LodChange classifyTreeLOD(const Tree& tree, const Transform& transform, const Vector3& cameraPosition) const;
+    void switchToHighDetailTree(Tree& tree, SceneNodeRef& visual, SceneManager* scnMgr);
+    void switchToLowDetailTree(Tree& tree, SceneNodeRef& visual, SceneManager* scnMgr);
     void setupTreeMaterial(const std::string& materialName);
     std::string generateUniqueId();
 };
@@ -0,0 +1,92 @@
+#ifndef OCCLUSION_CULLER_HPP
+#define OCCLUSION_CULLER_HPP
+
+#include <Ogre.h>
+#include <vector>
+#include "EntityStore.hpp"
+
+/**
+ * @class OcclusionCuller
+ * @brief CPU occlusion culling of trees and zombies behind the nearest trunks
+ *
+ * Each frame the trunks of the nearest detailed trees are rasterized into a
+ * small depth buffer (SSE, four pixels at a time), each triangle at the
+ * depth of its furthest vertex so the buffer never claims more than the
+ * trunks hide. The bounding box of every tree and zombie is then tested
+ * against it: a box whose nearest point is behind the occluders on every
+ * pixel it covers is hidden before Ogre submits it. Anything crossing the
+ * near plane or leaving the screen is left to Ogre.
+ *
+ * Visibility is set on the render thread and applies from the next frame.
+ */
+class OcclusionCuller {
+public:
+    static const int WIDTH = 256;  // Multiple of 4
+    static const int HEIGHT = 128;
+
+    OcclusionCuller();
+
+    /**
+     * @brief Rasterizes the occluders seen by the camera and hides what they cover
+     * @param store Store holding the trees and zombies
+     * @param camera Main camera
+     */
+    void cull(EntityStore& store, const Ogre::Camera& camera);
+
+    /**
+     * @brief Turns culling on or off; when off the next cull() shows everything again
+     */
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * @brief Clears the buffer for a new view
+     * @param viewProjection Projection * view of the camera
+     * @param nearClip Near clip distance; occluders crossing it are skipped
+     */
+    void beginFrame(const Ogre::Matrix4& viewProjection, float nearClip);
+
+    /**
+     * @brief Rasterizes a box that is fully opaque
+     */
+    void addOccluder(const Ogre::AxisAlignedBox& box);
+
+    /**
+     * @brief Tests a bounding box against the occluders of the frame
+     * @return False only if the box is certainly hidden
+     */
+    bool isVisible(const Ogre::AxisAlignedBox& box) const;
+
+    size_t getOccluderCount() const { return occluderCount; }
+    size_t getTestedCount() const { return testedCount; }
+    size_t getOccludedCount() const { return occludedCount; }
+
+private:
+    struct ScreenVertex {
+        float x;
+        float y;
+        float w; // Distance along the view axis
+    };
+
+    bool project(const Ogre::Vector3& point, ScreenVertex& out) const;
+    void rasterizeTriangle(ScreenVertex a, ScreenVertex b, ScreenVertex c);
+    void applyVisibility(Ogre::Entity* entity, bool visible);
+    void showAll(EntityStore& store);
+
+    std::vector<float> depth; // WIDTH * HEIGHT, nearest occluder per pixel
+    Ogre::Matrix4 viewProjection;
+    float nearClip;
+    size_t occluderCount;
+    size_t testedCount;
+    size_t occludedCount;
+    bool enabled;
+    bool hasHidden; // Something may still be hidden from a previous frame
+
+    static const size_t MAX_OCCLUDERS = 32;
+    static constexpr float OCCLUDER_DISTANCE = 400.0f;
+    // Part de la boîte d'un arbre détaillé qui est à coup sûr pleine : le tronc, bas et central
+    static constexpr float TRUNK_WIDTH_RATIO = 0.15f;
+    static constexpr float TRUNK_HEIGHT_RATIO = 0.6f;
+};
+
+#endif // OCCLUSION_CULLER_HPP
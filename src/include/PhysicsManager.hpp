@@ -0,0 +1,155 @@
+#ifndef PHYSICS_MANAGER_HPP
+#define PHYSICS_MANAGER_HPP
+
+#include <Ogre.h>
+#include <btBulletDynamicsCommon.h>
+#include <functional>
+#include <memory>
+#include <string>
+#include "lib.hpp"
+#include "BulletDebugDrawer.hpp"
+
+#ifdef FORESTZ_PHYSICS_MT
+#include <LinearMath/btThreads.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#endif
+
+/**
+ * @enum BroadphaseType
+ * @brief Broadphase algorithms available for the physics world
+ */
+enum class BroadphaseType {
+    DynamicAabbTree, // btDbvtBroadphase: no bounds needed, good all-rounder
+    AxisSweep,       // btAxisSweep3 sized to the map bounds
+    Grid             // GridBroadphase: 2D X/Z grid over the map
+};
+
+/**
+ * @struct PhysicsSettings
+ * @brief Runtime options used when the physics world is created
+ */
+struct PhysicsSettings {
+    /**
+     * Worker threads for the dynamics world: 1 keeps the single-threaded
+     * world, 0 uses one thread per hardware thread. Values other than 1 are
+     * only honoured in builds with FORESTZ_PHYSICS_MT.
+     */
+    int threadCount = 1;
+
+    BroadphaseType broadphase = BroadphaseType::DynamicAabbTree;
+    float gridCellSize = 250.0f; // Only used by BroadphaseType::Grid
+};
+
+/**
+ * @class PhysicsManager
+ * @brief Owns the Bullet world and advances it at a fixed rate
+ *
+ * Frame time is accumulated and consumed in fixed ticks (PHYSICS_FIXED_TIMESTEP
+ * unless setTickRate() changes it), at
+ * most PHYSICS_MAX_SUBSTEPS per frame, so a frame-rate spike never makes the
+ * simulation step longer or more expensive. The leftover time is used by
+ * Bullet to interpolate the transforms pushed to the motion states.
+ */
+class PhysicsManager {
+public:
+    /**
+     * @brief Callback invoked after every fixed tick, with the tick duration
+     */
+    using TickCallback = std::function<void(float)>;
+
+    PhysicsManager();
+    ~PhysicsManager();
+
+    /**
+     * @brief Creates the collision configuration, broadphase, solver and world
+     * @param settings Runtime options (thread count)
+     */
+    void initialize(const PhysicsSettings& settings = PhysicsSettings());
+
+    /**
+     * @brief Creates the debug drawer and attaches it to the world
+     * @param scnMgr Pointer to the scene manager
+     */
+    void setupDebugDrawer(Ogre::SceneManager* scnMgr);
+
+    /**
+     * @brief Advances the simulation by the elapsed frame time
+     * @param deltaTime Time since the last frame, in seconds
+     * @return Number of fixed ticks simulated
+     */
+    int stepSimulation(float deltaTime);
+
+    /**
+     * @brief Registers the callback run after every fixed tick
+     * @param callback Callback (contact events, gameplay reacting to physics)
+     */
+    void setTickCallback(TickCallback callback) { tickCallback = std::move(callback); }
+
+    /**
+     * @brief Changes the rate of the fixed ticks, effective from the next step
+     * @param ticksPerSecond Ticks per second, clamped to [MIN_TICK_RATE, MAX_TICK_RATE]
+     */
+    void setTickRate(float ticksPerSecond);
+    float getTickInterval() const { return tickInterval; }
+
+    static constexpr float MIN_TICK_RATE = 20.0f;
+    static constexpr float MAX_TICK_RATE = 240.0f;
+
+    btDiscreteDynamicsWorld* getDynamicsWorld() const { return dynamicsWorld.get(); }
+    BulletDebugDrawer* getDebugDrawer() const { return debugDrawer.get(); }
+
+    /**
+     * @brief Gets the number of threads stepping the world
+     * @return 1 for the single-threaded world
+     */
+    int getThreadCount() const { return threadCount; }
+
+    /**
+     * @brief Removes every collision object from the world without deleting it
+     *
+     * Game objects delete their bodies without removing them first: call this
+     * before destroying them while the world is still alive.
+     */
+    void removeAllCollisionObjects();
+
+    /**
+     * @brief Parses a broadphase name ("dbvt", "sap" or "grid")
+     * @param name Name of the broadphase
+     * @param type Receives the parsed type
+     * @return False if the name is unknown
+     */
+    static bool parseBroadphase(const std::string& name, BroadphaseType& type);
+
+    /**
+     * @brief Gets the bounds of the playable world, used by bounded broadphases
+     * @param aabbMin Receives the minimum corner
+     * @param aabbMax Receives the maximum corner
+     */
+    static void getWorldBounds(btVector3& aabbMin, btVector3& aabbMax);
+
+private:
+    std::unique_ptr<btDefaultCollisionConfiguration> collisionConfig;
+    std::unique_ptr<btCollisionDispatcher> dispatcher;
+    std::unique_ptr<btBroadphaseInterface> broadphase;
+    std::unique_ptr<btConstraintSolver> solver;
+    std::unique_ptr<btDiscreteDynamicsWorld> dynamicsWorld;
+#ifdef FORESTZ_PHYSICS_MT
+    std::unique_ptr<btConstraintSolverPoolMt> solverPool;
+    std::unique_ptr<btITaskScheduler> taskScheduler;
+#endif
+    int threadCount = 1;
+    float tickInterval = PHYSICS_FIXED_TIMESTEP;
+    std::unique_ptr<BulletDebugDrawer> debugDrawer;
+    TickCallback tickCallback;
+
+    void createBroadphase(const PhysicsSettings& settings);
+    void createSingleThreadedWorld(const PhysicsSettings& settings);
+#ifdef FORESTZ_PHYSICS_MT
+    void createMultiThreadedWorld(const PhysicsSettings& settings);
+#endif
+    static void onInternalTick(btDynamicsWorld* world, btScalar timeStep);
+};
+
+#endif // PHYSICS_MANAGER_HPP
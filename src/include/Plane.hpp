@@ -2,6 +2,7 @@
 #define PLANE_HPP
 
 #include "lib.hpp"
+#include "CollisionLayers.hpp"
 
 class PlaneZ {
     public :
@@ -13,6 +14,8 @@ class PlaneZ {
         int planeCountZ;
         float planeSize;
         void createPlane(SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld);
+
+        static constexpr const char* GROUND_MATERIAL = "Examples/Grass";
 };
 
 #endif
\ No newline at end of file
@@ -2,6 +2,9 @@
 #define PLAYER_HPP
 
 #include "lib.hpp"
+#include "ContactEvents.hpp"
+#include "SceneNodeMotionState.hpp"
+#include "CollisionLayers.hpp"
 #include <vector>
 #include <utility>
 
@@ -53,6 +56,15 @@ public:
     void renderDebug(btIDebugDraw* debugDrawer);
     btRigidBody* playerBody; // Add playerBody for physics
     void shoot(SceneManager* scnMgr, btDiscreteDynamicsWorld* dynamicsWorld, Vector3 direction);
+
+    // Matériau partagé par toutes les balles, créé au premier appel
+    static constexpr const char* BULLET_MATERIAL = "Player/Bullet";
+    // Maillages et matériaux du joueur et de son arme
+    static constexpr const char* BODY_MESH = "Mesh.mesh";
+    static constexpr const char* BODY_MATERIAL = "Ch15_body1.001";
+    static constexpr const char* GUN_MESH = "Cylinder.mesh";
+    static constexpr const char* GUN_MATERIAL = "Material.002";
+    static MaterialPtr getBulletMaterial();
     void updateBulletPositions(btDiscreteDynamicsWorld* dynamicsWorld);
     void createCamera(SceneManager* scnMgr , Camera * cam); // Create camera method
 
@@ -78,6 +90,7 @@ public:
 private:
     // Store bullets for cleanup
     std::vector<std::pair<btRigidBody*, SceneNode*>> bullets;  // Changed from SceneNode*, Vector3 to btRigidBody*, SceneNode*
+    BodyHandle playerHandle;  // Handle du joueur pour les événements de contact
     static constexpr float BULLET_MAX_DISTANCE = 1000.0f;
 
     // Système de santé et d'énergie
@@ -0,0 +1,234 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct ProfileEvent
+ * @brief One timed scope, as recorded by the thread that ran it
+ */
+struct ProfileEvent {
+    const char* name;  // String literal passed to PROFILE_SCOPE
+    uint64_t start;    // Nanoseconds since the profiler epoch
+    uint64_t end;
+    uint32_t threadId;
+};
+
+/**
+ * @struct ProfileScopeStats
+ * @brief Rolling statistics of one scope over the last samples
+ */
+struct ProfileScopeStats {
+    std::string name;
+    double averageMs;
+    double p99Ms;
+    double maxMs;
+    size_t calls; // Samples in the window
+};
+
+/**
+ * @struct ProfileCounterSample
+ * @brief Value of a counter at one point in time, exported as a trace counter track
+ */
+struct ProfileCounterSample {
+    const char* name;
+    uint64_t time; // Nanoseconds since the profiler epoch
+    double value;
+};
+
+/**
+ * @class Profiler
+ * @brief Scoped frame profiler with per-thread lock-free ring buffers
+ *
+ * PROFILE_SCOPE("Name") records the duration of the enclosing block into a
+ * ring owned by the calling thread: no lock and no allocation on the hot
+ * path. Once per frame the render thread drains every ring with collect(),
+ * which keeps a rolling window of samples per scope and, while a capture is
+ * running, the raw events for a Chrome trace (chrome://tracing, Perfetto).
+ *
+ * Recording is on while at least one user (the stats panel, a capture, the
+ * hitch detector) holds it. Scopes cost one relaxed load when nobody does,
+ * and nothing at all when the game is built without FORESTZ_PROFILER.
+ */
+class Profiler {
+public:
+    /**
+     * @brief Registers a user of the recorded events: recording starts with the first one
+     */
+    static void acquire() { users.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Unregisters a user: recording stops with the last one
+     */
+    static void release() { users.fetch_sub(1, std::memory_order_relaxed); }
+
+    static bool isEnabled() { return users.load(std::memory_order_relaxed) > 0; }
+
+    /**
+     * @brief Nanoseconds since the profiler epoch
+     */
+    static uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - epoch).count());
+    }
+
+    /**
+     * @brief Records a finished scope into the calling thread's ring
+     */
+    static void record(const char* name, uint64_t start, uint64_t end);
+
+    /**
+     * @brief Drains every thread's ring into the rolling statistics
+     *
+     * Must always be called from the same thread (the render thread).
+     */
+    static void collect();
+
+    /**
+     * @brief Statistics of every scope seen so far, sorted by name
+     */
+    static std::vector<ProfileScopeStats> getStats();
+
+    /**
+     * @brief Starts keeping raw events for a trace export
+     */
+    static void startCapture();
+
+    /**
+     * @brief Stops the capture and writes it as Chrome trace JSON
+     * @param path Output file
+     * @return True on success
+     */
+    static bool stopCapture(const std::string& path);
+
+    static bool isCapturing() { return capturing; }
+
+    /**
+     * @brief Keeps the events of the last seconds in memory (0 disables the history)
+     *
+     * The history is a ring of HISTORY_SIZE events allocated here: when the
+     * window holds more, the oldest events are overwritten.
+     */
+    static void setHistoryDuration(float seconds);
+
+    /**
+     * @brief Copy of the events collected during the history duration, oldest first
+     */
+    static std::vector<ProfileEvent> getHistory();
+
+    /**
+     * @brief Writes events and counter samples as Chrome trace JSON
+     * @param path Output file
+     * @param events Timed scopes
+     * @param counters Counter samples, may be empty
+     * @return True on success
+     */
+    template <typename EventContainer>
+    static bool writeTrace(const std::string& path, const EventContainer& events,
+                           const std::vector<ProfileCounterSample>& counters = {});
+
+private:
+    static constexpr size_t RING_SIZE = 16384;    // Events per thread between two collect()
+    static constexpr size_t WINDOW_SIZE = 256;    // Samples kept per scope for average and p99
+    static constexpr size_t MAX_CAPTURE = 2000000; // Events kept by a capture (about 50 MB)
+    static constexpr size_t HISTORY_SIZE = 131072; // Events kept by the history (4 MB)
+
+    struct ThreadRing {
+        ProfileEvent events[RING_SIZE];
+        std::atomic<uint64_t> written{0}; // Total events written by the owner thread
+        uint64_t read = 0;                // Total events consumed by collect()
+        uint32_t threadId = 0;
+    };
+
+    struct ScopeWindow {
+        std::vector<double> samples; // Circular, in milliseconds
+        size_t next = 0;
+    };
+
+    static inline std::atomic<int> users{0};
+    static inline const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    // Rings are registered once per thread and never freed: threads may outlive a frame
+    static inline std::mutex ringsMutex;
+    static inline std::vector<ThreadRing*> rings;
+
+    // Render thread only
+    static inline std::unordered_map<std::string, ScopeWindow> windows;
+    static inline std::unordered_map<const char*, ScopeWindow*> windowByName;
+    static inline std::vector<ProfileEvent> capture;
+    static inline bool capturing = false;
+    static inline std::vector<ProfileEvent> history; // Circular, HISTORY_SIZE while enabled
+    static inline size_t historyFirst = 0;          // Oldest event
+    static inline size_t historyCount = 0;
+    static inline uint64_t historyDuration = 0;     // Nanoseconds
+
+    static bool openTrace(const std::string& path, std::ofstream& file);
+    static void writeTraceEvent(std::ofstream& file, const ProfileEvent& event, bool first);
+    static void writeTraceCounter(std::ofstream& file, const ProfileCounterSample& sample, bool first);
+
+    static ThreadRing* threadRing();
+};
+
+template <typename EventContainer>
+bool Profiler::writeTrace(const std::string& path, const EventContainer& events,
+                          const std::vector<ProfileCounterSample>& counters)
+{
+    std::ofstream file;
+    if (!openTrace(path, file)) return false;
+
+    bool first = true;
+    for (const ProfileEvent& event : events) {
+        writeTraceEvent(file, event, first);
+        first = false;
+    }
+    for (const ProfileCounterSample& sample : counters) {
+        writeTraceCounter(file, sample, first);
+        first = false;
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return static_cast<bool>(file);
+}
+
+/**
+ * @class ProfileScope
+ * @brief Times the enclosing block (use PROFILE_SCOPE)
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : name(name)
+        , start(Profiler::isEnabled() ? Profiler::now() : 0)
+    {
+    }
+
+    ~ProfileScope() {
+        if (start != 0) {
+            Profiler::record(name, start, Profiler::now());
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    uint64_t start; // 0 when the profiler was disabled on entry
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef FORESTZ_PROFILER
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#endif
+
+#endif // PROFILER_HPP
@@ -0,0 +1,50 @@
+#ifndef PROFILER_OVERLAY_HPP
+#define PROFILER_OVERLAY_HPP
+
+#include <Ogre.h>
+#include <OgreOverlay.h>
+#include <OgreOverlayManager.h>
+#include <OgreOverlayContainer.h>
+#include <OgreTextAreaOverlayElement.h>
+#include <cstdint>
+
+/**
+ * @class ProfilerOverlay
+ * @brief In-game panel listing every profiler scope with its average and p99
+ */
+class ProfilerOverlay {
+public:
+    ProfilerOverlay();
+    ~ProfilerOverlay();
+
+    void initialize();
+
+    /**
+     * @brief Shows or hides the panel, holding the profiler while visible
+     */
+    void toggle();
+    bool isVisible() const { return visible; }
+
+    /**
+     * @brief Refreshes the text a few times per second (after Profiler::collect())
+     * @param deltaTime Frame time in seconds
+     */
+    void update(float deltaTime);
+
+private:
+    Ogre::Overlay* overlay;
+    Ogre::OverlayContainer* panel;
+    Ogre::TextAreaOverlayElement* text;
+    bool visible;
+    float refreshTimer;
+
+    // Allocations sur le tas par image, depuis le dernier rafraîchissement
+    uint64_t lastAllocationCount;
+    uint64_t intervalAllocations;
+    uint64_t intervalMaxAllocations;
+    unsigned int intervalFrames;
+
+    static constexpr float REFRESH_INTERVAL = 0.25f;
+};
+
+#endif // PROFILER_OVERLAY_HPP
@@ -0,0 +1,87 @@
+#ifndef QUALITY_GOVERNOR_HPP
+#define QUALITY_GOVERNOR_HPP
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @struct QualityLevel
+ * @brief Values of the quality knobs at one step of the governor
+ */
+struct QualityLevel {
+    float detailDistance;   // Trees closer than this use their full mesh
+    float impostorDistance; // Placeholder cubes are not drawn past this, 0 for no limit
+    float shadowScale;      // Fraction of the shadow caster distance allowed by the tier
+    float animationRate;    // Zombie animation updates per second, 0 for every frame
+};
+
+/**
+ * @struct GovernorSettings
+ * @brief Target and hysteresis of the quality governor
+ */
+struct GovernorSettings {
+    float targetMs = 1000.0f / 60.0f;
+    float smoothing = 0.05f;         // Weight of each new frame in the moving average
+    float downgradeRatio = 1.1f;     // Lower the quality above targetMs * downgradeRatio...
+    float downgradeSeconds = 0.5f;   // ...sustained this long
+    float upgradeRatio = 0.75f;      // Raise it below targetMs * upgradeRatio...
+    float upgradeSeconds = 4.0f;     // ...sustained this long
+    float settleSeconds = 2.0f;      // No decision right after a change
+    float maxFrameSeconds = 0.25f;   // Longer frames (loading, breakpoint) are clamped
+};
+
+/**
+ * @class QualityGovernor
+ * @brief Steps the quality knobs up or down to hold a target frame time
+ *
+ * The frame time is smoothed with an exponential moving average. The level
+ * drops when the average stays above the target band for downgradeSeconds
+ * and rises when it stays well below for the much longer upgradeSeconds.
+ * After each change the governor waits settleSeconds for the frame time to
+ * reflect the new level, so it never oscillates between two neighbours.
+ */
+class QualityGovernor {
+public:
+    /**
+     * @param settings Target and hysteresis
+     * @param levels Quality steps from the cheapest to the best, defaultLevels() if empty
+     * @param initialLevel Index into levels, clamped
+     */
+    explicit QualityGovernor(const GovernorSettings& settings,
+                             std::vector<QualityLevel> levels = std::vector<QualityLevel>(),
+                             size_t initialLevel = 2);
+
+    /**
+     * @brief Adds a frame to the average and steps the level if needed
+     * @param frameSeconds Duration of the frame
+     * @return True if the level changed; getCurrent() holds the values to apply
+     */
+    bool update(float frameSeconds);
+
+    /**
+     * @brief Forces a level and restarts the hysteresis
+     */
+    void setLevel(size_t level);
+
+    size_t getLevel() const { return level; }
+    size_t getLevelCount() const { return levels.size(); }
+    const QualityLevel& getCurrent() const { return levels[level]; }
+    float getSmoothedMs() const { return smoothedMs; }
+
+    /**
+     * @brief Four steps around the game's former fixed values (level 2)
+     */
+    static std::vector<QualityLevel> defaultLevels();
+
+private:
+    GovernorSettings settings;
+    std::vector<QualityLevel> levels;
+    size_t level;
+    float smoothedMs;
+    float overSeconds;   // Time the average has been above the downgrade band
+    float underSeconds;  // Time the average has been below the upgrade band
+    float settleSeconds; // Time left before the next decision
+    bool hasSample;
+};
+
+#endif // QUALITY_GOVERNOR_HPP
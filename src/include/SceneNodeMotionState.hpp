@@ -0,0 +1,99 @@
+#ifndef SCENE_NODE_MOTION_STATE_HPP
+#define SCENE_NODE_MOTION_STATE_HPP
+
+#include <Ogre.h>
+#include <atomic>
+#include <btBulletDynamicsCommon.h>
+
+/**
+ * @class TransformRecorder
+ * @brief Receives motion state updates instead of the scene nodes
+ *
+ * Installed while the simulation runs on its own thread, so that Bullet
+ * never touches Ogre objects owned by the render thread.
+ */
+class TransformRecorder {
+public:
+    virtual ~TransformRecorder() {}
+
+    /**
+     * @brief Records the latest transform of a node
+     * @param slot Slot returned by the previous call, or -1
+     * @return Slot to pass on the next call
+     */
+    virtual int record(int slot, Ogre::SceneNode* node, const Ogre::Vector3& position,
+                       const Ogre::Quaternion& orientation, bool syncOrientation, bool lockHeight) = 0;
+
+    /**
+     * @brief Forgets a slot whose motion state is being destroyed
+     */
+    virtual void release(int slot) = 0;
+};
+
+/**
+ * @class SceneNodeMotionState
+ * @brief Motion state that writes a body's transform straight into its SceneNode
+ *
+ * Bullet only synchronizes motion states of active bodies, with the transform
+ * interpolated inside the current fixed step. Sleeping and static bodies are
+ * therefore never touched, and the node is only updated when the transform
+ * actually changed. When a TransformRecorder is installed, updates go to it
+ * instead of the node.
+ */
+class SceneNodeMotionState : public btMotionState {
+public:
+    /**
+     * @brief Constructor
+     * @param node Scene node driven by the body (may be null)
+     * @param startTransform Initial transform of the body
+     */
+    SceneNodeMotionState(Ogre::SceneNode* node, const btTransform& startTransform);
+    ~SceneNodeMotionState() override;
+
+    void getWorldTransform(btTransform& worldTrans) const override;
+    void setWorldTransform(const btTransform& worldTrans) override;
+
+    /**
+     * @brief Sets the offset between the body origin and the node position
+     * @param offset Body origin minus node position
+     */
+    void setNodeOffset(const Ogre::Vector3& offset) { nodeOffset = offset; }
+
+    /**
+     * @brief Enables or disables copying the body orientation to the node
+     * @param sync True to copy the orientation
+     */
+    void setSyncOrientation(bool sync) { syncOrientation = sync; }
+
+    /**
+     * @brief Keeps the node at its current height (for ground-bound actors)
+     * @param lock True to ignore the body's Y coordinate
+     */
+    void setLockHeight(bool lock) { lockHeight = lock; }
+
+    /**
+     * @brief Detaches the motion state from its node
+     */
+    void clearNode() { node = nullptr; }
+
+    /**
+     * @brief Installs the recorder receiving every motion state update
+     *
+     * Read by the simulation thread: SimulationThread installs itself before
+     * its thread starts and removes itself once it has joined.
+     * @param transformRecorder Recorder, or null to write the nodes directly
+     */
+    static void setRecorder(TransformRecorder* transformRecorder) { recorder.store(transformRecorder); }
+
+private:
+    static std::atomic<TransformRecorder*> recorder;
+    int recorderSlot;
+
+    Ogre::SceneNode* node;
+    btTransform transform;
+    Ogre::Vector3 nodeOffset;
+    bool syncOrientation;
+    bool lockHeight;
+};
+
+#endif // SCENE_NODE_MOTION_STATE_HPP
@@ -0,0 +1,85 @@
+#ifndef SCREEN_QUAD_BATCH_HPP
+#define SCREEN_QUAD_BATCH_HPP
+
+#include <Ogre.h>
+#include <vector>
+
+/**
+ * @class ScreenQuadBatch
+ * @brief Retained set of coloured screen rectangles drawn as one mesh
+ *
+ * Rectangles are given in pixels and snapped to whole pixels. They live in
+ * one dynamic ManualObject rendered in the overlay queue: one draw call for
+ * the whole set. Setters only mark the batch dirty when a value actually
+ * changes, and flush() rebuilds the vertex buffer only if something did (or
+ * the viewport was resized): a frame where nothing moves costs a few
+ * comparisons.
+ */
+class ScreenQuadBatch {
+public:
+    static constexpr const char* MATERIAL = "Core/ScreenQuads";
+
+    ScreenQuadBatch();
+    ~ScreenQuadBatch();
+
+    ScreenQuadBatch(const ScreenQuadBatch&) = delete;
+    ScreenQuadBatch& operator=(const ScreenQuadBatch&) = delete;
+
+    /**
+     * @brief Creates the mesh
+     * @param scnMgr Scene manager owning it
+     * @param name Unique name of the ManualObject
+     * @param renderPriority Priority in the overlay queue; overlays use 100 per Z order step
+     * @return False if Ogre refused
+     */
+    bool initialize(Ogre::SceneManager* scnMgr, const Ogre::String& name, Ogre::ushort renderPriority);
+
+    /**
+     * @brief Adds a rectangle, drawn after (over) the previous ones
+     * @return Index for the setters
+     */
+    size_t addQuad(float left, float top, float width, float height, const Ogre::ColourValue& colour);
+
+    void setRect(size_t quad, float left, float top, float width, float height);
+    void setColour(size_t quad, const Ogre::ColourValue& colour);
+    void setQuadVisible(size_t quad, bool visible);
+
+    /**
+     * @brief Removes every rectangle, for sets rebuilt each frame
+     *
+     * The next addQuad() calls overwrite the previous rectangles in place, so
+     * a frame that adds back the same ones does not dirty the batch.
+     */
+    void clear();
+
+    size_t size() const { return quadCount; }
+
+    void setVisible(bool visible);
+
+    /**
+     * @brief Uploads the rectangles if anything changed since the last flush
+     * @return True if the vertex buffer was rebuilt
+     */
+    bool flush();
+
+private:
+    struct Quad {
+        float left;
+        float top;
+        float right;
+        float bottom;
+        Ogre::ColourValue colour;
+        bool visible;
+    };
+
+    Ogre::SceneManager* sceneManager;
+    Ogre::ManualObject* object;
+    std::vector<Quad> quads;  // Storage, only the first quadCount are drawn
+    size_t quadCount;
+    size_t lastCount;         // Quads drawn by the last flush
+    bool dirty;
+    int viewportWidth;  // Size the vertices were computed for
+    int viewportHeight;
+};
+
+#endif // SCREEN_QUAD_BATCH_HPP
@@ -0,0 +1,61 @@
+#ifndef SETTINGS_PAGE_HPP
+#define SETTINGS_PAGE_HPP
+
+#include <OgreTrays.h>
+#include <functional>
+#include "GameSettings.hpp"
+
+/**
+ * @class SettingsPage
+ * @brief Tray panel editing the quality presets of a GameSettings
+ *
+ * While shown, the page is the tray manager's listener (the previous one is
+ * restored on close). "Appliquer" saves the file and hands the preset to the
+ * apply callback, which changes the running game without a restart.
+ */
+class SettingsPage : public OgreBites::TrayListener {
+public:
+    using ApplyCallback = std::function<void(const QualityPreset&)>;
+
+    /**
+     * @param trayMgr Tray manager the widgets are created in (not owned)
+     * @param settings Presets edited by the page (not owned)
+     */
+    SettingsPage(OgreBites::TrayManager* trayMgr, GameSettings& settings);
+    ~SettingsPage();
+
+    void show();
+    void hide();
+    bool isVisible() const { return visible; }
+
+    void setApplyCallback(ApplyCallback callback) { applyCallback = std::move(callback); }
+
+    void buttonHit(OgreBites::Button* button) override;
+    void itemSelected(OgreBites::SelectMenu* menu) override;
+
+private:
+    void createWidgets();
+    void destroyWidgets();
+    void showPreset(const QualityPreset& preset);
+    void readWidgets(QualityPreset& preset) const;
+
+    OgreBites::TrayManager* trayMgr;
+    GameSettings& settings;
+    OgreBites::TrayListener* previousListener;
+    ApplyCallback applyCallback;
+    bool visible;
+    bool cursorWasVisible;
+    std::string appliedPreset; // Selection restored if the page closes without applying
+
+    OgreBites::SelectMenu* presetMenu;
+    OgreBites::Slider* treeCountSlider;
+    OgreBites::Slider* drawDistanceSlider;
+    OgreBites::SelectMenu* shadowMenu;
+    OgreBites::Slider* zombieCapSlider;
+    OgreBites::Slider* physicsRateSlider;
+    OgreBites::CheckBox* vsyncBox;
+    OgreBites::Button* applyButton;
+    OgreBites::Button* closeButton;
+};
+
+#endif // SETTINGS_PAGE_HPP
@@ -0,0 +1,50 @@
+#ifndef SHADER_CACHE_HPP
+#define SHADER_CACHE_HPP
+
+#include <Ogre.h>
+#include <string>
+#include <vector>
+
+/**
+ * @class ShaderCache
+ * @brief Keeps generated shaders across launches and compiles them at load
+ *
+ * The RTSS writes its generated sources to a writable cache directory and
+ * reuses them on the next launch; compiled programs are kept in the GPU
+ * program microcode cache, saved to the same directory. warmUp() generates
+ * and compiles the programs of every material the game will show, so no
+ * compilation happens when a material first appears mid-game.
+ */
+class ShaderCache {
+public:
+    /**
+     * @brief Points the RTSS at the cache and loads the saved microcode
+     *
+     * To create after the RTSS is initialized and before any material is used.
+     * @param directory Writable directory, created if missing
+     */
+    explicit ShaderCache(const std::string& directory);
+
+    /**
+     * @brief Generates and compiles the programs of the meshes' materials and of the listed ones
+     * @param meshes Meshes whose submesh materials are used
+     * @param materials Materials assigned by code
+     * @return Number of materials prepared
+     */
+    size_t warmUp(const std::vector<std::string>& meshes, const std::vector<std::string>& materials);
+
+    /**
+     * @brief Writes the microcode cache if programs were compiled since it was loaded
+     */
+    void save();
+
+    const std::string& getDirectory() const { return directory; }
+
+private:
+    bool warmUpMaterial(const Ogre::MaterialPtr& material);
+
+    std::string directory; // With a trailing separator
+    std::string microcodePath;
+};
+
+#endif // SHADER_CACHE_HPP
@@ -0,0 +1,105 @@
+#ifndef SHADOW_SYSTEM_HPP
+#define SHADOW_SYSTEM_HPP
+
+#include <Ogre.h>
+#include <string>
+#include "EntityStore.hpp"
+
+/**
+ * @enum ShadowQuality
+ * @brief Shadow tiers, from none to three large cascades
+ */
+enum class ShadowQuality {
+    Off,
+    Low,    // One 1024 map, casters up to 300 units
+    Medium, // Three 1024 cascades, casters up to 600 units
+    High    // Three 2048 cascades, casters up to 1000 units
+};
+
+/**
+ * @struct ShadowSettings
+ * @brief What a tier costs: cascades, map size and caster distance
+ */
+struct ShadowSettings {
+    int cascades = 3;
+    unsigned short mapSize = 1024;
+    float casterDistance = 600.0f; // Beyond it nothing casts or receives shadows
+
+    /**
+     * @brief Settings of a tier
+     */
+    static ShadowSettings forQuality(ShadowQuality quality);
+};
+
+/**
+ * @class ShadowSystem
+ * @brief Cascaded depth shadows of the main light, with a bounded caster set
+ *
+ * The main light gets parallel-split shadow maps (PSSM) whose last split
+ * ends at the caster distance, so casters and receivers further away cost
+ * nothing. Trees do not cast with their full mesh: each one carries a
+ * ShadowCaster proxy box, invisible in the main pass and culled beyond the
+ * caster distance (measured from the main camera, as Ogre does for shadow
+ * cameras). The tier can be changed at runtime.
+ */
+class ShadowSystem {
+public:
+    explicit ShadowSystem(Ogre::SceneManager* scnMgr);
+
+    /**
+     * @brief Makes the light directional and applies the tier
+     * @param mainLight Light casting the shadows
+     * @param camera Main camera, for the split distances; may be null
+     * @param quality Initial tier
+     */
+    void initialize(Ogre::Light* mainLight, Ogre::Camera* camera, ShadowQuality quality = ShadowQuality::Medium);
+
+    void setQuality(ShadowQuality quality);
+    ShadowQuality getQuality() const { return quality; }
+
+    /**
+     * @brief Overrides the caster distance of the current tier
+     *
+     * Up to the distance the cascades were built for, only the shadow far
+     * distance and the proxies change: split points, shadow maps and
+     * generated shaders are kept, so the quality governor can call this
+     * while playing. A longer distance rebuilds the cascades.
+     */
+    void setCasterDistance(float distance);
+    float getCasterDistance() const { return settings.casterDistance; }
+
+    /**
+     * @brief Store whose ShadowCaster proxies follow the caster distance, may be null
+     */
+    void setEntityStore(EntityStore* store);
+
+    /**
+     * @brief Parses off, low, medium or high
+     * @return False if the name is unknown
+     */
+    static bool parseQuality(const std::string& name, ShadowQuality& quality);
+
+    /**
+     * @brief Name read back by parseQuality()
+     */
+    static const char* getQualityName(ShadowQuality quality);
+
+    // Material of the ShadowCaster proxies: writes nothing in the main pass
+    static constexpr const char* PROXY_MATERIAL = "Forest/ShadowProxy";
+
+private:
+    void apply();
+    void updateCasterDistance();
+    void applyToProxies();
+    void createProxyMaterial();
+
+    Ogre::SceneManager* sceneManager;
+    Ogre::Light* light;
+    Ogre::Camera* camera;
+    EntityStore* store;
+    ShadowQuality quality;
+    ShadowSettings settings;
+    float splitDistance; // End of the last cascade, as baked into the receivers' shaders
+};
+
+#endif // SHADOW_SYSTEM_HPP
@@ -0,0 +1,43 @@
+#ifndef SIMULATION_CLOCK_HPP
+#define SIMULATION_CLOCK_HPP
+
+#include <Ogre.h>
+
+/**
+ * @class SimulationClock
+ * @brief Game time used by cooldowns and timers
+ *
+ * Follows Ogre's real-time timer by default. Headless runs switch it to
+ * manual mode and advance it by the fixed tick, so gameplay timings stay
+ * correct when the simulation runs faster than real time.
+ */
+class SimulationClock {
+public:
+    /**
+     * @brief Current game time in seconds
+     */
+    static float now() {
+        if (manual) return manualTime;
+        return Ogre::Root::getSingleton().getTimer()->getMilliseconds() / 1000.0f;
+    }
+
+    /**
+     * @brief Switches between the real-time timer and manual advance()
+     */
+    static void setManual(bool enabled) {
+        manual = enabled;
+        manualTime = 0.0f;
+    }
+
+    /**
+     * @brief Advances the clock in manual mode
+     * @param seconds Elapsed game time
+     */
+    static void advance(float seconds) { manualTime += seconds; }
+
+private:
+    static inline bool manual = false;
+    static inline float manualTime = 0.0f;
+};
+
+#endif // SIMULATION_CLOCK_HPP
@@ -0,0 +1,124 @@
+#ifndef SIMULATION_THREAD_HPP
+#define SIMULATION_THREAD_HPP
+
+#include <Ogre.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "SceneNodeMotionState.hpp"
+#include "TripleBuffer.hpp"
+
+/**
+ * @struct NodeTransform
+ * @brief Transform of one scene node as computed by the simulation
+ */
+struct NodeTransform {
+    Ogre::SceneNode* node = nullptr; // Null for a released slot
+    Ogre::Vector3 position;
+    Ogre::Quaternion orientation;
+    bool syncOrientation = true;
+    bool lockHeight = false;
+};
+
+/**
+ * @struct WorldSnapshot
+ * @brief Complete set of simulated transforms at the end of a tick
+ */
+struct WorldSnapshot {
+    unsigned long tick = 0;
+    unsigned structureVersion = 0; // Slots released after this version may hold destroyed nodes
+    std::vector<NodeTransform> transforms;
+};
+
+/**
+ * @class SimulationThread
+ * @brief Steps the game at a fixed rate on its own thread
+ *
+ * Each tick runs the step function (physics, zombie AI) and publishes a
+ * snapshot of every motion state through a triple buffer. Applying the
+ * latest snapshot to the scene nodes takes no lock, so the render thread
+ * does not wait for the simulation to do that.
+ *
+ * Each tick holds one mutex for the whole step. synchronized() takes the
+ * same mutex, so a render-thread call blocks until the current step ends,
+ * for up to one tick. The simulation in turn waits while the render thread
+ * is inside synchronized(). Keep those calls short and few per frame:
+ * adding or removing bodies, delivering contacts, debug drawing.
+ */
+class SimulationThread : public TransformRecorder {
+public:
+    using StepFunction = std::function<void(float)>;
+
+    /**
+     * @brief Constructor
+     * @param step Function advancing the simulation by one tick, called with the
+     *             synchronized() lock held
+     * @param tickInterval Duration of a tick in seconds
+     */
+    SimulationThread(StepFunction step, float tickInterval);
+    ~SimulationThread() override;
+
+    /**
+     * @brief Installs the transform recorder and starts ticking
+     */
+    void start();
+
+    /**
+     * @brief Stops ticking and writes the motion states to the nodes again
+     */
+    void stop();
+
+    /**
+     * @brief Changes the duration of a tick, effective from the next one
+     * @param seconds Duration of a tick
+     */
+    void setTickInterval(float seconds) { tickInterval.store(seconds); }
+
+    bool isRunning() const { return running.load(); }
+    unsigned long getTickCount() const { return tickCount.load(); }
+
+    /**
+     * @brief Runs a function between two ticks
+     *
+     * Anything that adds or removes rigid bodies, or reads state written by
+     * the simulation, must go through here while the thread is running.
+     * @param fn Function to run
+     */
+    template <typename Function>
+    void synchronized(Function&& fn) {
+        std::lock_guard<std::mutex> lock(simMutex);
+        fn();
+    }
+
+    /**
+     * @brief Writes the latest published transforms to the scene nodes
+     * @return True if a new snapshot was applied
+     */
+    bool applyLatestSnapshot();
+
+    int record(int slot, Ogre::SceneNode* node, const Ogre::Vector3& position,
+               const Ogre::Quaternion& orientation, bool syncOrientation, bool lockHeight) override;
+    void release(int slot) override;
+
+private:
+    StepFunction step;
+    std::atomic<float> tickInterval;
+    std::thread thread;
+    std::atomic<bool> running;
+    std::atomic<unsigned long> tickCount;
+    std::mutex simMutex;
+
+    // Simulation side, guarded by simMutex
+    std::vector<NodeTransform> latest;
+    std::vector<int> freeSlots;
+    std::atomic<unsigned> structureVersion;
+
+    TripleBuffer<WorldSnapshot> snapshots;
+
+    void run();
+    void publish();
+};
+
+#endif // SIMULATION_THREAD_HPP
@@ -0,0 +1,58 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <atomic>
+
+/**
+ * @class TripleBuffer
+ * @brief Lock-free single-producer/single-consumer triple buffer
+ *
+ * The producer fills writeBuffer() and publishes it; the consumer calls
+ * update() and reads readBuffer(). Neither side ever waits: the producer
+ * always has a free buffer and the consumer always sees the most recent
+ * complete one. Intermediate buffers may be skipped, so each buffer must
+ * hold a complete state rather than a delta.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    /**
+     * @brief Buffer owned by the producer until the next publish()
+     */
+    T& writeBuffer() { return buffers[backIndex]; }
+
+    /**
+     * @brief Hands the write buffer to the consumer
+     */
+    void publish() {
+        int previous = middle.exchange(backIndex | FRESH_BIT, std::memory_order_acq_rel);
+        backIndex = previous & INDEX_MASK;
+    }
+
+    /**
+     * @brief Takes the latest published buffer, if any
+     * @return True if readBuffer() changed
+     */
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH_BIT)) return false;
+        int previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+        frontIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief Buffer owned by the consumer until the next update()
+     */
+    const T& readBuffer() const { return buffers[frontIndex]; }
+
+private:
+    static const int INDEX_MASK = 0x3;
+    static const int FRESH_BIT = 0x4;
+
+    T buffers[3];
+    std::atomic<int> middle{1};
+    int backIndex = 0;
+    int frontIndex = 2;
+};
+
+#endif // TRIPLE_BUFFER_HPP
@@ -5,8 +5,11 @@
 #include <OgreTrays.h>
 #include <OgreInput.h>
 #include <OgreApplicationContext.h>
+#include "GameSettings.hpp"
+#include "SettingsPage.hpp"
 
-class WelcomePage : public OgreBites::ApplicationContext, public OgreBites::InputListener
+class WelcomePage : public OgreBites::ApplicationContext, public OgreBites::InputListener,
+                    public OgreBites::TrayListener
 {
 public:
     WelcomePage();
@@ -18,7 +21,7 @@ public:
 
 private:
     void createUI();
-    void buttonClicked(OgreBites::Button* button);
+    void buttonHit(OgreBites::Button* button) override;
 
     OgreBites::TrayManager* mTrayMgr;
     OgreBites::Button* mPlayButton;
@@ -28,6 +31,8 @@ private:
     Ogre::SceneManager* mSceneMgr;
     Ogre::Camera* mCamera;
     Ogre::SceneNode* mCameraNode;
+    GameSettings* mSettings;         // Quality presets of settings.cfg
+    SettingsPage* mSettingsPage;
 };
 
 #endif // WELCOME_PAGE_HPP 
\ No newline at end of file
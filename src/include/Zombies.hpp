@@ -3,49 +3,59 @@
 
 #include <Ogre.h>
 #include <vector>
+#include <deque>
+#include <cstdint>
 #include <btBulletDynamicsCommon.h>
 #include "lib.hpp" // Include your lib.hpp for Ogre and Bullet includes
-#include <OgreOverlay.h>
-#include <OgreOverlaySystem.h>
-#include <OgreOverlayManager.h>
-#include <OgreOverlayContainer.h>
-#include <OgreTextAreaOverlayElement.h>
+#include "ContactEvents.hpp"
+#include "SceneNodeMotionState.hpp"
+#include "CollisionLayers.hpp"
+#include "JobSystem.hpp"
+#include "EntityStore.hpp"
+#include "GameComponents.hpp"
+#include "MessageFeed.hpp"
 
 class Zombies {
 public:
-    Zombies();
+    static constexpr const char* MESH = "ZombieGirl_Body.mesh";
+
+    // Les zombies sont des entités du magasin partagé ; sans magasin, Zombies utilise le sien
+    explicit Zombies(EntityStore* store = nullptr);
     ~Zombies();
 
     void createZombies(Ogre::SceneManager* scnMgr, int numZombies, float radius, btDiscreteDynamicsWorld* dynamicsWorld);
     void updateZombies(Ogre::SceneNode* playerNode, float deltaTime);
+    // Partie simulation (peut tourner hors du thread de rendu) et partie rendu de updateZombies
+    // Chaque zombie ne touche qu'à son propre corps : jobs peut répartir la boucle sur plusieurs threads
+    void steerZombies(const Ogre::Vector3& playerPos, JobSystem* jobs = nullptr);
+    void updateAnimations(float deltaTime);
+    // Mises à jour des animations par seconde, 0 pour chaque image ; le temps sauté est rattrapé
+    void setAnimationRate(float updatesPerSecond);
     void onBulletHit(size_t zombieIndex, float damage, btDiscreteDynamicsWorld* dynamicsWorld);
-    const std::vector<btRigidBody*>& getZombieBodies() const;
-    const std::vector<Ogre::SceneNode*>& getZombieNodes() const { return zombieNodes; }
+    EntityStore& getEntityStore() { return *store; }
     bool isZombieAlive(size_t index) const;
     void setHealthMultiplier(float multiplier);
     void setSpeedMultiplier(float multiplier);
-    
-    // Nouvelles méthodes pour l'affichage à l'écran
-    void showGameMessage(const std::string& message, float displayTime = 3.0f, int fontSize = 24);
-    void showKillLogMessage(const std::string& message, float displayTime);
-    void updateOverlay(float deltaTime);
+    // Nombre maximal de zombies vivants ; createZombies n'en crée pas au-delà
+    void setMaxZombies(size_t maximum) { maxZombies = maximum; }
+
+    // Fil des éliminations ; sans fil, les touches ne s'affichent pas (mode headless)
+    void setMessageFeed(MessageFeed* feed) { messageFeed = feed; }
 
 private:
-    std::vector<Ogre::SceneNode*> zombieNodes;
-    std::vector<Ogre::Entity*> zombieEntities;
-    std::vector<btRigidBody*> zombieBodies;
-    std::vector<float> zombieHealth;
+    EntityStore* store;
+    std::unique_ptr<EntityStore> ownStore;
+    std::vector<EntityId> zombieIds; // Index du BodyHandle -> entité, jamais réutilisé
+    std::deque<BodyHandle> zombieHandles; // deque: addresses stay valid as zombies are added
     float baseZombieHealth = 100.0f;
     float healthMultiplier = 1.0f;
     float speedMultiplier = 1.0f;
+    size_t maxZombies = SIZE_MAX;
+    float animationInterval = 0.0f;
+    float animationElapsed = 0.0f; // Temps pas encore appliqué aux animations
+    static const size_t STEER_GRAIN_SIZE = 64; // Zombies par job au minimum
 
-    // Système d'affichage
-    Ogre::Overlay* gameOverlay;
-    Ogre::OverlayContainer* overlayContainer;
-    Ogre::TextAreaOverlayElement* messageText;
-    float messageDisplayTimeRemaining;
-
-    void initializeOverlay();
+    MessageFeed* messageFeed;
 };
 
 #endif // ZOMBIES_HPP
\ No newline at end of file
@@ -11,10 +11,28 @@
 #include "Object.hpp"
 #include "Player.hpp"
 #include "Zombies.hpp"
+#include "MessageFeed.hpp"
+#include "ShadowSystem.hpp"
+#include "ShaderCache.hpp"
+#include "OcclusionCuller.hpp"
+#include "QualityGovernor.hpp"
+#include "GameSettings.hpp"
+#include "SettingsPage.hpp"
 #include "Minimap.hpp"
 #include "HUD.hpp"
 #include "Crosshair.hpp"
 #include "BulletDebugDrawer.hpp"
+#include "ContactEvents.hpp"
+#include "PhysicsManager.hpp"
+#include "CollisionLayers.hpp"
+#include "SimulationThread.hpp"
+#include "Profiler.hpp"
+#include "ProfilerOverlay.hpp"
+#include "HitchDetector.hpp"
+#include "MemoryOverlay.hpp"
+#include "FrameArena.hpp"
+#include "JobSystem.hpp"
+#include "EntityStore.hpp"
 #include <OgreApplicationContext.h>
 #include <OgreInput.h>
 #include <OgreRTShaderSystem.h>
@@ -49,20 +67,27 @@ private:
     SceneNode* camNode;
     Light* light;
     SceneNode* lightNode;
+    ShadowSystem* shadowSystem;         // Cascades of the main light
     Viewport* vp;
     OgreBites::CameraMan* cameraMan;
     Object* object;
     PlaneZ* planeZ;
     Player* player;
     Zombies* zombies;
+    MessageFeed* messageFeed;           // Kill feed and level banners
     Minimap* minimap;
     HUD* hud;
     Crosshair* crosshair;
     OverlaySystem* overlaySystem;
     RTShader::ShaderGenerator* shadergen;
+    ShaderCache* shaderCache;           // Generated and compiled shaders kept across launches
     Vector3 direction;
     float lastFrameTime;
-    float lodDistanceThreshold;
+    QualityGovernor* qualityGovernor;   // LOD, impostor, shadow and animation knobs, null when fixed
+    GameSettings* gameSettings;         // Quality presets of settings.cfg
+    SettingsPage* settingsPage;         // Null without a tray manager
+    QualityPreset appliedSettings;      // Preset the running game reflects
+    float shadowDistanceLimit;          // FORESTZ_SHADOW_DISTANCE, 0 for the tier's own distance
 
     // Movement key states
     bool keyForwardPressed;
@@ -72,14 +97,19 @@ private:
     bool keyShiftPressed;
 
     // Physics
-    std::unique_ptr<btDefaultCollisionConfiguration> collisionConfig;
-    std::unique_ptr<btCollisionDispatcher> dispatcher;
-    std::unique_ptr<btBroadphaseInterface> broadphase;
-    std::unique_ptr<btSequentialImpulseConstraintSolver> solver;
-    btDiscreteDynamicsWorld* dynamicsWorld;
-    BulletDebugDrawer* debugDrawer;
+    PhysicsManager* physicsManager;
+    ContactEvents* contactEvents;
+    SimulationThread* simulationThread; // Null when the simulation runs in frameRenderingQueued
+    JobSystem* jobSystem;               // Shared by the subsystems' parallel phases
+    EntityStore* entityStore;           // Trees, walls and zombies
+    OcclusionCuller* occlusionCuller;   // Hides trees and zombies behind the nearest trunks
     std::vector<btRigidBody*> testCubeBodies;
 
+    // Profiling
+    ProfilerOverlay* profilerOverlay;
+    HitchDetector* hitchDetector; // Null unless FORESTZ_HITCH_MS is set
+    MemoryOverlay* memoryOverlay;
+
     // Level system
     int currentLevel;
     int zombiesPerLevel;
@@ -89,15 +119,18 @@ private:
     float levelTransitionTimer;
 
     // Helper methods
-    std::vector<Vector3> getTreePositions() const;
-    std::vector<Vector3> getZombiePositions() const;
     Vector3 getAimDirection() const;
+    void warmUpShaders();
+    void applyQuality();
+    void applyShadowDistance(float scale);
+    void applySettings();
 
 public:
     Forest();
     virtual ~Forest();
 
     void setup();
+    void shutdown() override;
     bool keyPressed(const OgreBites::KeyboardEvent& evt) override;
     bool keyReleased(const OgreBites::KeyboardEvent& evt) override;
     bool mouseMoved(const OgreBites::MouseMotionEvent& evt) override;
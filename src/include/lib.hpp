@@ -27,9 +27,15 @@
 #define PLAYER_SPRINT_MULTIPLIER 1.5f // Sprint multiplier for running
 #define ZOMBIE_SPEED 100.0f // Speed of zombies
 #define ZOMBIES_NUMBER 1 // Number of zombies to spawn
+#define ZOMBIE_SPAWN_RADIUS 2000.0f // Zombies spawn within this distance of the map centre
 #define BULLET_SPEED 2000.0f // Vitesse des balles augmentée pour un meilleur gameplay
+#define BULLET_DAMAGE 25.0f // Dégâts infligés par une balle à un zombie
+#define ZOMBIE_DAMAGE 10.0f // Dégâts infligés au joueur au contact d'un zombie
 #define LEVEL_TRANSITION_TIME 3.0f // Temps de transition entre les niveaux
 
+#define PHYSICS_FIXED_TIMESTEP (1.0f / 60.0f) // Pas fixe de la simulation physique
+#define PHYSICS_MAX_SUBSTEPS 5 // Nombre maximal de pas par image (au-delà, le temps est abandonné)
+
 using namespace Ogre;
 using namespace OgreBites;
 using namespace Ogre::RTShader;